@@ -0,0 +1,156 @@
+/* Cost of finding the name or alias in countryalias.h closest to a /country
+   text with the bigram index and the bit-parallel edit distance, against
+   the same edit distance over every name, and the DP matrix and minIndex()
+   gbmunge used at first. gbmunge.c is included, with its main() renamed,
+   to reach them. Queries are the names themselves and misspellings of
+   them, or the country texts of a GenBank file, in lower case.
+
+   usage: countries [Genbank_file] [repeats] */
+
+#include <time.h>
+#include "../src/gbfp.c"
+#include "../src/arrow.c"
+#define main mungeMain
+#include "../src/gbmunge.c"
+#undef main
+
+static double now(void) {
+    struct timespec tTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &tTime);
+
+    return tTime.tv_sec + tTime.tv_nsec * 1e-9;
+}
+
+/* A full DP matrix per name */
+static int matrixCountry(char *sName) {
+    int ld[FUZZYNUM];
+    int k;
+
+    for (k = 0; k < FUZZYNUM; k++) ld[k] = levenshteinDistance(sName, (char *) atAliases[aiFuzzy[k]].sKey);
+
+    return aiFuzzy[minIndex(ld, FUZZYNUM)];
+}
+
+/* The bit-parallel edit distance over every name, without the bigram index */
+static int scanCountry(unsigned long long *alPeq, const char *sName) {
+    int iBest = INT_MAX, iFound = 0, iDistance, m, n = strlen(sName), i, k;
+
+    for (k = 0; k < FUZZYNUM; k++) {
+        m = atAliases[aiFuzzy[k]].iLen;
+        if (abs(m - n) >= iBest) continue;
+        for (i = 0; i < m; i++) alPeq[(unsigned char) atAliases[aiFuzzy[k]].sKey[i]] |= 1ULL << i;
+        iDistance = myersDistance(alPeq, m, sName, n, iBest - 1);
+        for (i = 0; i < m; i++) alPeq[(unsigned char) atAliases[aiFuzzy[k]].sKey[i]] = 0;
+        if (iDistance < iBest) {
+            iBest = iDistance;
+            iFound = aiFuzzy[k];
+        }
+    }
+
+    return iFound;
+}
+
+/* Adds a name with one character dropped, changed or doubled, picked by iSeed */
+static void misspell(char *sOut, const char *sName, unsigned int iSeed) {
+    size_t lLen = strlen(sName), lAt = iSeed % lLen;
+
+    memcpy(sOut, sName, lLen + 1);
+    switch (iSeed / lLen % 3) {
+    case 0:
+        memmove(sOut + lAt, sOut + lAt + 1, lLen - lAt);
+        break;
+    case 1:
+        sOut[lAt] = 'a' + iSeed % 26;
+        break;
+    default:
+        memmove(sOut + lAt + 1, sOut + lAt, lLen - lAt + 1);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    char **psQueries;
+    unsigned long lQueryNum = 0, lQueryMem = 4 * NUM_COUNTRY, lMismatch = 0, l;
+    unsigned int i, iRun, iRepeat = (argc > 2) ? atoi(argv[2]) : 5;
+    int iSum = 0, iDistance;
+    mg_matcher tMatcher;
+    double dStart, adTime[3];
+    char sName[LINELEN];
+
+    psQueries = malloc(lQueryMem * sizeof(char *));
+    if (argc > 1) {
+        gb_reader *ptReader = openGBFF(argv[1], GB_MMAP | GB_ZEROCOPY);
+        gb_data *ptGBData;
+        gb_span tCountry;
+        unsigned int j;
+
+        if (ptReader == NULL) {
+            fprintf(stderr, "usage: %s [Genbank_file] [repeats]\n", argv[0]);
+            return 1;
+        }
+        selectGBFF(ptReader, GB_FEATURES, asFeatures);
+        while ((ptGBData = readGBFF(ptReader)) != NULL) {
+            for (j = 0; j < ptGBData->iFeatureNum; j++) {
+                tCountry = getQualValue(GB_QUAL_COUNTRY, ptGBData->ptFeatures + j);
+                if (tCountry.sStr == NULL) tCountry = getQualValue(GB_QUAL_GEO_LOC_NAME, ptGBData->ptFeatures + j);
+                if (tCountry.sStr == NULL) continue;
+                tCountry = firstToken(tCountry, ':');
+                if (lQueryNum == lQueryMem) {
+                    lQueryMem *= 2;
+                    psQueries = realloc(psQueries, lQueryMem * sizeof(char *));
+                }
+                tCountry = trimBlanks(tCountry);
+                psQueries[lQueryNum] = malloc(tCountry.lLen + 1);
+                foldName(psQueries[lQueryNum++], tCountry.sStr == NULL ? "" : tCountry.sStr, tCountry.lLen);
+            }
+            freeGBRecord(ptGBData);
+        }
+        closeGBFF(ptReader);
+    } else {
+        for (i = 0; i < NUM_COUNTRY; i++) {
+            psQueries[lQueryNum++] = strdup(country[i]);
+            misspell(sName, country[i], i * 7919);
+            psQueries[lQueryNum++] = strdup(sName);
+            misspell(sName, country[i], i * 104729 + 1);
+            psQueries[lQueryNum++] = strdup(sName);
+            sprintf(sName, "%.3s", country[i]);
+            psQueries[lQueryNum++] = strdup(sName);
+        }
+        for (l = 0; l < lQueryNum; l++) foldName(psQueries[l], psQueries[l], strlen(psQueries[l]));
+    }
+    if (lQueryNum == 0) {
+        fprintf(stderr, "No country texts in %s\n", argv[1]);
+        return 1;
+    }
+
+    /* All must pick the same name before their speed means anything */
+    memset(&tMatcher, 0, sizeof(tMatcher));
+    for (l = 0; l < lQueryNum; l++) {
+        i = matrixCountry(psQueries[l]);
+        if (nearestCountry(&tMatcher, psQueries[l], &iDistance) != (int) i || scanCountry(tMatcher.alPeq, psQueries[l]) != (int) i) {
+            fprintf(stderr, "Mismatch: '%s'\n", psQueries[l]);
+            lMismatch++;
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        adTime[i] = 1e30;
+        for (iRun = 0; iRun < iRepeat; iRun++) {
+            dStart = now();
+            for (l = 0; l < lQueryNum; l++)
+                iSum += i == 2 ? matrixCountry(psQueries[l]) : i == 1 ? scanCountry(tMatcher.alPeq, psQueries[l]) : nearestCountry(&tMatcher, psQueries[l], &iDistance);
+            if (now() - dStart < adTime[i]) adTime[i] = now() - dStart;
+        }
+    }
+
+    printf("%lu queries against %d names, %lu mismatches (%d)\n", lQueryNum, FUZZYNUM, lMismatch, iSum & 1);
+    printf("matrix   %10.1f ns/query\n", adTime[2] * 1e9 / lQueryNum);
+    printf("myers    %10.1f ns/query\n", adTime[1] * 1e9 / lQueryNum);
+    printf("bigrams  %10.1f ns/query\n", adTime[0] * 1e9 / lQueryNum);
+    printf("speedup  %10.1fx over matrix, %.1fx over myers\n", adTime[2] / adTime[0], adTime[1] / adTime[0]);
+
+    for (l = 0; l < lQueryNum; l++) free(psQueries[l]);
+    free(psQueries);
+
+    return lMismatch != 0;
+}
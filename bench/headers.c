@@ -0,0 +1,175 @@
+/* Per-record cost of the header line scanners against the POSIX regular
+   expressions they replace. The regular expression functions are the
+   fallbacks in gbfp.c, which is included here to reach them.
+
+   usage: headers <Genbank_file> [repeats] */
+
+#include <time.h>
+#include "../src/gbfp.c"
+
+static double now(void) {
+    struct timespec tTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &tTime);
+
+    return tTime.tv_sec + tTime.tv_nsec * 1e-9;
+}
+
+#define LOCUSLINE      0
+#define ACCESSIONLINE  1
+#define VERSIONLINE    2
+#define ONELINE        3
+
+typedef struct tHeader {
+    gb_span tLine;
+    int iKind;
+} gb_header;
+
+/* Compares what the two parsers put into a record, 0 if they agree */
+static int compareData(gb_data *ptA, gb_data *ptB) {
+    if (ptA->tAccession.lLen != ptB->tAccession.lLen || ptA->tAccession.sStr != ptB->tAccession.sStr) return 1;
+    if (ptA->tVersion.lLen != ptB->tVersion.lLen || ptA->tVersion.sStr != ptB->tVersion.sStr) return 1;
+    if (ptA->tLocusName.lLen != ptB->tLocusName.lLen || ptA->tLocusName.sStr != ptB->tLocusName.sStr) return 1;
+    if (ptA->lLength != ptB->lLength || ptA->lRegion[0] != ptB->lRegion[0] || ptA->lRegion[1] != ptB->lRegion[1]) return 1;
+    if ((ptA->sGI == NULL) != (ptB->sGI == NULL) || (ptA->sGI != NULL && strcmp(ptA->sGI, ptB->sGI) != 0)) return 1;
+
+    return strcmp(ptA->sType, ptB->sType) || strcmp(ptA->sTopology, ptB->sTopology) ||
+        strcmp(ptA->sDivisionCode, ptB->sDivisionCode) || strcmp(ptA->sDate, ptB->sDate);
+}
+
+/* Runs every header line through either the parser, which scans and only
+   falls back on a regular expression for odd lines, or the regular expressions */
+static void runHeaders(gb_parser *ptParser, gb_header *ptHeaders, unsigned long lHeaderNum, int iRegEx, gb_data *ptGBData) {
+    gb_header *ptHeader;
+    gb_cursor tCursor;
+    gb_span tValue;
+
+    for (ptHeader = ptHeaders; ptHeader < ptHeaders + lHeaderNum; ptHeader++) {
+        switch (ptHeader->iKind) {
+        case LOCUSLINE:
+            if (iRegEx) matchLocus(ptParser, &(ptHeader->tLine), ptGBData, GB_ZEROCOPY);
+            else parseLocus(ptParser, &(ptHeader->tLine), ptGBData, GB_ZEROCOPY);
+            break;
+        case ACCESSIONLINE:
+        case VERSIONLINE:
+            tCursor.sPos = ptHeader->tLine.sStr;
+            tCursor.sEnd = ptHeader->tLine.sStr + ptHeader->tLine.lLen;
+            tCursor.iFlags = GB_ZEROCOPY;
+            tCursor.ptArena = ptGBData->ptArena;
+            tCursor.ptParser = ptParser;
+            ptGBData->sGI = NULL;
+            if (ptHeader->iKind == ACCESSIONLINE) {
+                if (iRegEx) matchAccession(ptParser, &(ptHeader->tLine), ptGBData, GB_ZEROCOPY);
+                else parseAccession(&tCursor, ptGBData);
+            } else {
+                if (iRegEx) matchVersion(ptParser, &(ptHeader->tLine), ptGBData, GB_ZEROCOPY);
+                else parseVersion(&tCursor, ptGBData);
+            }
+            break;
+        default:
+            if (iRegEx) matchOneLine(ptParser, &(ptHeader->tLine), &tValue);
+            else if (scanOneLine(&(ptHeader->tLine), &tValue) != 0) matchOneLine(ptParser, &(ptHeader->tLine), &tValue);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    FILE *FSeqFile;
+    char *sData;
+    long lSize;
+    unsigned long lHeaderNum = 0, lHeaderMem = 1024, lRecordNum = 0, lMismatch = 0;
+    int iA, iB;
+    unsigned int i, iRepeat = (argc > 2) ? atoi(argv[2]) : 5;
+    gb_header *ptHeaders, *ptHeader;
+    gb_cursor tCursor;
+    gb_span tLine, tA, tB;
+    gb_data tScan, tRegEx;
+    gb_parser tParser;
+    double dStart, adTime[2];
+
+    if (argc < 2 || (FSeqFile = fopen(argv[1], "rb")) == NULL) {
+        fprintf(stderr, "usage: %s <Genbank_file> [repeats]\n", argv[0]);
+        return 1;
+    }
+    fseek(FSeqFile, 0, SEEK_END);
+    lSize = ftell(FSeqFile);
+    fseek(FSeqFile, 0, SEEK_SET);
+    sData = malloc(lSize);
+    if (fread(sData, 1, lSize, FSeqFile) != (size_t) lSize) return 1;
+    fclose(FSeqFile);
+
+    /* Collect the header lines the parser runs through these functions */
+    ptHeaders = malloc(lHeaderMem * sizeof(gb_header));
+    tCursor.sPos = sData;
+    tCursor.sEnd = sData + lSize;
+    while (getLine(&tLine, &tCursor)) {
+        int iKind;
+
+        rtrimSpan(&tLine);
+        if (hasPrefix(&tLine, "LOCUS", 5)) { iKind = LOCUSLINE; lRecordNum++; }
+        else if (hasPrefix(&tLine, "ACCESSION", 9)) iKind = ACCESSIONLINE;
+        else if (hasPrefix(&tLine, "VERSION", 7)) iKind = VERSIONLINE;
+        else if (hasPrefix(&tLine, "DEFINITION", 10) || hasPrefix(&tLine, "KEYWORDS", 8) ||
+            hasPrefix(&tLine, "SOURCE", 6) || hasPrefix(&tLine, "  ORGANISM", 10) ||
+            hasPrefix(&tLine, "REFERENCE", 9)) iKind = ONELINE;
+        else continue;
+        if (lHeaderNum == lHeaderMem) {
+            lHeaderMem *= 2;
+            ptHeaders = realloc(ptHeaders, lHeaderMem * sizeof(gb_header));
+        }
+        ptHeaders[lHeaderNum].tLine = tLine;
+        ptHeaders[lHeaderNum++].iKind = iKind;
+    }
+    if (lRecordNum == 0) {
+        fprintf(stderr, "No LOCUS lines in %s\n", argv[1]);
+        return 1;
+    }
+
+    initParser(&tParser);
+    initGBData(&tScan);
+    initGBData(&tRegEx);
+    tScan.ptArena = newArena(MEGA);
+    tRegEx.ptArena = newArena(MEGA);
+
+    /* Both must agree on every line before their speed means anything */
+    for (ptHeader = ptHeaders; ptHeader < ptHeaders + lHeaderNum; ptHeader++) {
+        runHeaders(&tParser, ptHeader, 1, 0, &tScan);
+        runHeaders(&tParser, ptHeader, 1, 1, &tRegEx);
+        if (ptHeader->iKind == ONELINE) {
+            iA = (scanOneLine(&(ptHeader->tLine), &tA) == 0 || matchOneLine(&tParser, &(ptHeader->tLine), &tA) == 0);
+            iB = (matchOneLine(&tParser, &(ptHeader->tLine), &tB) == 0);
+            if (iA != iB || (iA && (tA.sStr != tB.sStr || tA.lLen != tB.lLen))) {
+                fprintf(stderr, "Mismatch: '%.*s'\n", (int) ptHeader->tLine.lLen, ptHeader->tLine.sStr);
+                lMismatch++;
+            }
+        } else if (compareData(&tScan, &tRegEx) != 0) {
+            fprintf(stderr, "Mismatch: '%.*s'\n", (int) ptHeader->tLine.lLen, ptHeader->tLine.sStr);
+            lMismatch++;
+        }
+    }
+
+    for (i = 0; i < 2; i++) {
+        unsigned int iRun;
+
+        adTime[i] = 1e30;
+        for (iRun = 0; iRun < iRepeat; iRun++) {
+            dStart = now();
+            runHeaders(&tParser, ptHeaders, lHeaderNum, i, i ? &tRegEx : &tScan);
+            resetArena(i ? tRegEx.ptArena : tScan.ptArena);
+            if (now() - dStart < adTime[i]) adTime[i] = now() - dStart;
+        }
+    }
+
+    printf("%lu records, %lu header lines, %lu mismatches\n", lRecordNum, lHeaderNum, lMismatch);
+    printf("regex    %8.1f ns/record\n", adTime[1] * 1e9 / lRecordNum);
+    printf("scanner  %8.1f ns/record\n", adTime[0] * 1e9 / lRecordNum);
+    printf("speedup  %8.1fx\n", adTime[1] / adTime[0]);
+
+    freeArena(tScan.ptArena);
+    freeArena(tRegEx.ptArena);
+    freeParser(&tParser);
+    free(ptHeaders);
+    free(sData);
+
+    return lMismatch != 0;
+}
@@ -0,0 +1,144 @@
+/* Region queries through the feature index against a scan of every
+   location of the record. Records of up to 80 features with one to three
+   locations each, some of them long or reversed, are made up at random so
+   that the index meets every shape of tree; both ways must find the same
+   features before their speed means anything. gbfp.c is included to make
+   the records in an arena as the parser does.
+
+   usage: regions [records] [queries] [seed] */
+
+#include <time.h>
+#include "../src/gbfp.c"
+
+#define SPANLEN     1000    /* Positions of a made up record */
+#define MAXFEATURES 80
+
+static double now(void) {
+    struct timespec tTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &tTime);
+
+    return tTime.tv_sec + tTime.tv_nsec * 1e-9;
+}
+
+/* A record of 1 to MAXFEATURES features, with nothing but their locations */
+static gb_data *makeRecord(void) {
+    gb_arena *ptArena = newArena(0);
+    gb_data *ptGBData = allocArena(ptArena, sizeof(gb_data));
+    gb_feature *ptFeature;
+    gb_location *ptLocation;
+    unsigned long lStart, lLen;
+
+    memset(ptGBData, 0, sizeof(gb_data));
+    ptGBData->ptArena = ptArena;
+    ptGBData->iFeatureNum = 1 + rand() % MAXFEATURES;
+    ptGBData->ptFeatures = allocArena(ptArena, ptGBData->iFeatureNum * sizeof(gb_feature));
+    memset(ptGBData->ptFeatures, 0, ptGBData->iFeatureNum * sizeof(gb_feature));
+    for (ptFeature = ptGBData->ptFeatures; ptFeature < ptGBData->ptFeatures + ptGBData->iFeatureNum; ptFeature++) {
+        ptFeature->iLocationNum = 1 + rand() % 3;
+        ptFeature->ptLocation = allocArena(ptArena, ptFeature->iLocationNum * sizeof(gb_location));
+        for (ptLocation = ptFeature->ptLocation; ptLocation < ptFeature->ptLocation + ptFeature->iLocationNum; ptLocation++) {
+            lStart = 1 + rand() % SPANLEN;
+            /* Mostly short, now and then most of the record */
+            lLen = rand() % 8 == 0 ? rand() % SPANLEN : rand() % 50;
+            ptLocation->lStart = lStart;
+            ptLocation->lEnd = lStart + lLen;
+            /* Complement locations may come reversed */
+            if (rand() % 4 == 0) {
+                ptLocation->lStart = lStart + lLen;
+                ptLocation->lEnd = lStart;
+            }
+        }
+    }
+
+    return ptGBData;
+}
+
+/* What findFeatures() gives, by looking at every location */
+static gb_feature **scanFeatures(gb_data *ptGBData, unsigned long lFrom, unsigned long lTo) {
+    gb_feature **pptFound = malloc((ptGBData->iFeatureNum + 1) * sizeof(gb_feature *));
+    gb_feature *ptFeature;
+    gb_location *ptLocation;
+    unsigned long lStart, lEnd;
+    unsigned int iFoundNum = 0;
+
+    for (ptFeature = ptGBData->ptFeatures; ptFeature < ptGBData->ptFeatures + ptGBData->iFeatureNum; ptFeature++) {
+        for (ptLocation = ptFeature->ptLocation; ptLocation < ptFeature->ptLocation + ptFeature->iLocationNum; ptLocation++) {
+            lStart = ptLocation->lStart < ptLocation->lEnd ? ptLocation->lStart : ptLocation->lEnd;
+            lEnd = ptLocation->lStart < ptLocation->lEnd ? ptLocation->lEnd : ptLocation->lStart;
+            if (lStart <= lTo && lEnd >= lFrom) {
+                *(pptFound + iFoundNum++) = ptFeature;
+                break;
+            }
+        }
+    }
+    *(pptFound + iFoundNum) = NULL;
+
+    return pptFound;
+}
+
+int main(int argc, char *argv[]) {
+    gb_data **pptRecords;
+    gb_feature **pptIndexed, **pptScanned;
+    unsigned long lRecordNum = (argc > 1) ? strtoul(argv[1], NULL, 10) : 10000;
+    unsigned long lQueryNum = (argc > 2) ? strtoul(argv[2], NULL, 10) : 400;
+    unsigned long *plQueries;
+    unsigned long l, q, lMismatch = 0, lHits = 0;
+    unsigned int j;
+    int i;
+    double dStart, adTime[2];
+
+    if (lRecordNum == 0 || lQueryNum == 0) {
+        fprintf(stderr, "usage: %s [records] [queries] [seed]\n", argv[0]);
+        return 1;
+    }
+    srand((argc > 3) ? atoi(argv[3]) : 1);
+    pptRecords = malloc(lRecordNum * sizeof(gb_data *));
+    for (l = 0; l < lRecordNum; l++) pptRecords[l] = makeRecord();
+    /* Short ranges, as -r is mostly used, running past either end now and then */
+    plQueries = malloc(2 * lQueryNum * sizeof(unsigned long));
+    for (q = 0; q < lQueryNum; q++) {
+        plQueries[2 * q] = 1 + rand() % (SPANLEN + 50);
+        plQueries[2 * q + 1] = plQueries[2 * q] + rand() % 20;
+    }
+
+    /* Both must find the same features, in the same order */
+    for (l = 0; l < lRecordNum; l++) {
+        for (q = 0; q < lQueryNum; q++) {
+            pptIndexed = findFeatures(pptRecords[l], plQueries[2 * q], plQueries[2 * q + 1]);
+            pptScanned = scanFeatures(pptRecords[l], plQueries[2 * q], plQueries[2 * q + 1]);
+            for (j = 0; pptIndexed[j] != NULL && pptIndexed[j] == pptScanned[j]; j++);
+            if (pptIndexed[j] != pptScanned[j]) {
+                if (lMismatch++ < 5)
+                    fprintf(stderr, "%u features, query %lu..%lu: index and scan differ\n",
+                        pptRecords[l]->iFeatureNum, plQueries[2 * q], plQueries[2 * q + 1]);
+            }
+            for (j = 0; pptScanned[j] != NULL; j++) lHits++;
+            free(pptIndexed);
+            free(pptScanned);
+        }
+    }
+
+    /* The index is built on the first query of each record, which is timed once above */
+    for (i = 0; i < 2; i++) {
+        dStart = now();
+        for (l = 0; l < lRecordNum; l++) {
+            for (q = 0; q < lQueryNum; q++) {
+                if (i == 0) free(findFeatures(pptRecords[l], plQueries[2 * q], plQueries[2 * q + 1]));
+                else free(scanFeatures(pptRecords[l], plQueries[2 * q], plQueries[2 * q + 1]));
+            }
+        }
+        adTime[i] = now() - dStart;
+    }
+
+    printf("%lu records, %lu queries, %lu hits, %lu mismatches\n", lRecordNum, lRecordNum * lQueryNum, lHits, lMismatch);
+    printf("scan     %12.0f queries/s\n", lRecordNum * lQueryNum / adTime[1]);
+    printf("index    %12.0f queries/s\n", lRecordNum * lQueryNum / adTime[0]);
+    printf("speedup  %12.1fx\n", adTime[1] / adTime[0]);
+
+    for (l = 0; l < lRecordNum; l++) freeGBRecord(pptRecords[l]);
+    free(pptRecords);
+    free(plQueries);
+
+    return lMismatch != 0;
+}
@@ -0,0 +1,208 @@
+/* Rows per second written to the FASTA file and table through the buffered
+   writer, against the fprintf(3) calls it replaces. The fields of each row
+   are worked out once beforehand, so only the writing is timed. gbmunge.c
+   is included, with its main() renamed, to reach the writer.
+
+   usage: rows <Genbank_file> [records] [repeats] */
+
+#include <time.h>
+#include <fcntl.h>
+#include "../src/gbfp.c"
+#include "../src/arrow.c"
+#define main mungeMain
+#include "../src/gbmunge.c"
+#undef main
+
+static double now(void) {
+    struct timespec tTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &tTime);
+
+    return tTime.tv_sec + tTime.tv_nsec * 1e-9;
+}
+
+/* What mungeRecord() puts in the outputs for a record */
+typedef struct tRow {
+    gb_span tAccession;
+    gb_span tHost;
+    gb_span tCountry;
+    gb_span tDate;
+    unsigned long lLength;
+    const char *sCountry;
+    const char *sCode;
+    char sConfidence[8];
+    mg_date tCollection;
+    mg_date tSubmission;
+    char sBounds[48];
+    const char *sSequence;
+    size_t lSequence;
+} mg_row;
+
+static void fillRow(mg_row *ptRow, gb_data *ptSeqData, mg_countries *ptCountries) {
+    gb_span tNone = {NULL, 0};
+    gb_feature *ptFeature;
+    double dConfidence;
+    int idx = 0;
+    unsigned int j;
+
+    ptRow->tHost = ptRow->tCountry = ptRow->tDate = tNone;
+    strcpy(ptRow->sConfidence, "NA");
+    for (j = 0; j < ptSeqData->iFeatureNum; j++) {
+        ptFeature = ptSeqData->ptFeatures + j;
+        if (strcmp("source", ptFeature->sFeature) != 0) continue;
+        ptRow->tDate = getQualValue(GB_QUAL_COLLECTION_DATE, ptFeature);
+        ptRow->tHost = getQualValue(GB_QUAL_HOST, ptFeature);
+        if (ptRow->tHost.sStr != NULL) ptRow->tHost = firstToken(ptRow->tHost, ';');
+        ptRow->tCountry = getQualValue(GB_QUAL_COUNTRY, ptFeature);
+        if (ptRow->tCountry.sStr == NULL) ptRow->tCountry = getQualValue(GB_QUAL_GEO_LOC_NAME, ptFeature);
+        if (ptRow->tCountry.sStr != NULL) {
+            idx = resolveCountry(ptCountries, firstToken(ptRow->tCountry, ':'), &dConfidence);
+            snprintf(ptRow->sConfidence, sizeof(ptRow->sConfidence), "%.2f", dConfidence);
+        }
+    }
+    ptRow->tAccession = ptSeqData->tAccession;
+    ptRow->lLength = ptSeqData->lLength;
+    ptRow->sCountry = ptRow->tCountry.sStr == NULL ? "NA" : country[idx];
+    ptRow->sCode = ptRow->tCountry.sStr == NULL ? "NA" : countrycode[idx];
+    parseDate(&ptRow->tCollection, ptRow->tDate.sStr, ptRow->tDate.lLen);
+    parseDate(&ptRow->tSubmission, ptSeqData->sDate, strlen(ptSeqData->sDate));
+    strcpy(ptRow->sBounds, "NA\tNA\tNA");
+    if (ptRow->tCollection.iPrecision != DATE_NONE)
+        snprintf(ptRow->sBounds, sizeof(ptRow->sBounds), "%04d-%02d-%02d\t%04d-%02d-%02d\t%.4f",
+            ptRow->tCollection.aiLower[0], ptRow->tCollection.aiLower[1], ptRow->tCollection.aiLower[2],
+            ptRow->tCollection.aiUpper[0], ptRow->tCollection.aiUpper[1], ptRow->tCollection.aiUpper[2],
+            decimalYear(&ptRow->tCollection));
+    ptRow->sSequence = ptSeqData->sSequence == NULL ? "" : ptSeqData->sSequence;
+    ptRow->lSequence = strlen(ptRow->sSequence);
+}
+
+/* The way gbmunge wrote rows before, a format string per output */
+static void printRow(const mg_row *ptRow, FILE *fFasta, FILE *fTable) {
+    fprintf(fFasta, ">%.*s\n%s\n", SPANARG(ptRow->tAccession), ptRow->sSequence);
+    fprintf(fTable, "%.*s\t%.*s\t%lu\t%s\t%.*s\t%.*s\t%s\t%s\t%.*s\t%s\t%s\t%s\t%s\n",
+        SPANARG(ptRow->tAccession), SPANARG(ptRow->tAccession), ptRow->lLength, ptRow->tSubmission.sDate,
+        SPANARG(ptRow->tHost), SPANARG(ptRow->tCountry), ptRow->sCountry, ptRow->sCode, SPANARG(ptRow->tDate),
+        ptRow->tCollection.sDate, ptRow->sConfidence, asPrecisions[ptRow->tCollection.iPrecision], ptRow->sBounds);
+}
+
+/* The same through the writer, as mungeRecord() does */
+static void putRow(const mg_row *ptRow, mg_writer *ptFasta, mg_writer *ptTable) {
+    putChar(ptFasta, '>');
+    putSpan(ptFasta, ptRow->tAccession);
+    putChar(ptFasta, '\n');
+    putBytes(ptFasta, ptRow->sSequence, ptRow->lSequence);
+    putChar(ptFasta, '\n');
+
+    putSpan(ptTable, ptRow->tAccession);
+    putChar(ptTable, '\t');
+    putSpan(ptTable, ptRow->tAccession);
+    putChar(ptTable, '\t');
+    putULong(ptTable, ptRow->lLength);
+    putField(ptTable, ptRow->tSubmission.sDate);
+    putChar(ptTable, '\t');
+    putSpan(ptTable, ptRow->tHost);
+    putChar(ptTable, '\t');
+    putSpan(ptTable, ptRow->tCountry);
+    putField(ptTable, ptRow->sCountry);
+    putField(ptTable, ptRow->sCode);
+    putChar(ptTable, '\t');
+    putSpan(ptTable, ptRow->tDate);
+    putField(ptTable, ptRow->tCollection.sDate);
+    putField(ptTable, ptRow->sConfidence);
+    putField(ptTable, asPrecisions[ptRow->tCollection.iPrecision]);
+    putField(ptTable, ptRow->sBounds);
+    putChar(ptTable, '\n');
+    settleWriter(ptFasta);
+    settleWriter(ptTable);
+}
+
+int main(int argc, char *argv[]) {
+    gb_reader *ptReader;
+    gb_data **pptRecords;
+    mg_row *ptRows;
+    mg_countries tCountries;
+    mg_writer tFasta, tTable;
+    FILE *fFasta, *fTable;
+    char *sFasta, *sTable;
+    size_t lFasta, lTable;
+    unsigned long lRecordMax = (argc > 2) ? strtoul(argv[2], NULL, 10) : 2000, lRecordNum = 0, l;
+    unsigned long long lBytes = 0;
+    unsigned int i, iRun, iRepeat = (argc > 3) ? atoi(argv[3]) : 5;
+    int iNull, iMismatch;
+    double dStart, adTime[2];
+
+    if (argc < 2 || (ptReader = openGBFF(argv[1], 0)) == NULL) {
+        fprintf(stderr, "usage: %s <Genbank_file> [records] [repeats]\n", argv[0]);
+        return 1;
+    }
+    /* Records are kept, so they are copied out of the input */
+    initCountries(&tCountries, NULL);
+    pptRecords = malloc(lRecordMax * sizeof(gb_data *));
+    ptRows = malloc(lRecordMax * sizeof(mg_row));
+    selectGBFF(ptReader, GB_ACCESSION | GB_FEATURES | GB_ORIGIN, asFeatures);
+    while (lRecordNum < lRecordMax && (pptRecords[lRecordNum] = readGBFF(ptReader)) != NULL) {
+        fillRow(ptRows + lRecordNum, pptRecords[lRecordNum], &tCountries);
+        lRecordNum++;
+    }
+    if (lRecordNum == 0) {
+        fprintf(stderr, "No records in %s\n", argv[1]);
+        return 1;
+    }
+
+    /* Both must write the same bytes before their speed means anything */
+    fFasta = open_memstream(&sFasta, &lFasta);
+    fTable = open_memstream(&sTable, &lTable);
+    openWriter(&tFasta, -1);
+    openWriter(&tTable, -1);
+    for (l = 0; l < lRecordNum; l++) {
+        printRow(ptRows + l, fFasta, fTable);
+        putRow(ptRows + l, &tFasta, &tTable);
+    }
+    fclose(fFasta);
+    fclose(fTable);
+    iMismatch = lFasta != tFasta.lLen || memcmp(sFasta, tFasta.sBuf, lFasta) != 0 ||
+        lTable != tTable.lLen || memcmp(sTable, tTable.sBuf, lTable) != 0;
+    lBytes = lFasta + lTable;
+    free(sFasta);
+    free(sTable);
+    closeWriter(&tFasta);
+    closeWriter(&tTable);
+
+    if ((iNull = open("/dev/null", O_WRONLY)) < 0) return 1;
+    fFasta = fdopen(dup(iNull), "w");
+    fTable = fdopen(dup(iNull), "w");
+    for (i = 0; i < 2; i++) {
+        adTime[i] = 1e30;
+        for (iRun = 0; iRun < iRepeat; iRun++) {
+            dStart = now();
+            if (i == 0) {
+                openWriter(&tFasta, iNull);
+                openWriter(&tTable, iNull);
+                for (l = 0; l < lRecordNum; l++) putRow(ptRows + l, &tFasta, &tTable);
+                closeWriter(&tFasta);
+                closeWriter(&tTable);
+            } else {
+                for (l = 0; l < lRecordNum; l++) printRow(ptRows + l, fFasta, fTable);
+                fflush(fFasta);
+                fflush(fTable);
+            }
+            if (now() - dStart < adTime[i]) adTime[i] = now() - dStart;
+        }
+    }
+
+    printf("%lu rows, %.1f MB, %s\n", lRecordNum, lBytes / 1e6, iMismatch ? "outputs differ" : "same output");
+    printf("fprintf  %12.0f rows/s\n", lRecordNum / adTime[1]);
+    printf("writer   %12.0f rows/s\n", lRecordNum / adTime[0]);
+    printf("speedup  %12.1fx\n", adTime[1] / adTime[0]);
+
+    fclose(fFasta);
+    fclose(fTable);
+    close(iNull);
+    for (l = 0; l < lRecordNum; l++) freeGBRecord(pptRecords[l]);
+    free(pptRecords);
+    free(ptRows);
+    freeCountries(&tCountries);
+    closeGBFF(ptReader);
+
+    return iMismatch;
+}
@@ -0,0 +1,596 @@
+/* Writer of Arrow IPC files, the format of Feather v2, as read by pyarrow,
+   pandas, polars and R's arrow. A file is the magic "ARROW1", the schema,
+   dictionary and record batch messages, each a flatbuffer of metadata
+   followed by the column buffers, and a footer saying where the batches
+   are. The flatbuffers are put together here by hand, back to front as the
+   flatbuffers library does, so nothing beyond the C library is needed */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "arrow.h"
+
+/* Values from Schema.fbs and Message.fbs */
+#define FB_METADATA_V5      4
+#define FB_SCHEMA           1   /* MessageHeader */
+#define FB_DICTIONARYBATCH  2
+#define FB_RECORDBATCH      3
+#define FB_INT              2   /* Type */
+#define FB_FLOATINGPOINT    3
+#define FB_UTF8             5
+#define FB_DATE             8
+#define FB_DOUBLE           2   /* Precision */
+#define FB_DAY              0   /* DateUnit */
+
+#define FB_FIELDNUM         8   /* Most fields of the tables written */
+#define FB_NODELEN          16  /* FieldNode and Buffer structs */
+#define FB_BLOCKLEN         24  /* Block struct */
+
+/* A flatbuffer, built from its end towards its start. Objects are referred
+   to by their distance from the end, which stays the same as it grows */
+typedef struct tBuilder {
+    unsigned char *sBuf;
+    size_t lSize;
+    size_t lHead;           /* The flatbuffer is sBuf[lHead..lSize) */
+    size_t alFields[FB_FIELDNUM]; /* Fields of the table being built, 0 when absent */
+    size_t lTableEnd;
+} fb_builder;
+
+/* Buffers of a message body, each padded to 8 bytes */
+typedef struct tBody {
+    const void **apParts;
+    size_t *alParts;
+    size_t lPartNum;
+    ar_buffer tNodes;       /* FieldNode structs */
+    ar_buffer tBuffers;     /* Buffer structs */
+    unsigned long long lLen;
+} ar_body;
+
+static const unsigned char sZeros[8] = {0};
+
+/* Little endian, as flatbuffers are */
+static void putLE(unsigned char *s, unsigned long long lValue, size_t lLen) {
+    size_t i;
+
+    for (i = 0; i < lLen; i++, lValue >>= 8) s[i] = lValue & 0xff;
+}
+
+static size_t fbLen(const fb_builder *ptFb) {
+    return ptFb->lSize - ptFb->lHead;
+}
+
+/* Makes room for lLen bytes at the front */
+static unsigned char *fbClaim(fb_builder *ptFb, size_t lLen) {
+    size_t lUsed = fbLen(ptFb);
+    unsigned char *sBuf;
+
+    if (ptFb->lHead < lLen) {
+        while (ptFb->lSize - lUsed < lLen) ptFb->lSize *= 2;
+        sBuf = malloc(ptFb->lSize);
+        memcpy(sBuf + ptFb->lSize - lUsed, ptFb->sBuf + ptFb->lHead, lUsed);
+        free(ptFb->sBuf);
+        ptFb->sBuf = sBuf;
+        ptFb->lHead = ptFb->lSize - lUsed;
+    }
+    ptFb->lHead -= lLen;
+
+    return ptFb->sBuf + ptFb->lHead;
+}
+
+/* Pads so that lLen bytes put next start on a multiple of lAlign */
+static void fbAlign(fb_builder *ptFb, size_t lLen, size_t lAlign) {
+    size_t lPad = (lAlign - (fbLen(ptFb) + lLen) % lAlign) % lAlign;
+
+    memset(fbClaim(ptFb, lPad), 0, lPad);
+}
+
+static void fbScalar(fb_builder *ptFb, unsigned long long lValue, size_t lLen) {
+    fbAlign(ptFb, lLen, lLen);
+    putLE(fbClaim(ptFb, lLen), lValue, lLen);
+}
+
+/* An offset to an object put before */
+static void fbOffset(fb_builder *ptFb, size_t lRef) {
+    fbAlign(ptFb, 4, 4);
+    fbScalar(ptFb, fbLen(ptFb) + 4 - lRef, 4);
+}
+
+static size_t fbString(fb_builder *ptFb, const char *sStr) {
+    size_t lLen = strlen(sStr);
+
+    fbAlign(ptFb, lLen + 1, 4);
+    memcpy(fbClaim(ptFb, lLen + 1), sStr, lLen + 1);
+    fbScalar(ptFb, lLen, 4);
+
+    return fbLen(ptFb);
+}
+
+/* A vector of offsets to objects put before */
+static size_t fbOffsets(fb_builder *ptFb, const size_t *alRefs, size_t lNum) {
+    size_t k;
+
+    for (k = lNum; k > 0; k--) fbOffset(ptFb, alRefs[k - 1]);
+    fbScalar(ptFb, lNum, 4);
+
+    return fbLen(ptFb);
+}
+
+/* A vector of structs of 8 byte fields, already in little endian */
+static size_t fbStructs(fb_builder *ptFb, const ar_buffer *ptStructs, size_t lStructLen) {
+    fbAlign(ptFb, ptStructs->lLen, 8);
+    if (ptStructs->lLen > 0) memcpy(fbClaim(ptFb, ptStructs->lLen), ptStructs->sData, ptStructs->lLen);
+    fbScalar(ptFb, ptStructs->lLen / lStructLen, 4);
+
+    return fbLen(ptFb);
+}
+
+/* Fields are added after their objects, and tables are not nested */
+static void fbStartTable(fb_builder *ptFb) {
+    memset(ptFb->alFields, 0, sizeof(ptFb->alFields));
+    ptFb->lTableEnd = fbLen(ptFb);
+}
+
+static void fbAddScalar(fb_builder *ptFb, int iField, unsigned long long lValue, size_t lLen) {
+    fbScalar(ptFb, lValue, lLen);
+    ptFb->alFields[iField] = fbLen(ptFb);
+}
+
+static void fbAddOffset(fb_builder *ptFb, int iField, size_t lRef) {
+    fbOffset(ptFb, lRef);
+    ptFb->alFields[iField] = fbLen(ptFb);
+}
+
+/* Puts the vtable of the table right before it */
+static size_t fbEndTable(fb_builder *ptFb) {
+    size_t lTable;
+    int i, iFieldNum = 0;
+
+    fbScalar(ptFb, 0, 4);
+    lTable = fbLen(ptFb);
+    for (i = 0; i < FB_FIELDNUM; i++) if (ptFb->alFields[i] != 0) iFieldNum = i + 1;
+    for (i = iFieldNum - 1; i >= 0; i--) fbScalar(ptFb, ptFb->alFields[i] == 0 ? 0 : lTable - ptFb->alFields[i], 2);
+    fbScalar(ptFb, lTable - ptFb->lTableEnd, 2);
+    fbScalar(ptFb, 4 + 2 * iFieldNum, 2);
+    /* The table starts with how far back its vtable is */
+    putLE(ptFb->sBuf + ptFb->lSize - lTable, fbLen(ptFb) - lTable, 4);
+
+    return lTable;
+}
+
+/* Puts the offset to the root table. The flatbuffer is left a multiple of
+   8 bytes long, so that it stays aligned when written after the prefix */
+static void fbFinish(fb_builder *ptFb, size_t lRoot) {
+    fbAlign(ptFb, 4, 8);
+    fbOffset(ptFb, lRoot);
+}
+
+static void fbClear(fb_builder *ptFb) {
+    ptFb->lHead = ptFb->lSize;
+}
+
+static void *growBuffer(ar_buffer *ptBuf, size_t lLen) {
+    void *pNew;
+
+    if (ptBuf->lLen + lLen > ptBuf->lSize) {
+        if (ptBuf->lSize == 0) ptBuf->lSize = 256;
+        while (ptBuf->lLen + lLen > ptBuf->lSize) ptBuf->lSize *= 2;
+        ptBuf->sData = realloc(ptBuf->sData, ptBuf->lSize);
+    }
+    pNew = ptBuf->sData + ptBuf->lLen;
+    ptBuf->lLen += lLen;
+
+    return pNew;
+}
+
+static void putInt32(ar_buffer *ptBuf, int32_t iValue) {
+    memcpy(growBuffer(ptBuf, 4), &iValue, 4);
+}
+
+static void putStruct(ar_buffer *ptBuf, unsigned long long lFirst, unsigned long long lSecond) {
+    unsigned char *s = growBuffer(ptBuf, FB_NODELEN);
+
+    putLE(s, lFirst, 8);
+    putLE(s + 8, lSecond, 8);
+}
+
+/* The Schema table, for the schema message and the footer */
+static size_t fbSchema(fb_builder *ptFb, const ar_file *ptArrow) {
+    size_t *alFields = malloc(ptArrow->iColumnNum * sizeof(size_t));
+    size_t lName, lType, lIndex, lDict, lChildren, lSchema;
+    const ar_column *ptColumn;
+    int iTypeType, i;
+    uint16_t iOne = 1;
+
+    for (i = 0; i < ptArrow->iColumnNum; i++) {
+        ptColumn = ptArrow->ptColumns + i;
+        lName = fbString(ptFb, ptColumn->sName);
+        lChildren = fbOffsets(ptFb, NULL, 0);
+        lDict = 0;
+        fbStartTable(ptFb);
+        switch (ptColumn->iType) {
+        case AR_UINT64:
+            iTypeType = FB_INT;
+            fbAddScalar(ptFb, 0, 64, 4);
+            fbAddScalar(ptFb, 1, 0, 1);
+            break;
+        case AR_FLOAT64:
+            iTypeType = FB_FLOATINGPOINT;
+            fbAddScalar(ptFb, 0, FB_DOUBLE, 2);
+            break;
+        case AR_DATE32:
+            /* DAY is not the default unit, so it is always written */
+            iTypeType = FB_DATE;
+            fbAddScalar(ptFb, 0, FB_DAY, 2);
+            break;
+        default:
+            iTypeType = FB_UTF8;
+        }
+        lType = fbEndTable(ptFb);
+        if (ptColumn->iType == AR_DICTIONARY) {
+            fbStartTable(ptFb);
+            fbAddScalar(ptFb, 0, 32, 4);
+            fbAddScalar(ptFb, 1, 1, 1);
+            lIndex = fbEndTable(ptFb);
+            /* The column number is the dictionary id */
+            fbStartTable(ptFb);
+            fbAddScalar(ptFb, 0, i, 8);
+            fbAddOffset(ptFb, 1, lIndex);
+            lDict = fbEndTable(ptFb);
+        }
+        fbStartTable(ptFb);
+        fbAddOffset(ptFb, 0, lName);
+        fbAddScalar(ptFb, 1, 1, 1);
+        fbAddScalar(ptFb, 2, iTypeType, 1);
+        fbAddOffset(ptFb, 3, lType);
+        if (lDict != 0) fbAddOffset(ptFb, 4, lDict);
+        fbAddOffset(ptFb, 5, lChildren);
+        alFields[i] = fbEndTable(ptFb);
+    }
+    lChildren = fbOffsets(ptFb, alFields, ptArrow->iColumnNum);
+    fbStartTable(ptFb);
+    /* Column buffers are in the byte order of the machine */
+    fbAddScalar(ptFb, 0, *(unsigned char *) &iOne == 0, 2);
+    fbAddOffset(ptFb, 1, lChildren);
+    lSchema = fbEndTable(ptFb);
+    free(alFields);
+
+    return lSchema;
+}
+
+static size_t fbRecordBatch(fb_builder *ptFb, unsigned long long lRowNum, const ar_body *ptBody) {
+    size_t lNodes = fbStructs(ptFb, &ptBody->tNodes, FB_NODELEN);
+    size_t lBuffers = fbStructs(ptFb, &ptBody->tBuffers, FB_NODELEN);
+
+    fbStartTable(ptFb);
+    fbAddScalar(ptFb, 0, lRowNum, 8);
+    fbAddOffset(ptFb, 1, lNodes);
+    fbAddOffset(ptFb, 2, lBuffers);
+
+    return fbEndTable(ptFb);
+}
+
+static void fbMessage(fb_builder *ptFb, int iHeaderType, size_t lHeader, unsigned long long lBodyLen) {
+    fbStartTable(ptFb);
+    fbAddScalar(ptFb, 0, FB_METADATA_V5, 2);
+    fbAddScalar(ptFb, 1, iHeaderType, 1);
+    fbAddOffset(ptFb, 2, lHeader);
+    fbAddScalar(ptFb, 3, lBodyLen, 8);
+    fbFinish(ptFb, fbEndTable(ptFb));
+}
+
+static void addBuffer(ar_body *ptBody, const void *pData, size_t lLen) {
+    ptBody->apParts[ptBody->lPartNum] = pData;
+    ptBody->alParts[ptBody->lPartNum++] = lLen;
+    putStruct(&ptBody->tBuffers, ptBody->lLen, lLen);
+    ptBody->lLen += (lLen + 7) & ~(size_t) 7;
+}
+
+static void clearBody(ar_body *ptBody) {
+    ptBody->lPartNum = 0;
+    ptBody->tNodes.lLen = ptBody->tBuffers.lLen = 0;
+    ptBody->lLen = 0;
+}
+
+static void writeBytes(ar_file *ptArrow, const void *pData, size_t lLen) {
+    if (lLen > 0 && fwrite(pData, 1, lLen, ptArrow->fOut) != lLen) ptArrow->iError = 1;
+    ptArrow->lOffset += lLen;
+}
+
+/* Writes the message in the builder and its body, noting where it is in
+   the list of blocks when there is one */
+static void writeMessage(ar_file *ptArrow, const fb_builder *ptFb, const ar_body *ptBody, ar_block **pptBlocks, size_t *plNum, size_t *plMem) {
+    unsigned char sPrefix[8];
+    size_t i;
+
+    if (pptBlocks != NULL) {
+        if (*plNum == *plMem) {
+            *plMem = *plMem == 0 ? 16 : 2 * *plMem;
+            *pptBlocks = realloc(*pptBlocks, *plMem * sizeof(ar_block));
+        }
+        (*pptBlocks)[*plNum].lOffset = ptArrow->lOffset;
+        (*pptBlocks)[*plNum].iMetaLen = 8 + fbLen(ptFb);
+        (*pptBlocks)[(*plNum)++].lBodyLen = ptBody->lLen;
+    }
+    putLE(sPrefix, 0xffffffff, 4);
+    putLE(sPrefix + 4, fbLen(ptFb), 4);
+    writeBytes(ptArrow, sPrefix, 8);
+    writeBytes(ptArrow, ptFb->sBuf + ptFb->lHead, fbLen(ptFb));
+    for (i = 0; ptBody != NULL && i < ptBody->lPartNum; i++) {
+        writeBytes(ptArrow, ptBody->apParts[i], ptBody->alParts[i]);
+        writeBytes(ptArrow, sZeros, -ptBody->alParts[i] & 7);
+    }
+}
+
+/* Writes the rows gathered so far as a record batch */
+static void writeBatch(ar_file *ptArrow) {
+    fb_builder tFb = {NULL, 1024, 1024, {0}, 0};
+    ar_body tBody = {NULL, NULL, 0, {NULL, 0, 0}, {NULL, 0, 0}, 0};
+    ar_column *ptColumn;
+    int i;
+
+    tFb.sBuf = malloc(tFb.lSize);
+    tBody.apParts = malloc(3 * ptArrow->iColumnNum * sizeof(void *));
+    tBody.alParts = malloc(3 * ptArrow->iColumnNum * sizeof(size_t));
+    clearBody(&tBody);
+    for (i = 0; i < ptArrow->iColumnNum; i++) {
+        ptColumn = ptArrow->ptColumns + i;
+        putStruct(&tBody.tNodes, ptArrow->lRowNum, ptColumn->lNullNum);
+        /* Without nulls the validity bitmap can be left out */
+        addBuffer(&tBody, ptColumn->tValid.sData, ptColumn->lNullNum == 0 ? 0 : (ptArrow->lRowNum + 7) / 8);
+        if (ptColumn->iType == AR_UTF8) addBuffer(&tBody, ptColumn->tOffsets.sData, ptColumn->tOffsets.lLen);
+        addBuffer(&tBody, ptColumn->tValues.sData, ptColumn->tValues.lLen);
+    }
+    fbMessage(&tFb, FB_RECORDBATCH, fbRecordBatch(&tFb, ptArrow->lRowNum, &tBody), tBody.lLen);
+    writeMessage(ptArrow, &tFb, &tBody, &ptArrow->ptBatches, &ptArrow->lBatchNum, &ptArrow->lBatchMem);
+
+    for (i = 0; i < ptArrow->iColumnNum; i++) {
+        ptColumn = ptArrow->ptColumns + i;
+        ptColumn->tValid.lLen = ptColumn->tValues.lLen = 0;
+        ptColumn->tOffsets.lLen = 4;
+        ptColumn->lNullNum = 0;
+    }
+    ptArrow->lRowNum = 0;
+    ptArrow->lBatchLen = 0;
+
+    free(tFb.sBuf);
+    free(tBody.apParts);
+    free(tBody.alParts);
+    free(tBody.tNodes.sData);
+    free(tBody.tBuffers.sData);
+}
+
+/* Writes the dictionary of each dictionary column, whole. The file format
+   allows a dictionary anywhere before the footer, which lists where they
+   are, and delta dictionaries are not read by all readers (polars) */
+static void writeDictionaries(ar_file *ptArrow) {
+    fb_builder tFb = {NULL, 1024, 1024, {0}, 0};
+    ar_body tBody = {NULL, NULL, 0, {NULL, 0, 0}, {NULL, 0, 0}, 0};
+    const void *apParts[3];
+    size_t alParts[3];
+    ar_column *ptColumn;
+    size_t lBatch;
+    int i;
+
+    tFb.sBuf = malloc(tFb.lSize);
+    tBody.apParts = apParts;
+    tBody.alParts = alParts;
+    for (i = 0; i < ptArrow->iColumnNum; i++) {
+        ptColumn = ptArrow->ptColumns + i;
+        if (ptColumn->iType != AR_DICTIONARY) continue;
+        clearBody(&tBody);
+        putStruct(&tBody.tNodes, ptColumn->lDictNum, 0);
+        addBuffer(&tBody, NULL, 0);
+        addBuffer(&tBody, ptColumn->tDictOffsets.sData, ptColumn->tDictOffsets.lLen);
+        addBuffer(&tBody, ptColumn->tDictValues.sData, ptColumn->tDictValues.lLen);
+        fbClear(&tFb);
+        lBatch = fbRecordBatch(&tFb, ptColumn->lDictNum, &tBody);
+        fbStartTable(&tFb);
+        fbAddScalar(&tFb, 0, i, 8);
+        fbAddOffset(&tFb, 1, lBatch);
+        fbMessage(&tFb, FB_DICTIONARYBATCH, fbEndTable(&tFb), tBody.lLen);
+        writeMessage(ptArrow, &tFb, &tBody, &ptArrow->ptDicts, &ptArrow->lDictNum, &ptArrow->lDictMem);
+    }
+    free(tFb.sBuf);
+    free(tBody.tNodes.sData);
+    free(tBody.tBuffers.sData);
+}
+
+/* Writes the magic and the schema; fOut is written in order, so it can be
+   a pipe */
+ar_file *openArrow(FILE *fOut, const ar_field *ptFields, int iFieldNum) {
+    ar_file *ptArrow = calloc(1, sizeof(ar_file));
+    fb_builder tFb = {NULL, 1024, 1024, {0}, 0};
+    ar_column *ptColumn;
+    int i;
+
+    ptArrow->fOut = fOut;
+    ptArrow->iColumnNum = iFieldNum;
+    ptArrow->ptColumns = calloc(iFieldNum, sizeof(ar_column));
+    for (i = 0; i < iFieldNum; i++) {
+        ptColumn = ptArrow->ptColumns + i;
+        ptColumn->sName = strdup(ptFields[i].sName);
+        ptColumn->iType = ptFields[i].iType;
+        putInt32(&ptColumn->tOffsets, 0);
+        if (ptColumn->iType == AR_DICTIONARY) {
+            putInt32(&ptColumn->tDictOffsets, 0);
+            ptColumn->lDictSlotNum = AR_DICTSLOTNUM;
+            ptColumn->aiDictSlots = malloc(AR_DICTSLOTNUM * sizeof(int));
+            memset(ptColumn->aiDictSlots, 0xff, AR_DICTSLOTNUM * sizeof(int));
+        }
+    }
+
+    writeBytes(ptArrow, "ARROW1\0\0", 8);
+    tFb.sBuf = malloc(tFb.lSize);
+    fbMessage(&tFb, FB_SCHEMA, fbSchema(&tFb, ptArrow), 0);
+    writeMessage(ptArrow, &tFb, NULL, NULL, NULL, NULL);
+    free(tFb.sBuf);
+
+    return ptArrow;
+}
+
+/* Marks the value of the current row valid or not */
+static void setValid(ar_file *ptArrow, ar_column *ptColumn, int iValid) {
+    unsigned long lRow = ptArrow->lRowNum;
+
+    if (lRow % 8 == 0) *(unsigned char *) growBuffer(&ptColumn->tValid, 1) = 0;
+    if (iValid) ptColumn->tValid.sData[lRow / 8] |= 1 << (lRow % 8);
+    else ptColumn->lNullNum++;
+}
+
+static size_t hashBytes(const char *sStr, size_t lLen) {
+    size_t lHash = 2166136261u;
+
+    while (lLen-- > 0) lHash = (lHash ^ (unsigned char) *sStr++) * 16777619u;
+
+    return lHash;
+}
+
+/* The index of a string in a column's dictionary, added if it is new */
+static int32_t dictIndex(ar_column *ptColumn, const char *sStr, size_t lLen) {
+    int32_t *aiOffsets = (int32_t *) ptColumn->tDictOffsets.sData;
+    size_t lMask = ptColumn->lDictSlotNum - 1, lSlot, k;
+    int iEntry;
+
+    for (lSlot = hashBytes(sStr, lLen) & lMask; (iEntry = ptColumn->aiDictSlots[lSlot]) >= 0; lSlot = (lSlot + 1) & lMask) {
+        if ((size_t) (aiOffsets[iEntry + 1] - aiOffsets[iEntry]) == lLen &&
+            memcmp(ptColumn->tDictValues.sData + aiOffsets[iEntry], sStr, lLen) == 0) return iEntry;
+    }
+    if (lLen > 0) memcpy(growBuffer(&ptColumn->tDictValues, lLen), sStr, lLen);
+    putInt32(&ptColumn->tDictOffsets, ptColumn->tDictValues.lLen);
+    ptColumn->aiDictSlots[lSlot] = ptColumn->lDictNum;
+
+    /* The table is kept at most half full */
+    if (2 * (size_t) ++ptColumn->lDictNum > ptColumn->lDictSlotNum) {
+        aiOffsets = (int32_t *) ptColumn->tDictOffsets.sData;
+        ptColumn->lDictSlotNum *= 2;
+        lMask = ptColumn->lDictSlotNum - 1;
+        ptColumn->aiDictSlots = realloc(ptColumn->aiDictSlots, ptColumn->lDictSlotNum * sizeof(int));
+        memset(ptColumn->aiDictSlots, 0xff, ptColumn->lDictSlotNum * sizeof(int));
+        for (k = 0; k < (size_t) ptColumn->lDictNum; k++) {
+            lSlot = hashBytes((char *) ptColumn->tDictValues.sData + aiOffsets[k], aiOffsets[k + 1] - aiOffsets[k]) & lMask;
+            while (ptColumn->aiDictSlots[lSlot] >= 0) lSlot = (lSlot + 1) & lMask;
+            ptColumn->aiDictSlots[lSlot] = k;
+        }
+    }
+
+    return ptColumn->lDictNum - 1;
+}
+
+void putArrowNull(ar_file *ptArrow, int iColumn) {
+    ar_column *ptColumn = ptArrow->ptColumns + iColumn;
+
+    setValid(ptArrow, ptColumn, 0);
+    if (ptColumn->iType == AR_UTF8) putInt32(&ptColumn->tOffsets, ptColumn->tValues.lLen);
+    else if (ptColumn->iType == AR_DICTIONARY || ptColumn->iType == AR_DATE32) putInt32(&ptColumn->tValues, 0);
+    else memset(growBuffer(&ptColumn->tValues, 8), 0, 8);
+}
+
+void putArrowString(ar_file *ptArrow, int iColumn, const char *sStr, size_t lLen) {
+    ar_column *ptColumn = ptArrow->ptColumns + iColumn;
+
+    setValid(ptArrow, ptColumn, 1);
+    if (ptColumn->iType == AR_DICTIONARY) {
+        putInt32(&ptColumn->tValues, dictIndex(ptColumn, sStr, lLen));
+        return;
+    }
+    if (lLen > 0) memcpy(growBuffer(&ptColumn->tValues, lLen), sStr, lLen);
+    putInt32(&ptColumn->tOffsets, ptColumn->tValues.lLen);
+    ptArrow->lBatchLen += lLen;
+}
+
+void putArrowUInt(ar_file *ptArrow, int iColumn, unsigned long long lValue) {
+    ar_column *ptColumn = ptArrow->ptColumns + iColumn;
+    uint64_t lWide = lValue;
+
+    setValid(ptArrow, ptColumn, 1);
+    memcpy(growBuffer(&ptColumn->tValues, 8), &lWide, 8);
+}
+
+void putArrowDouble(ar_file *ptArrow, int iColumn, double dValue) {
+    ar_column *ptColumn = ptArrow->ptColumns + iColumn;
+
+    setValid(ptArrow, ptColumn, 1);
+    memcpy(growBuffer(&ptColumn->tValues, 8), &dValue, 8);
+}
+
+void putArrowDate(ar_file *ptArrow, int iColumn, long lDays) {
+    ar_column *ptColumn = ptArrow->ptColumns + iColumn;
+
+    setValid(ptArrow, ptColumn, 1);
+    putInt32(&ptColumn->tValues, lDays);
+}
+
+/* Ends a row, once every column has a value; the batch is written when it
+   is full, so memory use stays bounded */
+void endArrowRow(ar_file *ptArrow) {
+    ptArrow->lRowNum++;
+    ptArrow->lBatchLen += 8 * ptArrow->iColumnNum;
+    if (ptArrow->lRowNum >= AR_BATCHROWS || ptArrow->lBatchLen >= AR_BATCHLEN) writeBatch(ptArrow);
+}
+
+/* Blocks are structs of an 8 byte offset, a 4 byte length padded to 8 and
+   an 8 byte length */
+static size_t fbBlocks(fb_builder *ptFb, const ar_block *ptBlocks, size_t lNum) {
+    ar_buffer tStructs = {NULL, 0, 0};
+    unsigned char *s;
+    size_t k, lRef;
+
+    for (k = 0; k < lNum; k++) {
+        s = growBuffer(&tStructs, FB_BLOCKLEN);
+        putLE(s, ptBlocks[k].lOffset, 8);
+        putLE(s + 8, ptBlocks[k].iMetaLen, 8);
+        putLE(s + 16, ptBlocks[k].lBodyLen, 8);
+    }
+    lRef = fbStructs(ptFb, &tStructs, FB_BLOCKLEN);
+    free(tStructs.sData);
+
+    return lRef;
+}
+
+/* Writes the last batch and the footer, and frees the writer; returns
+   whether anything could not be written. fOut is left open */
+int closeArrow(ar_file *ptArrow) {
+    fb_builder tFb = {NULL, 1024, 1024, {0}, 0};
+    unsigned char sEnd[8];
+    size_t lSchema, lDicts, lBatches;
+    int iError, i;
+
+    if (ptArrow->lRowNum > 0 || ptArrow->lBatchNum == 0) writeBatch(ptArrow);
+    writeDictionaries(ptArrow);
+    putLE(sEnd, 0xffffffff, 4);
+    putLE(sEnd + 4, 0, 4);
+    writeBytes(ptArrow, sEnd, 8);
+
+    tFb.sBuf = malloc(tFb.lSize);
+    lSchema = fbSchema(&tFb, ptArrow);
+    lDicts = fbBlocks(&tFb, ptArrow->ptDicts, ptArrow->lDictNum);
+    lBatches = fbBlocks(&tFb, ptArrow->ptBatches, ptArrow->lBatchNum);
+    fbStartTable(&tFb);
+    fbAddScalar(&tFb, 0, FB_METADATA_V5, 2);
+    fbAddOffset(&tFb, 1, lSchema);
+    fbAddOffset(&tFb, 2, lDicts);
+    fbAddOffset(&tFb, 3, lBatches);
+    fbFinish(&tFb, fbEndTable(&tFb));
+    writeBytes(ptArrow, tFb.sBuf + tFb.lHead, fbLen(&tFb));
+    putLE(sEnd, fbLen(&tFb), 4);
+    writeBytes(ptArrow, sEnd, 4);
+    writeBytes(ptArrow, "ARROW1", 6);
+    free(tFb.sBuf);
+
+    iError = ptArrow->iError || fflush(ptArrow->fOut) != 0;
+    for (i = 0; i < ptArrow->iColumnNum; i++) {
+        free(ptArrow->ptColumns[i].sName);
+        free(ptArrow->ptColumns[i].tValid.sData);
+        free(ptArrow->ptColumns[i].tOffsets.sData);
+        free(ptArrow->ptColumns[i].tValues.sData);
+        free(ptArrow->ptColumns[i].tDictOffsets.sData);
+        free(ptArrow->ptColumns[i].tDictValues.sData);
+        free(ptArrow->ptColumns[i].aiDictSlots);
+    }
+    free(ptArrow->ptColumns);
+    free(ptArrow->ptDicts);
+    free(ptArrow->ptBatches);
+    free(ptArrow);
+
+    return iError;
+}
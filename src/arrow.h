@@ -0,0 +1,78 @@
+#ifndef ARROW_H
+#define ARROW_H
+
+#include <stdio.h>
+
+#define AR_BATCHROWS        65536       /* Most rows of a record batch */
+#define AR_BATCHLEN         (64 << 20)  /* Bytes of column data that end a record batch */
+#define AR_DICTSLOTNUM      1024        /* Initial slots of a dictionary's hash table */
+
+/* Column types */
+#define AR_UTF8             0
+#define AR_DICTIONARY       1   /* UTF-8 strings, as int32 indices into a dictionary */
+#define AR_UINT64           2
+#define AR_FLOAT64          3
+#define AR_DATE32           4   /* Days since 1970-01-01 */
+
+typedef struct tArrowField {
+    const char *sName;
+    int iType;
+} ar_field;
+
+/* A growing run of bytes */
+typedef struct tArrowBuffer {
+    unsigned char *sData;
+    size_t lLen;
+    size_t lSize;
+} ar_buffer;
+
+typedef struct tArrowColumn {
+    char *sName;
+    int iType;
+    ar_buffer tValid;       /* Validity bitmap */
+    ar_buffer tOffsets;     /* int32 offsets of UTF-8 values into tValues */
+    ar_buffer tValues;      /* Values, UTF-8 bytes or dictionary indices */
+    unsigned long lNullNum;
+    /* Dictionary of an AR_DICTIONARY column, kept for the whole file */
+    ar_buffer tDictOffsets;
+    ar_buffer tDictValues;
+    int *aiDictSlots;       /* Hash table of indices into the dictionary, -1 when free */
+    size_t lDictSlotNum;
+    long lDictNum;
+} ar_column;
+
+/* Block of the file footer, where a message starts and how long it is */
+typedef struct tArrowBlock {
+    unsigned long long lOffset;
+    unsigned int iMetaLen;
+    unsigned long long lBodyLen;
+} ar_block;
+
+/* An Arrow IPC file (Feather v2) being written, one record batch of rows at
+   a time. Only the rows of the current batch and the dictionaries are held */
+typedef struct tArrowFile {
+    FILE *fOut;
+    unsigned long long lOffset; /* Bytes written so far */
+    ar_column *ptColumns;
+    int iColumnNum;
+    unsigned long lRowNum;      /* Rows of the current batch */
+    size_t lBatchLen;
+    ar_block *ptDicts;
+    size_t lDictNum;
+    size_t lDictMem;
+    ar_block *ptBatches;
+    size_t lBatchNum;
+    size_t lBatchMem;
+    int iError;
+} ar_file;
+
+ar_file *openArrow(FILE *fOut, const ar_field *ptFields, int iFieldNum);
+void putArrowNull(ar_file *ptArrow, int iColumn);
+void putArrowString(ar_file *ptArrow, int iColumn, const char *sStr, size_t lLen);
+void putArrowUInt(ar_file *ptArrow, int iColumn, unsigned long long lValue);
+void putArrowDouble(ar_file *ptArrow, int iColumn, double dValue);
+void putArrowDate(ar_file *ptArrow, int iColumn, long lDays);
+void endArrowRow(ar_file *ptArrow);
+int closeArrow(ar_file *ptArrow);
+
+#endif
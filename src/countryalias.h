@@ -0,0 +1,1373 @@
+/* Generated by countryalias.py from countrycodes.h, do not edit */
+
+#define ALIASNUM 851
+#define ALIASSLOTBITS 11
+#define ALIASBUCKETNUM 512
+#define ALIASLEN 44
+#define FUZZYNUM 360
+#define BIGRAMBITS 10
+
+/* Names, ISO3 and ISO2 codes and aliases in lower case, with their index into country[] */
+static const struct tAlias {
+    const char *sKey;
+    short iCountry;
+    short iLen;
+} atAliases[ALIASNUM] = {
+    /* Names */
+    {"afghanistan", 0, 11}, /* Afghanistan */
+    {"aland islands", 1, 13}, /* Aland Islands */
+    {"albania", 2, 7}, /* Albania */
+    {"algeria", 3, 7}, /* Algeria */
+    {"american samoa", 4, 14}, /* American Samoa */
+    {"andorra", 5, 7}, /* Andorra */
+    {"angola", 6, 6}, /* Angola */
+    {"anguilla", 7, 8}, /* Anguilla */
+    {"antarctica", 8, 10}, /* Antarctica */
+    {"antigua and barbuda", 9, 19}, /* Antigua and Barbuda */
+    {"argentina", 10, 9}, /* Argentina */
+    {"armenia", 11, 7}, /* Armenia */
+    {"aruba", 12, 5}, /* Aruba */
+    {"australia", 13, 9}, /* Australia */
+    {"austria", 14, 7}, /* Austria */
+    {"azerbaijan", 15, 10}, /* Azerbaijan */
+    {"bahamas", 16, 7}, /* Bahamas */
+    {"bahrain", 17, 7}, /* Bahrain */
+    {"bangladesh", 18, 10}, /* Bangladesh */
+    {"barbados", 19, 8}, /* Barbados */
+    {"belarus", 20, 7}, /* Belarus */
+    {"belgium", 21, 7}, /* Belgium */
+    {"belize", 22, 6}, /* Belize */
+    {"benin", 23, 5}, /* Benin */
+    {"bermuda", 24, 7}, /* Bermuda */
+    {"bhutan", 25, 6}, /* Bhutan */
+    {"bolivia", 26, 7}, /* Bolivia */
+    {"bosnia and herzegovina", 27, 22}, /* Bosnia and Herzegovina */
+    {"botswana", 28, 8}, /* Botswana */
+    {"bouvet island", 29, 13}, /* Bouvet Island */
+    {"brazil", 30, 6}, /* Brazil */
+    {"british indian ocean territory", 31, 30}, /* British Indian Ocean Territory */
+    {"british virgin islands", 32, 22}, /* British Virgin Islands */
+    {"brunei darussalam", 33, 17}, /* Brunei Darussalam */
+    {"bulgaria", 34, 8}, /* Bulgaria */
+    {"burkina faso", 35, 12}, /* Burkina Faso */
+    {"burundi", 36, 7}, /* Burundi */
+    {"cambodia", 37, 8}, /* Cambodia */
+    {"cameroon", 38, 8}, /* Cameroon */
+    {"canada", 39, 6}, /* Canada */
+    {"cape verde", 40, 10}, /* Cape Verde */
+    {"cayman islands", 41, 14}, /* Cayman Islands */
+    {"central african republic", 42, 24}, /* Central African Republic */
+    {"chad", 43, 4}, /* Chad */
+    {"chile", 44, 5}, /* Chile */
+    {"china", 45, 5}, /* China */
+    {"christmas island", 46, 16}, /* Christmas Island */
+    {"cocos (keeling) islands", 47, 23}, /* Cocos (Keeling) Islands */
+    {"colombia", 48, 8}, /* Colombia */
+    {"comoros", 49, 7}, /* Comoros */
+    {"congo (brazzaville)", 50, 19}, /* Congo (Brazzaville) */
+    {"democratic republic of the congo", 51, 32}, /* Democratic Republic of the Congo */
+    {"cook islands", 52, 12}, /* Cook Islands */
+    {"costa rica", 53, 10}, /* Costa Rica */
+    {"croatia", 54, 7}, /* Croatia */
+    {"cuba", 55, 4}, /* Cuba */
+    {"cyprus", 56, 6}, /* Cyprus */
+    {"czech republic", 57, 14}, /* Czech Republic */
+    {"côte d'ivoire", 58, 14}, /* Côte d'Ivoire */
+    {"denmark", 59, 7}, /* Denmark */
+    {"djibouti", 60, 8}, /* Djibouti */
+    {"dominica", 61, 8}, /* Dominica */
+    {"dominican republic", 62, 18}, /* Dominican Republic */
+    {"ecuador", 63, 7}, /* Ecuador */
+    {"egypt", 64, 5}, /* Egypt */
+    {"el salvador", 65, 11}, /* El Salvador */
+    {"equatorial guinea", 66, 17}, /* Equatorial Guinea */
+    {"eritrea", 67, 7}, /* Eritrea */
+    {"estonia", 68, 7}, /* Estonia */
+    {"ethiopia", 69, 8}, /* Ethiopia */
+    {"falkland islands (malvinas)", 70, 27}, /* Falkland Islands (Malvinas) */
+    {"faroe islands", 71, 13}, /* Faroe Islands */
+    {"fiji", 72, 4}, /* Fiji */
+    {"finland", 73, 7}, /* Finland */
+    {"france", 74, 6}, /* France */
+    {"french guiana", 75, 13}, /* French Guiana */
+    {"french polynesia", 76, 16}, /* French Polynesia */
+    {"french southern territories", 77, 27}, /* French Southern Territories */
+    {"gabon", 78, 5}, /* Gabon */
+    {"gambia", 79, 6}, /* Gambia */
+    {"georgia", 80, 7}, /* Georgia */
+    {"germany", 81, 7}, /* Germany */
+    {"ghana", 82, 5}, /* Ghana */
+    {"gibraltar", 83, 9}, /* Gibraltar */
+    {"greece", 84, 6}, /* Greece */
+    {"greenland", 85, 9}, /* Greenland */
+    {"grenada", 86, 7}, /* Grenada */
+    {"guadeloupe", 87, 10}, /* Guadeloupe */
+    {"guam", 88, 4}, /* Guam */
+    {"guatemala", 89, 9}, /* Guatemala */
+    {"guernsey", 90, 8}, /* Guernsey */
+    {"guinea", 91, 6}, /* Guinea */
+    {"guinea-bissau", 92, 13}, /* Guinea-Bissau */
+    {"guyana", 93, 6}, /* Guyana */
+    {"haiti", 94, 5}, /* Haiti */
+    {"heard and mcdonald islands", 95, 26}, /* Heard and Mcdonald Islands */
+    {"holy see (vatican city state)", 96, 29}, /* Holy See (Vatican City State) */
+    {"honduras", 97, 8}, /* Honduras */
+    {"hong kong, sar china", 98, 20}, /* Hong Kong, SAR China */
+    {"hungary", 99, 7}, /* Hungary */
+    {"iceland", 100, 7}, /* Iceland */
+    {"india", 101, 5}, /* India */
+    {"indonesia", 102, 9}, /* Indonesia */
+    {"iran, islamic republic of", 103, 25}, /* Iran, Islamic Republic of */
+    {"iraq", 104, 4}, /* Iraq */
+    {"ireland", 105, 7}, /* Ireland */
+    {"isle of man", 106, 11}, /* Isle of Man */
+    {"israel", 107, 6}, /* Israel */
+    {"italy", 108, 5}, /* Italy */
+    {"jamaica", 109, 7}, /* Jamaica */
+    {"japan", 110, 5}, /* Japan */
+    {"jersey", 111, 6}, /* Jersey */
+    {"jordan", 112, 6}, /* Jordan */
+    {"kazakhstan", 113, 10}, /* Kazakhstan */
+    {"kenya", 114, 5}, /* Kenya */
+    {"kiribati", 115, 8}, /* Kiribati */
+    {"korea (north)", 116, 13}, /* Korea (North) */
+    {"korea (south)", 117, 13}, /* Korea (South) */
+    {"kuwait", 118, 6}, /* Kuwait */
+    {"kyrgyzstan", 119, 10}, /* Kyrgyzstan */
+    {"lao pdr", 120, 7}, /* Lao PDR */
+    {"latvia", 121, 6}, /* Latvia */
+    {"lebanon", 122, 7}, /* Lebanon */
+    {"lesotho", 123, 7}, /* Lesotho */
+    {"liberia", 124, 7}, /* Liberia */
+    {"libya", 125, 5}, /* Libya */
+    {"liechtenstein", 126, 13}, /* Liechtenstein */
+    {"lithuania", 127, 9}, /* Lithuania */
+    {"luxembourg", 128, 10}, /* Luxembourg */
+    {"macao, sar china", 129, 16}, /* Macao, SAR China */
+    {"macedonia, republic of", 130, 22}, /* Macedonia, Republic of */
+    {"madagascar", 131, 10}, /* Madagascar */
+    {"malawi", 132, 6}, /* Malawi */
+    {"malaysia", 133, 8}, /* Malaysia */
+    {"maldives", 134, 8}, /* Maldives */
+    {"mali", 135, 4}, /* Mali */
+    {"malta", 136, 5}, /* Malta */
+    {"marshall islands", 137, 16}, /* Marshall Islands */
+    {"martinique", 138, 10}, /* Martinique */
+    {"mauritania", 139, 10}, /* Mauritania */
+    {"mauritius", 140, 9}, /* Mauritius */
+    {"mayotte", 141, 7}, /* Mayotte */
+    {"mexico", 142, 6}, /* Mexico */
+    {"micronesia, federated states of", 143, 31}, /* Micronesia, Federated States of */
+    {"moldova", 144, 7}, /* Moldova */
+    {"monaco", 145, 6}, /* Monaco */
+    {"mongolia", 146, 8}, /* Mongolia */
+    {"montenegro", 147, 10}, /* Montenegro */
+    {"montserrat", 148, 10}, /* Montserrat */
+    {"morocco", 149, 7}, /* Morocco */
+    {"mozambique", 150, 10}, /* Mozambique */
+    {"myanmar", 151, 7}, /* Myanmar */
+    {"namibia", 152, 7}, /* Namibia */
+    {"nauru", 153, 5}, /* Nauru */
+    {"nepal", 154, 5}, /* Nepal */
+    {"netherlands", 155, 11}, /* Netherlands */
+    {"netherlands antilles", 156, 20}, /* Netherlands Antilles */
+    {"new caledonia", 157, 13}, /* New Caledonia */
+    {"new zealand", 158, 11}, /* New Zealand */
+    {"nicaragua", 159, 9}, /* Nicaragua */
+    {"niger", 160, 5}, /* Niger */
+    {"nigeria", 161, 7}, /* Nigeria */
+    {"niue", 162, 4}, /* Niue */
+    {"norfolk island", 163, 14}, /* Norfolk Island */
+    {"northern mariana islands", 164, 24}, /* Northern Mariana Islands */
+    {"norway", 165, 6}, /* Norway */
+    {"oman", 166, 4}, /* Oman */
+    {"pakistan", 167, 8}, /* Pakistan */
+    {"palau", 168, 5}, /* Palau */
+    {"palestinian territory", 169, 21}, /* Palestinian Territory */
+    {"panama", 170, 6}, /* Panama */
+    {"papua new guinea", 171, 16}, /* Papua New Guinea */
+    {"paraguay", 172, 8}, /* Paraguay */
+    {"peru", 173, 4}, /* Peru */
+    {"philippines", 174, 11}, /* Philippines */
+    {"pitcairn", 175, 8}, /* Pitcairn */
+    {"poland", 176, 6}, /* Poland */
+    {"portugal", 177, 8}, /* Portugal */
+    {"puerto rico", 178, 11}, /* Puerto Rico */
+    {"qatar", 179, 5}, /* Qatar */
+    {"romania", 180, 7}, /* Romania */
+    {"russian federation", 181, 18}, /* Russian Federation */
+    {"rwanda", 182, 6}, /* Rwanda */
+    {"réunion", 183, 8}, /* Réunion */
+    {"saint helena", 184, 12}, /* Saint Helena */
+    {"saint kitts and nevis", 185, 21}, /* Saint Kitts and Nevis */
+    {"saint lucia", 186, 11}, /* Saint Lucia */
+    {"saint pierre and miquelon", 187, 25}, /* Saint Pierre and Miquelon */
+    {"saint vincent and grenadines", 188, 28}, /* Saint Vincent and Grenadines */
+    {"saint-barthélemy", 189, 17}, /* Saint-Barthélemy */
+    {"saint-martin (french part)", 190, 26}, /* Saint-Martin (French part) */
+    {"samoa", 191, 5}, /* Samoa */
+    {"san marino", 192, 10}, /* San Marino */
+    {"sao tome and principe", 193, 21}, /* Sao Tome and Principe */
+    {"saudi arabia", 194, 12}, /* Saudi Arabia */
+    {"senegal", 195, 7}, /* Senegal */
+    {"serbia", 196, 6}, /* Serbia */
+    {"seychelles", 197, 10}, /* Seychelles */
+    {"sierra leone", 198, 12}, /* Sierra Leone */
+    {"singapore", 199, 9}, /* Singapore */
+    {"slovakia", 200, 8}, /* Slovakia */
+    {"slovenia", 201, 8}, /* Slovenia */
+    {"solomon islands", 202, 15}, /* Solomon Islands */
+    {"somalia", 203, 7}, /* Somalia */
+    {"south africa", 204, 12}, /* South Africa */
+    {"south georgia and the south sandwich islands", 205, 44}, /* South Georgia and the South Sandwich Islands */
+    {"south sudan", 206, 11}, /* South Sudan */
+    {"spain", 207, 5}, /* Spain */
+    {"sri lanka", 208, 9}, /* Sri Lanka */
+    {"sudan", 209, 5}, /* Sudan */
+    {"suriname", 210, 8}, /* Suriname */
+    {"svalbard and jan mayen islands", 211, 30}, /* Svalbard and Jan Mayen Islands */
+    {"swaziland", 212, 9}, /* Swaziland */
+    {"sweden", 213, 6}, /* Sweden */
+    {"switzerland", 214, 11}, /* Switzerland */
+    {"syrian arab republic (syria)", 215, 28}, /* Syrian Arab Republic (Syria) */
+    {"taiwan, republic of china", 216, 25}, /* Taiwan, Republic of China */
+    {"tajikistan", 217, 10}, /* Tajikistan */
+    {"tanzania, united republic of", 218, 28}, /* Tanzania, United Republic of */
+    {"thailand", 219, 8}, /* Thailand */
+    {"timor-leste", 220, 11}, /* Timor-Leste */
+    {"togo", 221, 4}, /* Togo */
+    {"tokelau", 222, 7}, /* Tokelau */
+    {"tonga", 223, 5}, /* Tonga */
+    {"trinidad and tobago", 224, 19}, /* Trinidad and Tobago */
+    {"tunisia", 225, 7}, /* Tunisia */
+    {"turkey", 226, 6}, /* Turkey */
+    {"turkmenistan", 227, 12}, /* Turkmenistan */
+    {"turks and caicos islands", 228, 24}, /* Turks and Caicos Islands */
+    {"tuvalu", 229, 6}, /* Tuvalu */
+    {"uganda", 230, 6}, /* Uganda */
+    {"ukraine", 231, 7}, /* Ukraine */
+    {"united arab emirates", 232, 20}, /* United Arab Emirates */
+    {"united kingdom", 233, 14}, /* United Kingdom */
+    {"united states of america", 234, 24}, /* United States of America */
+    {"uruguay", 235, 7}, /* Uruguay */
+    {"us minor outlying islands", 236, 25}, /* US Minor Outlying Islands */
+    {"uzbekistan", 237, 10}, /* Uzbekistan */
+    {"vanuatu", 238, 7}, /* Vanuatu */
+    {"venezuela (bolivarian republic)", 239, 31}, /* Venezuela (Bolivarian Republic) */
+    {"viet nam", 240, 8}, /* Viet Nam */
+    {"virgin islands, us", 241, 18}, /* Virgin Islands, US */
+    {"wallis and futuna islands", 242, 25}, /* Wallis and Futuna Islands */
+    {"western sahara", 243, 14}, /* Western Sahara */
+    {"yemen", 244, 5}, /* Yemen */
+    {"zambia", 245, 6}, /* Zambia */
+    {"zimbabwe", 246, 8}, /* Zimbabwe */
+    {"usa", 247, 3}, /* USA */
+    {"us", 248, 2}, /* US */
+    {"south korea", 249, 11}, /* South Korea */
+    {"north korea", 250, 11}, /* North Korea */
+    {"venezuela", 251, 9}, /* Venezuela */
+    {"drc", 252, 3}, /* DRC */
+    /* ISO 3166 alpha-3 codes */
+    {"afg", 0, 3}, /* Afghanistan */
+    {"ala", 1, 3}, /* Aland Islands */
+    {"alb", 2, 3}, /* Albania */
+    {"dza", 3, 3}, /* Algeria */
+    {"asm", 4, 3}, /* American Samoa */
+    {"and", 5, 3}, /* Andorra */
+    {"ago", 6, 3}, /* Angola */
+    {"aia", 7, 3}, /* Anguilla */
+    {"ata", 8, 3}, /* Antarctica */
+    {"atg", 9, 3}, /* Antigua and Barbuda */
+    {"arg", 10, 3}, /* Argentina */
+    {"arm", 11, 3}, /* Armenia */
+    {"abw", 12, 3}, /* Aruba */
+    {"aus", 13, 3}, /* Australia */
+    {"aut", 14, 3}, /* Austria */
+    {"aze", 15, 3}, /* Azerbaijan */
+    {"bhs", 16, 3}, /* Bahamas */
+    {"bhr", 17, 3}, /* Bahrain */
+    {"bgd", 18, 3}, /* Bangladesh */
+    {"brb", 19, 3}, /* Barbados */
+    {"blr", 20, 3}, /* Belarus */
+    {"bel", 21, 3}, /* Belgium */
+    {"blz", 22, 3}, /* Belize */
+    {"ben", 23, 3}, /* Benin */
+    {"bmu", 24, 3}, /* Bermuda */
+    {"btn", 25, 3}, /* Bhutan */
+    {"bol", 26, 3}, /* Bolivia */
+    {"bih", 27, 3}, /* Bosnia and Herzegovina */
+    {"bwa", 28, 3}, /* Botswana */
+    {"bvt", 29, 3}, /* Bouvet Island */
+    {"bra", 30, 3}, /* Brazil */
+    {"iot", 31, 3}, /* British Indian Ocean Territory */
+    {"vgb", 32, 3}, /* British Virgin Islands */
+    {"brn", 33, 3}, /* Brunei Darussalam */
+    {"bgr", 34, 3}, /* Bulgaria */
+    {"bfa", 35, 3}, /* Burkina Faso */
+    {"bdi", 36, 3}, /* Burundi */
+    {"khm", 37, 3}, /* Cambodia */
+    {"cmr", 38, 3}, /* Cameroon */
+    {"can", 39, 3}, /* Canada */
+    {"cpv", 40, 3}, /* Cape Verde */
+    {"cym", 41, 3}, /* Cayman Islands */
+    {"caf", 42, 3}, /* Central African Republic */
+    {"tcd", 43, 3}, /* Chad */
+    {"chl", 44, 3}, /* Chile */
+    {"chn", 45, 3}, /* China */
+    {"cxr", 46, 3}, /* Christmas Island */
+    {"cck", 47, 3}, /* Cocos (Keeling) Islands */
+    {"col", 48, 3}, /* Colombia */
+    {"com", 49, 3}, /* Comoros */
+    {"cog", 50, 3}, /* Congo (Brazzaville) */
+    {"cod", 51, 3}, /* Democratic Republic of the Congo */
+    {"cok", 52, 3}, /* Cook Islands */
+    {"cri", 53, 3}, /* Costa Rica */
+    {"hrv", 54, 3}, /* Croatia */
+    {"cub", 55, 3}, /* Cuba */
+    {"cyp", 56, 3}, /* Cyprus */
+    {"cze", 57, 3}, /* Czech Republic */
+    {"civ", 58, 3}, /* Côte d'Ivoire */
+    {"dnk", 59, 3}, /* Denmark */
+    {"dji", 60, 3}, /* Djibouti */
+    {"dma", 61, 3}, /* Dominica */
+    {"dom", 62, 3}, /* Dominican Republic */
+    {"ecu", 63, 3}, /* Ecuador */
+    {"egy", 64, 3}, /* Egypt */
+    {"slv", 65, 3}, /* El Salvador */
+    {"gnq", 66, 3}, /* Equatorial Guinea */
+    {"eri", 67, 3}, /* Eritrea */
+    {"est", 68, 3}, /* Estonia */
+    {"eth", 69, 3}, /* Ethiopia */
+    {"flk", 70, 3}, /* Falkland Islands (Malvinas) */
+    {"fro", 71, 3}, /* Faroe Islands */
+    {"fji", 72, 3}, /* Fiji */
+    {"fin", 73, 3}, /* Finland */
+    {"fra", 74, 3}, /* France */
+    {"guf", 75, 3}, /* French Guiana */
+    {"pyf", 76, 3}, /* French Polynesia */
+    {"atf", 77, 3}, /* French Southern Territories */
+    {"gab", 78, 3}, /* Gabon */
+    {"gmb", 79, 3}, /* Gambia */
+    {"geo", 80, 3}, /* Georgia */
+    {"deu", 81, 3}, /* Germany */
+    {"gha", 82, 3}, /* Ghana */
+    {"gib", 83, 3}, /* Gibraltar */
+    {"grc", 84, 3}, /* Greece */
+    {"grl", 85, 3}, /* Greenland */
+    {"grd", 86, 3}, /* Grenada */
+    {"glp", 87, 3}, /* Guadeloupe */
+    {"gum", 88, 3}, /* Guam */
+    {"gtm", 89, 3}, /* Guatemala */
+    {"ggy", 90, 3}, /* Guernsey */
+    {"gin", 91, 3}, /* Guinea */
+    {"gnb", 92, 3}, /* Guinea-Bissau */
+    {"guy", 93, 3}, /* Guyana */
+    {"hti", 94, 3}, /* Haiti */
+    {"hmd", 95, 3}, /* Heard and Mcdonald Islands */
+    {"vat", 96, 3}, /* Holy See (Vatican City State) */
+    {"hnd", 97, 3}, /* Honduras */
+    {"hkg", 98, 3}, /* Hong Kong, SAR China */
+    {"hun", 99, 3}, /* Hungary */
+    {"isl", 100, 3}, /* Iceland */
+    {"ind", 101, 3}, /* India */
+    {"idn", 102, 3}, /* Indonesia */
+    {"irn", 103, 3}, /* Iran, Islamic Republic of */
+    {"irq", 104, 3}, /* Iraq */
+    {"irl", 105, 3}, /* Ireland */
+    {"imn", 106, 3}, /* Isle of Man */
+    {"isr", 107, 3}, /* Israel */
+    {"ita", 108, 3}, /* Italy */
+    {"jam", 109, 3}, /* Jamaica */
+    {"jpn", 110, 3}, /* Japan */
+    {"jey", 111, 3}, /* Jersey */
+    {"jor", 112, 3}, /* Jordan */
+    {"kaz", 113, 3}, /* Kazakhstan */
+    {"ken", 114, 3}, /* Kenya */
+    {"kir", 115, 3}, /* Kiribati */
+    {"prk", 116, 3}, /* Korea (North) */
+    {"kor", 117, 3}, /* Korea (South) */
+    {"kwt", 118, 3}, /* Kuwait */
+    {"kgz", 119, 3}, /* Kyrgyzstan */
+    {"lao", 120, 3}, /* Lao PDR */
+    {"lva", 121, 3}, /* Latvia */
+    {"lbn", 122, 3}, /* Lebanon */
+    {"lso", 123, 3}, /* Lesotho */
+    {"lbr", 124, 3}, /* Liberia */
+    {"lby", 125, 3}, /* Libya */
+    {"lie", 126, 3}, /* Liechtenstein */
+    {"ltu", 127, 3}, /* Lithuania */
+    {"lux", 128, 3}, /* Luxembourg */
+    {"mac", 129, 3}, /* Macao, SAR China */
+    {"mkd", 130, 3}, /* Macedonia, Republic of */
+    {"mdg", 131, 3}, /* Madagascar */
+    {"mwi", 132, 3}, /* Malawi */
+    {"mys", 133, 3}, /* Malaysia */
+    {"mdv", 134, 3}, /* Maldives */
+    {"mli", 135, 3}, /* Mali */
+    {"mlt", 136, 3}, /* Malta */
+    {"mhl", 137, 3}, /* Marshall Islands */
+    {"mtq", 138, 3}, /* Martinique */
+    {"mrt", 139, 3}, /* Mauritania */
+    {"mus", 140, 3}, /* Mauritius */
+    {"myt", 141, 3}, /* Mayotte */
+    {"mex", 142, 3}, /* Mexico */
+    {"fsm", 143, 3}, /* Micronesia, Federated States of */
+    {"mda", 144, 3}, /* Moldova */
+    {"mco", 145, 3}, /* Monaco */
+    {"mng", 146, 3}, /* Mongolia */
+    {"mne", 147, 3}, /* Montenegro */
+    {"msr", 148, 3}, /* Montserrat */
+    {"mar", 149, 3}, /* Morocco */
+    {"moz", 150, 3}, /* Mozambique */
+    {"mmr", 151, 3}, /* Myanmar */
+    {"nam", 152, 3}, /* Namibia */
+    {"nru", 153, 3}, /* Nauru */
+    {"npl", 154, 3}, /* Nepal */
+    {"nld", 155, 3}, /* Netherlands */
+    {"ant", 156, 3}, /* Netherlands Antilles */
+    {"ncl", 157, 3}, /* New Caledonia */
+    {"nzl", 158, 3}, /* New Zealand */
+    {"nic", 159, 3}, /* Nicaragua */
+    {"ner", 160, 3}, /* Niger */
+    {"nga", 161, 3}, /* Nigeria */
+    {"niu", 162, 3}, /* Niue */
+    {"nfk", 163, 3}, /* Norfolk Island */
+    {"mnp", 164, 3}, /* Northern Mariana Islands */
+    {"nor", 165, 3}, /* Norway */
+    {"omn", 166, 3}, /* Oman */
+    {"pak", 167, 3}, /* Pakistan */
+    {"plw", 168, 3}, /* Palau */
+    {"pse", 169, 3}, /* Palestinian Territory */
+    {"pan", 170, 3}, /* Panama */
+    {"png", 171, 3}, /* Papua New Guinea */
+    {"pry", 172, 3}, /* Paraguay */
+    {"per", 173, 3}, /* Peru */
+    {"phl", 174, 3}, /* Philippines */
+    {"pcn", 175, 3}, /* Pitcairn */
+    {"pol", 176, 3}, /* Poland */
+    {"prt", 177, 3}, /* Portugal */
+    {"pri", 178, 3}, /* Puerto Rico */
+    {"qat", 179, 3}, /* Qatar */
+    {"rou", 180, 3}, /* Romania */
+    {"rus", 181, 3}, /* Russian Federation */
+    {"rwa", 182, 3}, /* Rwanda */
+    {"reu", 183, 3}, /* Réunion */
+    {"shn", 184, 3}, /* Saint Helena */
+    {"kna", 185, 3}, /* Saint Kitts and Nevis */
+    {"lca", 186, 3}, /* Saint Lucia */
+    {"spm", 187, 3}, /* Saint Pierre and Miquelon */
+    {"vct", 188, 3}, /* Saint Vincent and Grenadines */
+    {"blm", 189, 3}, /* Saint-Barthélemy */
+    {"maf", 190, 3}, /* Saint-Martin (French part) */
+    {"wsm", 191, 3}, /* Samoa */
+    {"smr", 192, 3}, /* San Marino */
+    {"stp", 193, 3}, /* Sao Tome and Principe */
+    {"sau", 194, 3}, /* Saudi Arabia */
+    {"sen", 195, 3}, /* Senegal */
+    {"srb", 196, 3}, /* Serbia */
+    {"syc", 197, 3}, /* Seychelles */
+    {"sle", 198, 3}, /* Sierra Leone */
+    {"sgp", 199, 3}, /* Singapore */
+    {"svk", 200, 3}, /* Slovakia */
+    {"svn", 201, 3}, /* Slovenia */
+    {"slb", 202, 3}, /* Solomon Islands */
+    {"som", 203, 3}, /* Somalia */
+    {"zaf", 204, 3}, /* South Africa */
+    {"sgs", 205, 3}, /* South Georgia and the South Sandwich Islands */
+    {"ssd", 206, 3}, /* South Sudan */
+    {"esp", 207, 3}, /* Spain */
+    {"lka", 208, 3}, /* Sri Lanka */
+    {"sdn", 209, 3}, /* Sudan */
+    {"sur", 210, 3}, /* Suriname */
+    {"sjm", 211, 3}, /* Svalbard and Jan Mayen Islands */
+    {"swz", 212, 3}, /* Swaziland */
+    {"swe", 213, 3}, /* Sweden */
+    {"che", 214, 3}, /* Switzerland */
+    {"syr", 215, 3}, /* Syrian Arab Republic (Syria) */
+    {"twn", 216, 3}, /* Taiwan, Republic of China */
+    {"tjk", 217, 3}, /* Tajikistan */
+    {"tza", 218, 3}, /* Tanzania, United Republic of */
+    {"tha", 219, 3}, /* Thailand */
+    {"tls", 220, 3}, /* Timor-Leste */
+    {"tgo", 221, 3}, /* Togo */
+    {"tkl", 222, 3}, /* Tokelau */
+    {"ton", 223, 3}, /* Tonga */
+    {"tto", 224, 3}, /* Trinidad and Tobago */
+    {"tun", 225, 3}, /* Tunisia */
+    {"tur", 226, 3}, /* Turkey */
+    {"tkm", 227, 3}, /* Turkmenistan */
+    {"tca", 228, 3}, /* Turks and Caicos Islands */
+    {"tuv", 229, 3}, /* Tuvalu */
+    {"uga", 230, 3}, /* Uganda */
+    {"ukr", 231, 3}, /* Ukraine */
+    {"are", 232, 3}, /* United Arab Emirates */
+    {"gbr", 233, 3}, /* United Kingdom */
+    {"ury", 235, 3}, /* Uruguay */
+    {"umi", 236, 3}, /* US Minor Outlying Islands */
+    {"uzb", 237, 3}, /* Uzbekistan */
+    {"vut", 238, 3}, /* Vanuatu */
+    {"ven", 239, 3}, /* Venezuela (Bolivarian Republic) */
+    {"vnm", 240, 3}, /* Viet Nam */
+    {"vir", 241, 3}, /* Virgin Islands, US */
+    {"wlf", 242, 3}, /* Wallis and Futuna Islands */
+    {"esh", 243, 3}, /* Western Sahara */
+    {"yem", 244, 3}, /* Yemen */
+    {"zmb", 245, 3}, /* Zambia */
+    {"zwe", 246, 3}, /* Zimbabwe */
+    /* ISO 3166 alpha-2 codes */
+    {"af", 0, 2}, /* Afghanistan */
+    {"ax", 1, 2}, /* Aland Islands */
+    {"al", 2, 2}, /* Albania */
+    {"dz", 3, 2}, /* Algeria */
+    {"as", 4, 2}, /* American Samoa */
+    {"ad", 5, 2}, /* Andorra */
+    {"ao", 6, 2}, /* Angola */
+    {"ai", 7, 2}, /* Anguilla */
+    {"aq", 8, 2}, /* Antarctica */
+    {"ag", 9, 2}, /* Antigua and Barbuda */
+    {"ar", 10, 2}, /* Argentina */
+    {"am", 11, 2}, /* Armenia */
+    {"aw", 12, 2}, /* Aruba */
+    {"au", 13, 2}, /* Australia */
+    {"at", 14, 2}, /* Austria */
+    {"az", 15, 2}, /* Azerbaijan */
+    {"bs", 16, 2}, /* Bahamas */
+    {"bh", 17, 2}, /* Bahrain */
+    {"bd", 18, 2}, /* Bangladesh */
+    {"bb", 19, 2}, /* Barbados */
+    {"by", 20, 2}, /* Belarus */
+    {"be", 21, 2}, /* Belgium */
+    {"bz", 22, 2}, /* Belize */
+    {"bj", 23, 2}, /* Benin */
+    {"bm", 24, 2}, /* Bermuda */
+    {"bt", 25, 2}, /* Bhutan */
+    {"bo", 26, 2}, /* Bolivia */
+    {"ba", 27, 2}, /* Bosnia and Herzegovina */
+    {"bw", 28, 2}, /* Botswana */
+    {"bv", 29, 2}, /* Bouvet Island */
+    {"br", 30, 2}, /* Brazil */
+    {"io", 31, 2}, /* British Indian Ocean Territory */
+    {"vg", 32, 2}, /* British Virgin Islands */
+    {"bn", 33, 2}, /* Brunei Darussalam */
+    {"bg", 34, 2}, /* Bulgaria */
+    {"bf", 35, 2}, /* Burkina Faso */
+    {"bi", 36, 2}, /* Burundi */
+    {"kh", 37, 2}, /* Cambodia */
+    {"cm", 38, 2}, /* Cameroon */
+    {"ca", 39, 2}, /* Canada */
+    {"cv", 40, 2}, /* Cape Verde */
+    {"ky", 41, 2}, /* Cayman Islands */
+    {"cf", 42, 2}, /* Central African Republic */
+    {"td", 43, 2}, /* Chad */
+    {"cl", 44, 2}, /* Chile */
+    {"cn", 45, 2}, /* China */
+    {"cx", 46, 2}, /* Christmas Island */
+    {"cc", 47, 2}, /* Cocos (Keeling) Islands */
+    {"co", 48, 2}, /* Colombia */
+    {"km", 49, 2}, /* Comoros */
+    {"cg", 50, 2}, /* Congo (Brazzaville) */
+    {"cd", 51, 2}, /* Democratic Republic of the Congo */
+    {"ck", 52, 2}, /* Cook Islands */
+    {"cr", 53, 2}, /* Costa Rica */
+    {"hr", 54, 2}, /* Croatia */
+    {"cu", 55, 2}, /* Cuba */
+    {"cy", 56, 2}, /* Cyprus */
+    {"cz", 57, 2}, /* Czech Republic */
+    {"ci", 58, 2}, /* Côte d'Ivoire */
+    {"dk", 59, 2}, /* Denmark */
+    {"dj", 60, 2}, /* Djibouti */
+    {"dm", 61, 2}, /* Dominica */
+    {"do", 62, 2}, /* Dominican Republic */
+    {"ec", 63, 2}, /* Ecuador */
+    {"eg", 64, 2}, /* Egypt */
+    {"sv", 65, 2}, /* El Salvador */
+    {"gq", 66, 2}, /* Equatorial Guinea */
+    {"er", 67, 2}, /* Eritrea */
+    {"ee", 68, 2}, /* Estonia */
+    {"et", 69, 2}, /* Ethiopia */
+    {"fk", 70, 2}, /* Falkland Islands (Malvinas) */
+    {"fo", 71, 2}, /* Faroe Islands */
+    {"fj", 72, 2}, /* Fiji */
+    {"fi", 73, 2}, /* Finland */
+    {"fr", 74, 2}, /* France */
+    {"gf", 75, 2}, /* French Guiana */
+    {"pf", 76, 2}, /* French Polynesia */
+    {"tf", 77, 2}, /* French Southern Territories */
+    {"ga", 78, 2}, /* Gabon */
+    {"gm", 79, 2}, /* Gambia */
+    {"ge", 80, 2}, /* Georgia */
+    {"de", 81, 2}, /* Germany */
+    {"gh", 82, 2}, /* Ghana */
+    {"gi", 83, 2}, /* Gibraltar */
+    {"gr", 84, 2}, /* Greece */
+    {"gl", 85, 2}, /* Greenland */
+    {"gd", 86, 2}, /* Grenada */
+    {"gp", 87, 2}, /* Guadeloupe */
+    {"gu", 88, 2}, /* Guam */
+    {"gt", 89, 2}, /* Guatemala */
+    {"gg", 90, 2}, /* Guernsey */
+    {"gn", 91, 2}, /* Guinea */
+    {"gw", 92, 2}, /* Guinea-Bissau */
+    {"gy", 93, 2}, /* Guyana */
+    {"ht", 94, 2}, /* Haiti */
+    {"hm", 95, 2}, /* Heard and Mcdonald Islands */
+    {"va", 96, 2}, /* Holy See (Vatican City State) */
+    {"hn", 97, 2}, /* Honduras */
+    {"hk", 98, 2}, /* Hong Kong, SAR China */
+    {"hu", 99, 2}, /* Hungary */
+    {"is", 100, 2}, /* Iceland */
+    {"in", 101, 2}, /* India */
+    {"id", 102, 2}, /* Indonesia */
+    {"ir", 103, 2}, /* Iran, Islamic Republic of */
+    {"iq", 104, 2}, /* Iraq */
+    {"ie", 105, 2}, /* Ireland */
+    {"im", 106, 2}, /* Isle of Man */
+    {"il", 107, 2}, /* Israel */
+    {"it", 108, 2}, /* Italy */
+    {"jm", 109, 2}, /* Jamaica */
+    {"jp", 110, 2}, /* Japan */
+    {"je", 111, 2}, /* Jersey */
+    {"jo", 112, 2}, /* Jordan */
+    {"kz", 113, 2}, /* Kazakhstan */
+    {"ke", 114, 2}, /* Kenya */
+    {"ki", 115, 2}, /* Kiribati */
+    {"kp", 116, 2}, /* Korea (North) */
+    {"kr", 117, 2}, /* Korea (South) */
+    {"kw", 118, 2}, /* Kuwait */
+    {"kg", 119, 2}, /* Kyrgyzstan */
+    {"la", 120, 2}, /* Lao PDR */
+    {"lv", 121, 2}, /* Latvia */
+    {"lb", 122, 2}, /* Lebanon */
+    {"ls", 123, 2}, /* Lesotho */
+    {"lr", 124, 2}, /* Liberia */
+    {"ly", 125, 2}, /* Libya */
+    {"li", 126, 2}, /* Liechtenstein */
+    {"lt", 127, 2}, /* Lithuania */
+    {"lu", 128, 2}, /* Luxembourg */
+    {"mo", 129, 2}, /* Macao, SAR China */
+    {"mk", 130, 2}, /* Macedonia, Republic of */
+    {"mg", 131, 2}, /* Madagascar */
+    {"mw", 132, 2}, /* Malawi */
+    {"my", 133, 2}, /* Malaysia */
+    {"mv", 134, 2}, /* Maldives */
+    {"ml", 135, 2}, /* Mali */
+    {"mt", 136, 2}, /* Malta */
+    {"mh", 137, 2}, /* Marshall Islands */
+    {"mq", 138, 2}, /* Martinique */
+    {"mr", 139, 2}, /* Mauritania */
+    {"mu", 140, 2}, /* Mauritius */
+    {"yt", 141, 2}, /* Mayotte */
+    {"mx", 142, 2}, /* Mexico */
+    {"fm", 143, 2}, /* Micronesia, Federated States of */
+    {"md", 144, 2}, /* Moldova */
+    {"mc", 145, 2}, /* Monaco */
+    {"mn", 146, 2}, /* Mongolia */
+    {"me", 147, 2}, /* Montenegro */
+    {"ms", 148, 2}, /* Montserrat */
+    {"ma", 149, 2}, /* Morocco */
+    {"mz", 150, 2}, /* Mozambique */
+    {"mm", 151, 2}, /* Myanmar */
+    {"nr", 153, 2}, /* Nauru */
+    {"np", 154, 2}, /* Nepal */
+    {"nl", 155, 2}, /* Netherlands */
+    {"an", 156, 2}, /* Netherlands Antilles */
+    {"nc", 157, 2}, /* New Caledonia */
+    {"nz", 158, 2}, /* New Zealand */
+    {"ni", 159, 2}, /* Nicaragua */
+    {"ne", 160, 2}, /* Niger */
+    {"ng", 161, 2}, /* Nigeria */
+    {"nu", 162, 2}, /* Niue */
+    {"nf", 163, 2}, /* Norfolk Island */
+    {"mp", 164, 2}, /* Northern Mariana Islands */
+    {"no", 165, 2}, /* Norway */
+    {"om", 166, 2}, /* Oman */
+    {"pk", 167, 2}, /* Pakistan */
+    {"pw", 168, 2}, /* Palau */
+    {"ps", 169, 2}, /* Palestinian Territory */
+    {"pa", 170, 2}, /* Panama */
+    {"pg", 171, 2}, /* Papua New Guinea */
+    {"py", 172, 2}, /* Paraguay */
+    {"pe", 173, 2}, /* Peru */
+    {"ph", 174, 2}, /* Philippines */
+    {"pn", 175, 2}, /* Pitcairn */
+    {"pl", 176, 2}, /* Poland */
+    {"pt", 177, 2}, /* Portugal */
+    {"pr", 178, 2}, /* Puerto Rico */
+    {"qa", 179, 2}, /* Qatar */
+    {"ro", 180, 2}, /* Romania */
+    {"ru", 181, 2}, /* Russian Federation */
+    {"rw", 182, 2}, /* Rwanda */
+    {"re", 183, 2}, /* Réunion */
+    {"sh", 184, 2}, /* Saint Helena */
+    {"kn", 185, 2}, /* Saint Kitts and Nevis */
+    {"lc", 186, 2}, /* Saint Lucia */
+    {"pm", 187, 2}, /* Saint Pierre and Miquelon */
+    {"vc", 188, 2}, /* Saint Vincent and Grenadines */
+    {"bl", 189, 2}, /* Saint-Barthélemy */
+    {"mf", 190, 2}, /* Saint-Martin (French part) */
+    {"ws", 191, 2}, /* Samoa */
+    {"sm", 192, 2}, /* San Marino */
+    {"st", 193, 2}, /* Sao Tome and Principe */
+    {"sa", 194, 2}, /* Saudi Arabia */
+    {"sn", 195, 2}, /* Senegal */
+    {"rs", 196, 2}, /* Serbia */
+    {"sc", 197, 2}, /* Seychelles */
+    {"sl", 198, 2}, /* Sierra Leone */
+    {"sg", 199, 2}, /* Singapore */
+    {"sk", 200, 2}, /* Slovakia */
+    {"si", 201, 2}, /* Slovenia */
+    {"sb", 202, 2}, /* Solomon Islands */
+    {"so", 203, 2}, /* Somalia */
+    {"za", 204, 2}, /* South Africa */
+    {"gs", 205, 2}, /* South Georgia and the South Sandwich Islands */
+    {"ss", 206, 2}, /* South Sudan */
+    {"es", 207, 2}, /* Spain */
+    {"lk", 208, 2}, /* Sri Lanka */
+    {"sd", 209, 2}, /* Sudan */
+    {"sr", 210, 2}, /* Suriname */
+    {"sj", 211, 2}, /* Svalbard and Jan Mayen Islands */
+    {"sz", 212, 2}, /* Swaziland */
+    {"se", 213, 2}, /* Sweden */
+    {"ch", 214, 2}, /* Switzerland */
+    {"sy", 215, 2}, /* Syrian Arab Republic (Syria) */
+    {"tw", 216, 2}, /* Taiwan, Republic of China */
+    {"tj", 217, 2}, /* Tajikistan */
+    {"tz", 218, 2}, /* Tanzania, United Republic of */
+    {"th", 219, 2}, /* Thailand */
+    {"tl", 220, 2}, /* Timor-Leste */
+    {"tg", 221, 2}, /* Togo */
+    {"tk", 222, 2}, /* Tokelau */
+    {"to", 223, 2}, /* Tonga */
+    {"tt", 224, 2}, /* Trinidad and Tobago */
+    {"tn", 225, 2}, /* Tunisia */
+    {"tr", 226, 2}, /* Turkey */
+    {"tm", 227, 2}, /* Turkmenistan */
+    {"tc", 228, 2}, /* Turks and Caicos Islands */
+    {"tv", 229, 2}, /* Tuvalu */
+    {"ug", 230, 2}, /* Uganda */
+    {"ua", 231, 2}, /* Ukraine */
+    {"ae", 232, 2}, /* United Arab Emirates */
+    {"gb", 233, 2}, /* United Kingdom */
+    {"uy", 235, 2}, /* Uruguay */
+    {"um", 236, 2}, /* US Minor Outlying Islands */
+    {"uz", 237, 2}, /* Uzbekistan */
+    {"vu", 238, 2}, /* Vanuatu */
+    {"ve", 239, 2}, /* Venezuela (Bolivarian Republic) */
+    {"vn", 240, 2}, /* Viet Nam */
+    {"vi", 241, 2}, /* Virgin Islands, US */
+    {"wf", 242, 2}, /* Wallis and Futuna Islands */
+    {"eh", 243, 2}, /* Western Sahara */
+    {"ye", 244, 2}, /* Yemen */
+    {"zm", 245, 2}, /* Zambia */
+    {"zw", 246, 2}, /* Zimbabwe */
+    /* Aliases */
+    {"united states", 234, 13}, /* United States of America */
+    {"u.s.a.", 234, 6}, /* United States of America */
+    {"u.s.", 234, 4}, /* United States of America */
+    {"america", 234, 7}, /* United States of America */
+    {"uk", 233, 2}, /* United Kingdom */
+    {"u.k.", 233, 4}, /* United Kingdom */
+    {"great britain", 233, 13}, /* United Kingdom */
+    {"britain", 233, 7}, /* United Kingdom */
+    {"england", 233, 7}, /* United Kingdom */
+    {"scotland", 233, 8}, /* United Kingdom */
+    {"wales", 233, 5}, /* United Kingdom */
+    {"northern ireland", 233, 16}, /* United Kingdom */
+    {"russia", 181, 6}, /* Russian Federation */
+    {"korea, south", 117, 12}, /* Korea (South) */
+    {"republic of korea", 117, 17}, /* Korea (South) */
+    {"korea, republic of", 117, 18}, /* Korea (South) */
+    {"korea, north", 116, 12}, /* Korea (North) */
+    {"dprk", 116, 4}, /* Korea (North) */
+    {"democratic people's republic of korea", 116, 37}, /* Korea (North) */
+    {"korea, democratic people's republic of", 116, 38}, /* Korea (North) */
+    {"vietnam", 240, 7}, /* Viet Nam */
+    {"iran", 103, 4}, /* Iran, Islamic Republic of */
+    {"islamic republic of iran", 103, 24}, /* Iran, Islamic Republic of */
+    {"syria", 215, 5}, /* Syrian Arab Republic (Syria) */
+    {"syrian arab republic", 215, 20}, /* Syrian Arab Republic (Syria) */
+    {"laos", 120, 4}, /* Lao PDR */
+    {"lao people's democratic republic", 120, 32}, /* Lao PDR */
+    {"tanzania", 218, 8}, /* Tanzania, United Republic of */
+    {"united republic of tanzania", 218, 27}, /* Tanzania, United Republic of */
+    {"plurinational state of bolivia", 26, 30}, /* Bolivia */
+    {"bolivia, plurinational state of", 26, 31}, /* Bolivia */
+    {"bolivarian republic of venezuela", 239, 32}, /* Venezuela (Bolivarian Republic) */
+    {"venezuela, bolivarian republic of", 239, 33}, /* Venezuela (Bolivarian Republic) */
+    {"republic of moldova", 144, 19}, /* Moldova */
+    {"moldova, republic of", 144, 20}, /* Moldova */
+    {"macedonia", 130, 9}, /* Macedonia, Republic of */
+    {"north macedonia", 130, 15}, /* Macedonia, Republic of */
+    {"republic of north macedonia", 130, 27}, /* Macedonia, Republic of */
+    {"czechia", 57, 7}, /* Czech Republic */
+    {"slovak republic", 200, 15}, /* Slovakia */
+    {"kyrgyz republic", 119, 15}, /* Kyrgyzstan */
+    {"eswatini", 212, 8}, /* Swaziland */
+    {"cabo verde", 40, 10}, /* Cape Verde */
+    {"brunei", 33, 6}, /* Brunei Darussalam */
+    {"burma", 151, 5}, /* Myanmar */
+    {"cote d'ivoire", 58, 13}, /* Côte d'Ivoire */
+    {"ivory coast", 58, 11}, /* Côte d'Ivoire */
+    {"taiwan", 216, 6}, /* Taiwan, Republic of China */
+    {"hong kong", 98, 9}, /* Hong Kong, SAR China */
+    {"macao", 129, 5}, /* Macao, SAR China */
+    {"macau", 129, 5}, /* Macao, SAR China */
+    {"micronesia", 143, 10}, /* Micronesia, Federated States of */
+    {"federated states of micronesia", 143, 30}, /* Micronesia, Federated States of */
+    {"palestine", 169, 9}, /* Palestinian Territory */
+    {"west bank", 169, 9}, /* Palestinian Territory */
+    {"gaza strip", 169, 10}, /* Palestinian Territory */
+    {"holy see", 96, 8}, /* Holy See (Vatican City State) */
+    {"vatican", 96, 7}, /* Holy See (Vatican City State) */
+    {"vatican city", 96, 12}, /* Holy See (Vatican City State) */
+    {"democratic republic of congo", 51, 28}, /* Democratic Republic of the Congo */
+    {"dr congo", 51, 8}, /* Democratic Republic of the Congo */
+    {"congo, democratic republic of the", 51, 33}, /* Democratic Republic of the Congo */
+    {"zaire", 51, 5}, /* Democratic Republic of the Congo */
+    {"congo", 50, 5}, /* Congo (Brazzaville) */
+    {"republic of the congo", 50, 21}, /* Congo (Brazzaville) */
+    {"republic of congo", 50, 17}, /* Congo (Brazzaville) */
+    {"congo-brazzaville", 50, 17}, /* Congo (Brazzaville) */
+    {"the gambia", 79, 10}, /* Gambia */
+    {"gambia, the", 79, 11}, /* Gambia */
+    {"the bahamas", 16, 11}, /* Bahamas */
+    {"bahamas, the", 16, 12}, /* Bahamas */
+    {"the netherlands", 155, 15}, /* Netherlands */
+    {"holland", 155, 7}, /* Netherlands */
+    {"curacao", 156, 7}, /* Netherlands Antilles */
+    {"sint maarten", 156, 12}, /* Netherlands Antilles */
+    {"bonaire", 156, 7}, /* Netherlands Antilles */
+    {"timor leste", 220, 11}, /* Timor-Leste */
+    {"east timor", 220, 10}, /* Timor-Leste */
+    {"falkland islands", 70, 16}, /* Falkland Islands (Malvinas) */
+    {"falkland islands (islas malvinas)", 70, 33}, /* Falkland Islands (Malvinas) */
+    {"virgin islands", 241, 14}, /* Virgin Islands, US */
+    {"us virgin islands", 241, 17}, /* Virgin Islands, US */
+    {"u.s. virgin islands", 241, 19}, /* Virgin Islands, US */
+    {"reunion", 183, 7}, /* Réunion */
+    {"saint barthelemy", 189, 16}, /* Saint-Barthélemy */
+    {"saint-barthelemy", 189, 16}, /* Saint-Barthélemy */
+    {"saint martin", 190, 12}, /* Saint-Martin (French part) */
+    {"saint-martin", 190, 12}, /* Saint-Martin (French part) */
+    {"saint vincent and the grenadines", 188, 32}, /* Saint Vincent and Grenadines */
+    {"heard island and mcdonald islands", 95, 33}, /* Heard and Mcdonald Islands */
+    {"svalbard", 211, 8}, /* Svalbard and Jan Mayen Islands */
+    {"jan mayen", 211, 9}, /* Svalbard and Jan Mayen Islands */
+    {"svalbard and jan mayen", 211, 22}, /* Svalbard and Jan Mayen Islands */
+    {"wallis and futuna", 242, 17}, /* Wallis and Futuna Islands */
+    {"pitcairn islands", 175, 16}, /* Pitcairn */
+    {"cocos islands", 47, 13}, /* Cocos (Keeling) Islands */
+    {"keeling islands", 47, 15}, /* Cocos (Keeling) Islands */
+    {"turkiye", 226, 7}, /* Turkey */
+    {"türkiye", 226, 8}, /* Turkey */
+    {"bosnia", 27, 6}, /* Bosnia and Herzegovina */
+    {"uae", 232, 3}, /* United Arab Emirates */
+    {"south georgia and south sandwich islands", 205, 40}, /* South Georgia and the South Sandwich Islands */
+    {"french southern and antarctic lands", 77, 35}, /* French Southern Territories */
+    {"são tomé and príncipe", 193, 24}, /* Sao Tome and Principe */
+    {"guinea bissau", 92, 13}, /* Guinea-Bissau */
+    {"Åland islands", 1, 14}, /* Aland Islands */
+    {"united states minor outlying islands", 236, 36}, /* US Minor Outlying Islands */
+};
+
+/* Displacement of each bucket of the FNV-1a hash */
+static const unsigned short aiAliasDisplace[ALIASBUCKETNUM] = {
+       0,    0,    0,    0,    0,    0,    3,    0,    0,    0,    1,    0,    2,    0,    5,    0,
+       0,    1,    0,    0,    0,    2,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    1,    0,    0,    0,    0,    0,    5,    0,    2,    0,
+       1,    0,    0,    0,    1,    0,    0,    2,    1,    0,    0,    1,    1,    0,    0,    0,
+       0,    0,    1,    4,    0,    2,    0,    1,    0,    0,    0,    1,    0,    3,    1,    0,
+       0,    1,    0,    1,    1,    0,    1,    0,    1,    0,    0,    0,    0,    0,    0,    0,
+       1,    0,    0,    0,    1,    0,    0,    1,    2,    0,    1,    1,    0,    1,    1,    0,
+       2,    0,    0,    0,    6,    0,    0,    0,    0,    0,    0,    1,    0,    0,    3,    0,
+       2,    0,    0,    0,    0,    0,    0,    0,    0,    0,    1,    0,    0,    0,    0,    0,
+       0,    1,    0,    2,    0,    0,    1,    2,    0,    2,    0,    0,    0,    1,    0,    2,
+       0,    0,    0,    0,    0,    0,    4,    0,    1,    0,    2,    1,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    1,    0,    0,    1,    0,    1,    3,    0,    1,    0,
+       0,    1,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    1,    0,    0,    0,
+       0,    0,    0,    4,    0,    0,    0,    0,    0,    5,    2,    0,    0,    0,    0,    0,
+       0,    1,    0,    3,    0,    0,    1,    0,    0,    4,    0,    0,    0,    0,    0,    0,
+       2,    2,    0,    0,    0,    1,    0,    2,    0,    0,    0,    2,    1,    0,    0,    0,
+       0,    1,    1,    1,    0,    0,    0,    1,    2,    0,    0,    0,    0,    0,    0,    1,
+       0,    1,    0,    0,    0,    1,    1,    0,    0,    0,    0,    0,    0,    0,    5,    1,
+       2,    0,    1,    1,    0,    0,    0,    1,    0,    0,    1,    0,    0,    0,    0,    1,
+       0,    1,    0,    2,    0,    0,    1,    0,    0,    4,    0,    1,    0,    0,    0,    1,
+       0,    0,    1,    0,    1,    0,    2,    0,    6,    2,    2,    1,    1,    2,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    1,    0,    0,    0,    0,
+       0,    0,    0,    0,    3,    0,    0,    2,    0,    0,    2,    0,    0,    1,    0,    0,
+       0,    0,    0,    0,    0,    0,    1,    3,    0,    1,    0,    2,    1,    0,    1,    0,
+       3,    3,    0,    0,    0,    0,    0,    1,    0,    2,    1,    0,    0,    0,    1,    4,
+       0,    1,    1,    2,    0,    0,    1,    0,    0,    0,    0,    1,    0,    0,    0,    0,
+       2,    1,    3,    0,    3,    0,    0,    2,    0,    0,    0,    3,    1,    1,    0,    0,
+       2,    1,    0,    0,    0,    0,    1,    0,    0,    2,    0,    4,    0,    0,    0,    0,
+       0,    0,    1,    1,    0,    0,    0,    1,    1,    0,    0,    1,    0,    0,    0,    0,
+       0,    0,    1,    0,    0,    0,    0,    0,    1,    1,    0,    0,    0,    0,    1,    0,
+       0,    2,    0,    0,    0,    0,    0,    0,    0,    0,    0,    2,    0,    0,    1,    1,
+       0,    0,    0,    0,    1,    0,    0,    2,    1,    4,    0,    0,    1,    0,    0,    0
+};
+
+/* 1 + the index into atAliases[] of the key in each slot, 0 for none */
+static const unsigned short aiAliasSlot[1 << ALIASSLOTBITS] = {
+     386,    0,  306,    0,    0,  592,    0,    0,    0,  796,   20,    0,    0,  523,    0,    0,
+       0,    0,    0,    0,    0,    0,  521,    0,  447,    0,    0,    0,    0,    0,  355,    0,
+       0,    0,  638,  678,    0,    0,  594,    8,    0,    0,    0,  124,    0,    0,    0,    0,
+       0,    0,  194,    0,    0,    0,    0,  272,    0,  174,  432,    0,    0,   71,    0,  656,
+     548,  835,    0,    0,  211,    0,    0,  454,    0,    0,    0,  571,    0,    0,   75,    0,
+     495,    0,    0,    0,  203,    0,    0,    0,  180,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,  300,    0,  372,    0,  554,  811,    0,  373,    0,  384,    0,  422,    0,    0,
+       0,    0,    0,    0,    0,   95,    0,    0,    0,    0,    0,  535,  458,    0,    0,    0,
+       0,    0,    0,    0,  233,    0,    0,    0,    0,  607,  840,    0,  808,    0,    0,  172,
+       0,    0,    0,    0,    0,  107,  212,    0,    0,    0,    0,    0,    0,  695,    0,    0,
+       0,  198,   73,    0,  717,  504,  838,    0,  268,    0,    0,  339,  263,    0,    0,  347,
+       0,    0,    0,    0,    0,    0,  256,  360,    0,    0,    0,  660,    0,  513,  665,  702,
+     167,    0,   90,    0,  336,   44,    0,    0,    0,    0,  849,  312,    0,  569,  290,    0,
+       0,  213,    0,    0,  724,    0,  735,  712,  573,    0,    0,  350,    0,  140,    0,    0,
+       0,  315,  222,    0,    0,    0,    0,    0,    0,  805,    0,    0,    0,  648,    0,  125,
+       0,  397,    0,  585,    0,    0,  558,  798,  277,    6,    0,    0,    0,  235,  270,    0,
+       0,    0,  772,    0,  382,    0,   58,  711,  628,    0,    0,  732,   24,  829,  409,    0,
+     537,    0,    0,    0,  462,    0,    0,  189,    0,    0,    0,    0,    0,    0,  165,    0,
+     623,    0,    0,  376,  833,    0,    0,  781,  649,    0,  562,    0,  784,    0,    0,  187,
+     333,    0,  632,    0,    0,  389,    0,    0,    0,    0,  582,    0,  778,  609,    0,    0,
+     613,    0,  581,  529,    0,   49,    0,    0,    0,   28,  410,    0,    0,  110,    0,  303,
+       0,    0,  801,    0,    0,  675,  673,    0,  166,  813,    0,  308,    0,    0,  546,  449,
+     304,    0,    0,    0,    0,   55,    0,  463,    0,    0,  839,    0,    0,    0,  294,    0,
+     684,  842,  488,  519,    0,    0,  540,  605,  710,    0,    0,    0,  284,  351,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,  262,    0,  830,    0,    0,    0,  703,  576,    0,
+       0,    0,    0,  179,    0,    0,  757,  267,    0,    0,    0,  517,  274,  420,  776,    0,
+     508,    0,    0,  580,  814,  550,  442,    0,  132,    0,  722,  250,    0,   76,    0,  340,
+     759,  176,  318,    0,    0,   47,    0,    0,    0,    0,  358,    0,  161,  743,  116,    0,
+       0,    0,  680,  820,    0,    0,  441,  367,  766,    0,    0,    0,  575,  175,    0,    0,
+     403,  328,    0,   57,    0,  156,  472,    0,    0,  612,  727,    0,  818,  427,    0,  707,
+       0,    0,    0,    0,  231,    0,    0,  182,  846,   43,    0,  654,    0,    0,  147,    0,
+       0,  723,    0,  502,    0,  705,  144,    0,  310,  785,    0,  765,    0,    0,    0,   50,
+     641,    0,    0,    0,   69,  402,    0,    0,  406,    0,    0,    0,    0,    0,  643,  834,
+       0,  584,    0,    0,    0,    0,  545,    0,   85,    0,    0,    0,    0,  450,    0,    0,
+       0,    0,    0,    0,    0,  698,    0,    0,    0,    0,    0,    0,    0,  311,  483,    0,
+       0,    0,    0,  278,    0,    0,  296,    0,    0,    0,    0,    0,  163,  375,  620,    0,
+     314,  591,  851,    0,  677,  547,    0,  615,  503,    7,   29,   53,  217,    0,  396,   87,
+       0,    0,  138,    0,    0,    0,  288,  246,  593,    0,   51,    0,   64,  647,  642,    0,
+       0,  630,    0,  199,  563,  436,  794,    0,  552,  731,    0,    0,  111,    0,  221,    0,
+       0,    0,  768,  283,    0,  629,   92,  143,    0,  530,    0,    0,    0,  618,  364,    0,
+     341,    0,  279,  253,  676,    0,   79,  408,    0,    0,    0,  850,  368,    0,    0,    0,
+       0,  525,  596,  652,  531,  297,    0,    0,    0,    0,  639,  337,    0,  346,    0,    0,
+       0,  822,    0,    0,    0,    0,    0,    0,  824,  533,  843,  557,  370,  770,  240,    0,
+      62,  451,    0,    0,    0,    0,    0,   25,   12,    0,    0,  390,    0,    0,    0,    0,
+     598,   60,    0,  538,    0,    0,    0,    0,    0,    0,    0,  587,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,    0,  301,    0,  681,  603,    0,  307,    0,
+       0,  515,    0,    0,  149,  418,    0,   27,    2,    0,  688,  815,    0,    0,  115,    0,
+       0,  220,  193,    0,   39,    0,    0,    0,  264,    0,    0,    0,    0,    0,    0,    0,
+     261,    0,  626,    0,    0,  745,    0,    0,  275,    0,  468,    0,    0,    0,    0,  720,
+     155,    0,  714,    0,    0,    0,   31,  578,    0,    0,    0,  821,    0,    0,  168,  207,
+     238,  624,    0,    0,  773,    0,  664,    0,    0,    0,    0,    0,    0,    0,    0,  590,
+       0,  181,    0,  758,    0,  752,  108,    0,  313,   77,    0,  417,    0,   99,  828,    0,
+       0,    0,  691,  589,  760,    0,    0,    0,   19,    0,  252,    0,  499,    0,  232,    0,
+     415,    0,    0,    0,    0,    0,    0,  195,  251,    0,  807,  570,    0,  243,    0,    0,
+       0,  610,  672,  234,  516,  118,    0,    0,    0,    0,  186,    0,  404,  281,    0,  242,
+       0,    0,  119,  192,    0,    0,  574,    0,  456,    0,    0,    0,  549,    0,  744,  526,
+     464,    0,    0,    0,    0,    0,  266,    0,  273,    0,    0,    0,    0,    0,    0,    0,
+       0,  239,  786,  761,    0,    0,    0,   84,    0,  564,    0,  153,    0,    0,    0,    0,
+     496,  405,    0,  742,  844,    0,    0,    0,    0,    0,    0,    0,  433,  561,  146,    0,
+      81,    0,  762,    0,  183,    0,  466,    0,  455,    0,    0,  197,    0,  767,    0,   61,
+       0,    0,    0,    0,  154,  823,    0,  737,  227,  817,    0,  218,    0,   72,    0,  465,
+     164,    0,  399,    0,  320,    0,  317,   68,  696,  191,  113,    0,    0,    0,  715,  357,
+       4,  567,  606,    0,  127,    0,    0,    0,  435,    0,    0,    0,    0,    0,    0,    0,
+     129,  190,    0,  348,  106,  423,    0,  739,    0,    0,    0,  699,  434,    0,    0,  506,
+       0,  572,    0,    0,  480,  114,    0,    0,    0,    0,    0,  444,  740,   14,    0,  354,
+     479,  841,  803,    0,  349,  473,    0,    0,    0,    0,  378,   26,  105,   89,    0,  178,
+       0,    0,    0,    0,  791,  325,    0,    0,    0,    0,    0,    0,    0,  637,  501,    0,
+      54,  134,    0,    0,    0,    0,    0,    0,    0,    0,  185,  461,    0,    0,    0,   88,
+       0,    0,    0,    0,  470,  103,    0,    0,    0,  491,  685,    0,    0,  579,    0,    0,
+       0,  112,    0,  478,   13,    0,  419,    0,  271,  653,  750,  128,    0,  645,  659,    0,
+       0,    0,  627,  825,  259,    0,    9,    0,    0,  559,  800,  497,  459,    0,    0,  177,
+       0,    0,    0,  365,   41,    0,  352,    0,    0,    0,  388,    0,  604,  428,  543,    0,
+       0,    0,    0,    0,  819,  249,    0,    0,  305,  795,    0,    0,  391,  385,  831,    0,
+       0,    0,    0,  276,  145,  321,    0,  380,  774,  635,    0,  553,    0,    0,  401,    0,
+     392,  130,    0,  701,    0,  136,    0,  158,    0,  302,    0,    0,  845,    0,    0,  670,
+       0,  634,    0,    0,  202,    0,   70,    0,    0,    0,    0,    0,   35,    0,  142,    0,
+       0,  374,  763,    0,    0,    0,    0,  686,  431,  663,  802,    0,  524,  599,  522,  726,
+     245,    0,    0,    0,    0,    0,    0,    0,    0,  247,    0,    0,  489,    0,    0,  230,
+     631,    0,    0,  810,  534,  527,    0,  568,    0,  777,    0,    0,    0,    0,  319,    0,
+     228,    0,  289,  395,    0,    0,    0,    0,  208,    0,   83,    0,    0,    0,   94,    0,
+       0,    0,    0,    3,    0,    0,    0,    0,  101,  258,    0,  150,  316,    0,  342,    0,
+     426,    0,    0,  131,    0,  687,    0,  200,  424,    0,    0,  206,    0,  816,    0,    0,
+     827,  782,    0,    0,  344,  332,    0,  241,    0,   56,    0,    0,    0,   48,    0,    0,
+       0,  159,  661,    0,    0,    0,    0,    0,  764,    0,   80,    0,  595,    0,    0,  330,
+       0,    0,  769,    0,    0,  298,    0,    0,    0,    0,    0,    0,  510,  511,    0,    0,
+       0,    0,    0,  331,  133,    0,  329,    0,    0,    0,    0,    0,  173,  445,    0,    0,
+       0,  756,  669,    0,  514,    0,  694,    0,  625,  204,  704,    0,  619,    0,    0,    0,
+       0,  322,  135,    0,    0,    0,  323,    0,    0,    0,    0,  500,    0,    0,  708,    0,
+       0,    0,  583,  286,   82,  551,    0,    0,   45,    0,    0,    0,   33,  438,  157,    0,
+       0,  650,    0,  662,    0,    0,    0,    0,  225,    0,    0,    0,   30,  674,    0,  265,
+     398,    0,    0,  799,  285,  335,    0,  381,   10,  324,  377,  210,  788,    0,  655,  453,
+       0,  120,    5,    0,  804,  667,  689,    0,    0,    0,  518,    0,    0,    0,    0,    0,
+       0,    0,   38,  407,    0,  747,    0,    0,    0,  236,    0,    0,    0,  474,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,  457,  152,    0,    0,  201,    0,    0,    0,
+     797,    0,  387,    0,   17,    0,    0,  614,  492,    0,  528,    0,    0,  102,    0,  616,
+     446,  248,  826,    0,  452,    0,    0,  414,  416,    0,    0,    0,  429,    0,  636,    0,
+     751,    0,    0,  806,    0,    0,    0,    0,    0,    0,  326,    0,    0,    0,   15,  448,
+     237,    0,    0,    0,   21,    0,    0,    0,   97,   16,  160,  718,  226,  602,    0,    0,
+     394,    0,    0,    0,   59,    0,    0,  121,  280,    0,    0,  597,    0,    0,  621,    0,
+       0,  657,    0,    0,  713,  309,  137,  425,   67,  725,    0,    0,   86,  282,  141,    0,
+       0,    0,    0,    0,    0,  287,    0,    0,  170,    0,  532,    0,  542,   36,    0,  666,
+       0,  721,    0,    0,    0,  122,    0,    0,   46,    0,    0,    0,    0,   74,    0,    0,
+       0,  362,  359,    0,  837,  690,    0,    0,    0,   93,  847,    0,    0,  169,   98,    0,
+       0,  790,  260,    0,   42,   18,    0,    0,    0,    0,    0,  832,    0,    0,   91,    0,
+       0,  338,  507,    0,    0,    0,  215,  600,  586,    0,    0,  343,    0,    0,    0,  205,
+       0,  254,  700,  299,  139,    0,    0,    0,  682,    0,    0,    0,  709,  151,    0,    0,
+       0,    0,  812,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,  683,    0,  162,    0,  588,    0,    0,    0,    0,  494,    0,    0,
+     104,    0,  809,  269,    0,    0,    0,    0,    0,    0,    0,    0,    0,   23,    0,  437,
+       0,    0,    0,    0,    0,  733,    0,    0,  109,    0,    0,    0,    0,    0,    0,    0,
+      22,   66,  214,  779,    0,    0,  498,  484,   52,    0,  668,    0,    0,  755,    0,  780,
+     509,    0,  741,   34,  482,    0,  393,    0,  754,  257,    0,  345,  371,  255,    0,    0,
+     439,    0,    0,    0,  644,  486,  783,  520,    0,  646,    0,    0,    0,    0,    0,    0,
+     469,    0,  334,  224,    0,    0,    0,    0,    0,  633,  775,   11,    0,  541,    0,  369,
+       0,    0,  539,  608,    0,  292,    0,    0,    1,    0,    0,  291,    0,    0,    0,  223,
+      32,    0,    0,    0,    0,    0,    0,  353,  738,    0,  706,  601,  421,    0,    0,  467,
+       0,  379,  475,    0,  671,    0,  443,  188,    0,    0,    0,    0,  244,  361,  485,    0,
+       0,    0,  555,    0,    0,    0,  100,  746,    0,  295,    0,    0,    0,    0,    0,    0,
+       0,  789,  787,  560,  490,    0,    0,  363,    0,  544,    0,    0,  117,  658,  728,    0,
+     512,    0,  536,  753,    0,  771,    0,    0,    0,    0,  411,    0,  412,  383,    0,  836,
+       0,  123,  196,    0,  617,    0,  719,    0,    0,    0,    0,    0,  440,    0,    0,  126,
+       0,    0,    0,    0,    0,  477,  356,   65,    0,  793,    0,  611,  366,  184,  716,    0,
+     430,    0,  693,    0,    0,  481,    0,    0,  219,  493,    0,  413,    0,    0,    0,   40,
+     577,  692,    0,    0,    0,    0,  679,   78,  734,    0,    0,    0,  622,    0,    0,    0,
+       0,  471,    0,    0,  640,   63,    0,  460,  209,    0,  749,  293,   96,  487,    0,    0,
+     729,  565,    0,    0,    0,  216,    0,  848,  400,    0,    0,  476,    0,    0,  748,  736,
+       0,  327,    0,    0,    0,    0,  792,   37,  730,  697,    0,    0,    0,  566,    0,  148,
+       0,    0,  651,    0,  556,    0,    0,    0,    0,    0,  229,    0,    0,    0,  505,  171
+};
+
+/* Indexes into atAliases[] of the names and aliases, which fuzzy matching compares against */
+static const unsigned short aiFuzzy[FUZZYNUM] = {
+       0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15,
+      16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
+      32,   33,   34,   35,   36,   37,   38,   39,   40,   41,   42,   43,   44,   45,   46,   47,
+      48,   49,   50,   51,   52,   53,   54,   55,   56,   57,   58,   59,   60,   61,   62,   63,
+      64,   65,   66,   67,   68,   69,   70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
+      80,   81,   82,   83,   84,   85,   86,   87,   88,   89,   90,   91,   92,   93,   94,   95,
+      96,   97,   98,   99,  100,  101,  102,  103,  104,  105,  106,  107,  108,  109,  110,  111,
+     112,  113,  114,  115,  116,  117,  118,  119,  120,  121,  122,  123,  124,  125,  126,  127,
+     128,  129,  130,  131,  132,  133,  134,  135,  136,  137,  138,  139,  140,  141,  142,  143,
+     144,  145,  146,  147,  148,  149,  150,  151,  152,  153,  154,  155,  156,  157,  158,  159,
+     160,  161,  162,  163,  164,  165,  166,  167,  168,  169,  170,  171,  172,  173,  174,  175,
+     176,  177,  178,  179,  180,  181,  182,  183,  184,  185,  186,  187,  188,  189,  190,  191,
+     192,  193,  194,  195,  196,  197,  198,  199,  200,  201,  202,  203,  204,  205,  206,  207,
+     208,  209,  210,  211,  212,  213,  214,  215,  216,  217,  218,  219,  220,  221,  222,  223,
+     224,  225,  226,  227,  228,  229,  230,  231,  232,  233,  234,  235,  236,  237,  238,  239,
+     240,  241,  242,  243,  244,  245,  246,  247,  248,  249,  250,  251,  252,  744,  745,  746,
+     747,  748,  749,  750,  751,  752,  753,  754,  755,  756,  757,  758,  759,  760,  761,  762,
+     763,  764,  765,  766,  767,  768,  769,  770,  771,  772,  773,  774,  775,  776,  777,  778,
+     779,  780,  781,  782,  783,  784,  785,  786,  787,  788,  789,  790,  791,  792,  793,  794,
+     795,  796,  797,  798,  799,  800,  801,  802,  803,  804,  805,  806,  807,  808,  809,  810,
+     811,  812,  813,  814,  815,  816,  817,  818,  819,  820,  821,  822,  823,  824,  825,  826,
+     827,  828,  829,  830,  831,  832,  833,  834,  835,  836,  837,  838,  839,  840,  841,  842,
+     843,  844,  845,  846,  847,  848,  849,  850
+};
+
+/* The names and aliases with a bigram (a, b) hashing to (31a + b) mod 2^BIGRAMBITS,
+   from aiBigramList[aiBigramStart[h]] up to aiBigramList[aiBigramStart[h + 1]] */
+static const unsigned short aiBigramStart[(1 << BIGRAMBITS) + 1] = {
+       0,    0,    0,    0,    0,    0,    0,    0,    0,   10,   10,   10,   10,   10,   10,   10,
+      10,   10,   10,   10,   10,   10,   10,   10,   10,   10,   10,   10,   10,   10,   33,   33,
+      33,   34,   41,   51,   63,   65,   68,   73,   78,  107,  108,  112,  152,  177,  300,  307,
+     311,  312,  357,  368,  396,  407,  409,  410,  410,  419,  426,  426,  426,  459,  459,  459,
+     481,  482,  509,  517,  539,  545,  546,  555,  573,  575,  611,  643,  651,  656,  690,  696,
+     725,  745,  746,  772,  798,  813,  816,  824,  825,  825,  826,  827,  844,  844,  844,  873,
+     873,  874,  876,  890,  890,  892,  910,  915,  915,  915,  915,  915,  915,  938,  938,  938,
+     948,  948,  950,  953,  953,  953,  953,  954,  956,  956,  956,  973,  973,  973,  985,  985,
+     985,  985, 1000, 1000, 1000, 1000, 1008, 1009, 1010, 1010, 1010, 1010, 1028, 1029, 1029, 1032,
+    1065, 1065, 1066, 1066, 1068, 1068, 1068, 1068, 1069, 1069, 1074, 1074, 1074, 1096, 1097, 1102,
+    1118, 1124, 1124, 1129, 1129, 1132, 1133, 1134, 1155, 1168, 1200, 1207, 1237, 1238, 1275, 1302,
+    1309, 1310, 1311, 1314, 1315, 1319, 1323, 1323, 1323, 1339, 1339, 1339, 1344, 1344, 1344, 1344,
+    1347, 1348, 1351, 1351, 1353, 1353, 1353, 1353, 1353, 1353, 1354, 1354, 1354, 1362, 1362, 1362,
+    1364, 1364, 1364, 1364, 1364, 1364, 1364, 1364, 1367, 1367, 1367, 1380, 1380, 1380, 1381, 1389,
+    1389, 1389, 1391, 1401, 1402, 1402, 1404, 1404, 1404, 1418, 1418, 1418, 1425, 1426, 1426, 1442,
+    1442, 1442, 1442, 1445, 1445, 1445, 1445, 1445, 1445, 1445, 1455, 1455, 1455, 1455, 1478, 1478,
+    1478, 1478, 1486, 1486, 1486, 1486, 1486, 1486, 1493, 1493, 1493, 1495, 1496, 1497, 1500, 1500,
+    1500, 1500, 1500, 1500, 1500, 1500, 1503, 1503, 1504, 1571, 1577, 1628, 1629, 1635, 1635, 1638,
+    1638, 1638, 1640, 1643, 1653, 1657, 1719, 1725, 1729, 1732, 1751, 1798, 1824, 1830, 1840, 1842,
+    1842, 1844, 1845, 1845, 1845, 1851, 1851, 1851, 1857, 1857, 1857, 1859, 1860, 1860, 1860, 1861,
+    1864, 1864, 1865, 1865, 1866, 1866, 1868, 1869, 1869, 1869, 1869, 1869, 1871, 1871, 1871, 1872,
+    1872, 1872, 1872, 1872, 1872, 1872, 1872, 1874, 1874, 1874, 1874, 1879, 1880, 1880, 1881, 1891,
+    1891, 1891, 1895, 1896, 1896, 1908, 1908, 1908, 1909, 1910, 1910, 1911, 1911, 1911, 1911, 1913,
+    1913, 1913, 1913, 1944, 1944, 1962, 2032, 2036, 2036, 2042, 2064, 2064, 2067, 2067, 2113, 2115,
+    2119, 2128, 2128, 2128, 2135, 2135, 2135, 2135, 2135, 2137, 2142, 2145, 2145, 2145, 2151, 2151,
+    2151, 2151, 2158, 2158, 2158, 2203, 2212, 2214, 2214, 2224, 2224, 2224, 2224, 2236, 2238, 2239,
+    2239, 2239, 2239, 2261, 2261, 2261, 2261, 2261, 2261, 2262, 2262, 2262, 2262, 2266, 2266, 2266,
+    2266, 2266, 2266, 2267, 2300, 2300, 2310, 2378, 2409, 2409, 2433, 2433, 2471, 2471, 2473, 2475,
+    2477, 2477, 2490, 2490, 2490, 2490, 2492, 2513, 2514, 2514, 2514, 2514, 2516, 2519, 2519, 2519,
+    2519, 2519, 2519, 2523, 2524, 2534, 2539, 2540, 2566, 2567, 2567, 2569, 2569, 2571, 2590, 2601,
+    2643, 2647, 2651, 2651, 2688, 2697, 2702, 2717, 2724, 2724, 2724, 2724, 2725, 2725, 2725, 2731,
+    2731, 2731, 2742, 2742, 2743, 2744, 2752, 2753, 2753, 2754, 2759, 2759, 2760, 2765, 2766, 2766,
+    2770, 2771, 2771, 2775, 2775, 2776, 2810, 2810, 2810, 2810, 2810, 2810, 2810, 2810, 2829, 2829,
+    2829, 2830, 2830, 2830, 2830, 2830, 2830, 2832, 2832, 2832, 2834, 2834, 2837, 2837, 2837, 2837,
+    2837, 2837, 2837, 2837, 2837, 2841, 2841, 2841, 2841, 2841, 2841, 2841, 2841, 2855, 2855, 2855,
+    2890, 2894, 2897, 2905, 2961, 2962, 2975, 2975, 3014, 3014, 3026, 3030, 3034, 3042, 3052, 3052,
+    3052, 3060, 3062, 3079, 3090, 3090, 3092, 3092, 3096, 3097, 3097, 3097, 3097, 3097, 3097, 3124,
+    3124, 3126, 3126, 3134, 3134, 3134, 3138, 3150, 3150, 3150, 3191, 3191, 3193, 3206, 3207, 3207,
+    3209, 3214, 3244, 3247, 3250, 3255, 3255, 3258, 3258, 3258, 3258, 3258, 3258, 3258, 3289, 3289,
+    3291, 3291, 3316, 3316, 3316, 3350, 3384, 3384, 3384, 3387, 3388, 3389, 3401, 3401, 3401, 3407,
+    3410, 3412, 3422, 3423, 3423, 3423, 3425, 3426, 3426, 3426, 3429, 3429, 3429, 3442, 3473, 3474,
+    3479, 3489, 3491, 3494, 3494, 3501, 3501, 3503, 3504, 3505, 3521, 3521, 3522, 3522, 3539, 3552,
+    3567, 3567, 3569, 3570, 3571, 3572, 3573, 3573, 3573, 3573, 3573, 3573, 3590, 3590, 3590, 3590,
+    3599, 3600, 3600, 3600, 3619, 3619, 3619, 3619, 3619, 3619, 3622, 3622, 3622, 3622, 3622, 3622,
+    3622, 3622, 3622, 3622, 3622, 3622, 3622, 3622, 3625, 3625, 3625, 3636, 3636, 3636, 3636, 3640,
+    3641, 3641, 3641, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645, 3645,
+    3645, 3645, 3645, 3645, 3645, 3645, 3645, 3646, 3646, 3646, 3646, 3646, 3646, 3646, 3647, 3647,
+    3647, 3647, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648,
+    3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3648, 3652, 3652, 3653, 3653, 3659, 3659, 3659,
+    3659, 3661, 3661, 3661, 3661, 3662, 3663, 3664, 3666, 3666, 3671, 3672, 3672, 3672, 3672, 3672,
+    3672, 3672, 3674, 3674, 3674, 3674, 3674, 3674, 3684, 3685, 3685, 3685, 3692, 3692, 3692, 3692,
+    3695, 3695, 3695, 3695, 3695, 3695, 3695, 3696, 3696, 3696, 3697, 3697, 3701, 3701, 3701, 3701,
+    3701, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703, 3703,
+    3718, 3718, 3718, 3718, 3718, 3718, 3718, 3718, 3718, 3719, 3719, 3719, 3730, 3731, 3732, 3732,
+    3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3732, 3735,
+    3735
+};
+
+static const unsigned short aiBigramList[3735] = {
+      47,   50,   70,   96,  116,  117,  190,  215,  239,  823,   51,  103,  130,  215,  216,  218,
+     758,  759,  762,  763,  766,  770,  772,  775,  776,  777,  778,  781,  803,  805,  808,  809,
+     846,  818,   78,  194,  215,  232,  246,  768,  786,  129,  130,  145,  779,  780,  781,  793,
+     794,  817,  849,   18,   19,   39,   43,   63,   65,   86,   87,  131,  188,  224,  832,  107,
+     844,    0,   42,  204,  131,  159,  172,  224,  239,   16,   17,  243,  813,  814,   15,   17,
+      94,  109,  118,  175,  184,  185,  186,  187,  188,  189,  190,  207,  216,  219,  228,  231,
+     750,  751,  791,  806,  819,  828,  829,  830,  831,  832,  838,  217,  113,  167,  200,  783,
+       1,    2,    3,   13,   33,   42,   65,   66,   70,   83,   89,   95,  108,  132,  133,  134,
+     135,  136,  137,  154,  157,  158,  168,  169,  177,  195,  203,  211,  229,  242,  754,  773,
+     774,  797,  822,  823,  833,  834,  836,  837,    4,   16,   33,   37,   38,   79,   88,  103,
+     109,  150,  152,  170,  191,  210,  234,  240,  245,  747,  764,  766,  811,  812,  813,  814,
+     847,    0,    1,    2,    4,    5,    6,    7,    8,    9,   15,   18,   25,   27,   28,   29,
+      31,   32,   39,   41,   42,   46,   47,   52,   62,   70,   71,   73,   74,   75,   81,   82,
+      85,   93,   95,   96,  100,  103,  105,  106,  110,  112,  113,  119,  122,  127,  137,  139,
+     151,  155,  156,  158,  163,  164,  166,  167,  169,  170,  176,  180,  181,  182,  185,  187,
+     188,  192,  193,  202,  205,  206,  208,  209,  211,  212,  214,  215,  216,  217,  218,  219,
+     224,  227,  228,  230,  236,  237,  238,  239,  241,  242,  752,  753,  755,  765,  766,  768,
+     771,  772,  775,  776,  791,  798,  801,  802,  815,  816,  822,  823,  824,  825,  826,  832,
+     833,  835,  836,  837,  838,  839,  840,  845,  846,  847,  849,  850,  120,  129,  193,  769,
+     770,  793,  817,   40,  110,  171,  199,  104,    8,    9,   10,   11,   12,   19,   20,   33,
+      34,   59,   71,   83,   95,   98,   99,  129,  131,  137,  138,  151,  159,  164,  172,  179,
+     189,  190,  192,  194,  211,  215,  232,  239,  243,  768,  775,  776,  818,  828,  829,  830,
+     831,  833,  834,  836,  846,   16,   35,   46,   70,   97,  131,  790,  813,  814,  821,  823,
+      51,   54,   66,   89,   96,  115,  121,  143,  148,  179,  181,  232,  234,  238,  744,  750,
+     762,  763,  770,  773,  774,  785,  796,  801,  802,  803,  805,  850,   13,   14,   92,  139,
+     140,  153,  168,  194,  222,  794,  848,   50,  810,  132,   41,  133,  141,  165,  172,  211,
+     235,  835,  836,   15,   30,   50,  113,  212,  799,  810,    1,    9,   27,   70,   95,  143,
+     185,  187,  188,  193,  205,  211,  218,  224,  228,  232,  233,  234,  242,  744,  772,  796,
+     822,  823,  832,  833,  836,  837,  845,  846,  847,  849,  850,    2,    9,   12,   15,   16,
+      17,   18,   19,   55,  115,  122,  189,  211,  224,  246,  798,  813,  814,  828,  829,  834,
+     836,  847,    9,   27,   42,   95,  156,  185,  187,  188,  193,  194,  204,  205,  211,  215,
+     224,  228,  232,  234,  242,  768,  832,  833,  836,  837,  845,  846,  847,    9,  750,  773,
+     776,  798,  813,  828,  848,   20,   21,   22,   23,   24,   51,   58,   96,   98,  124,  129,
+     157,  216,  228,  237,  789,  790,  802,  803,  804,  808,  809,   33,   58,  763,  770,  789,
+     805,  232,   25,   35,  143,  181,  183,  189,  242,  837,  847,   48,   66,   75,   79,   92,
+     150,  152,  171,  188,  194,  196,  205,  245,  811,  812,  832,  845,  848,   27,  184,    1,
+      29,   31,   32,   41,   46,   47,   52,   70,   71,   95,  103,  137,  163,  164,  202,  205,
+     211,  228,  236,  241,  242,  755,  766,  822,  823,  824,  825,  826,  833,  838,  839,  840,
+     845,  849,  850,   42,   51,   57,   62,  103,  130,  211,  215,  216,  218,  239,  758,  759,
+     762,  763,  766,  768,  770,  772,  775,  776,  777,  778,  781,  783,  784,  803,  805,  808,
+     809,  836,  847,   98,  185,  233,  249,  250,  758,  762,  792,  186,  198,  208,  820,  846,
+      26,   27,   28,   29,   37,   60,   78,   95,  106,  128,  164,  187,  192,  211,  236,  239,
+     773,  774,  775,  776,  777,  780,  781,  786,  796,  818,  819,  823,  830,  833,  835,  836,
+     843,  850,  171,  185,  240,  760,  781,  815,   31,   51,  103,  106,  130,  143,  216,  218,
+     234,  236,  758,  759,  762,  763,  766,  772,  773,  774,  775,  776,  777,  778,  781,  796,
+     803,  805,  808,  809,  850,   30,   31,   32,   33,   50,   76,   83,  120,  187,  190,  193,
+     750,  751,  762,  763,  770,  774,  787,  810,  847,   58,   42,   51,   53,   57,   62,  103,
+     130,  178,  215,  216,  218,  239,  759,  762,  763,  766,  768,  770,  772,  775,  776,  778,
+     783,  784,  803,  805,    4,    9,   34,   35,   36,   65,   77,   96,   98,  129,  143,  205,
+     206,  234,  243,  744,  757,  773,  774,  788,  796,  799,  800,  845,  846,  850,   31,   51,
+      77,  169,  193,  205,  224,  772,  805,  808,  812,  814,  821,  832,  847,  218,  241,  246,
+      32,   40,  188,  775,  786,  825,  826,  832,  125,  842,  158,   40,   51,   58,   71,   96,
+     106,  187,  193,  205,  773,  774,  789,  808,  811,  813,  815,  832,    4,    8,   37,   38,
+      39,   40,   41,   42,   53,   61,   62,   96,  109,  129,  131,  157,  159,  175,  204,  228,
+     234,  747,  786,  793,  794,  801,  802,  817,  838,  149,   95,  833,   31,   42,   74,   84,
+     100,  130,  188,  762,  763,  770,  779,  780,  781,  832,   50,   96,   43,   44,   45,   46,
+      57,   75,   76,   77,   98,  126,  129,  190,  197,  205,  216,  782,  845,  846,   96,  186,
+     193,  802,  847,   47,   48,   49,   50,   51,   52,   53,  142,  145,  149,  178,  228,  753,
+     789,  790,  803,  804,  805,  807,  808,  809,  810,  839,   51,   54,  143,  762,  763,  770,
+     795,  796,  803,  805,    8,  846,   55,   63,  817,   56,   57,  782,   51,  106,  216,  234,
+     758,  762,  766,  772,  773,  775,  777,  781,  796,  803,  805,  808,  809,    9,   24,   33,
+      39,   86,  112,  131,  182,  206,  209,  224,  230,   18,   40,   51,   59,   87,  143,  181,
+     213,  762,  763,  770,  786,  796,  803,  805,   31,   36,   37,  101,  134,  188,  194,  832,
+      60,  849,    5,   19,   61,   62,   63,   65,   95,  102,  130,  144,  157,  233,  777,  778,
+     779,  780,  781,  833,  761,  120,  252,  804,    1,   32,   41,   47,   52,   70,   71,   95,
+     137,  155,  156,  164,  202,  205,  211,  228,  236,  241,  242,  815,  822,  823,  824,  825,
+     826,  833,  838,  839,  840,  845,  846,  849,  850,   97,  205,  845,  847,   98,  236,  792,
+     840,  850,   31,   66,   67,   91,   92,   95,  116,  117,  158,  171,  249,  250,  750,  757,
+     758,  759,  760,  762,  763,  821,  833,  848,  122,   57,   63,   84,  126,  782,  130,  143,
+     157,  181,  213,  218,  232,  233,  234,  744,  772,  779,  780,  781,  796,  850,   47,   84,
+      85,   96,  800,  840,   27,   47,   64,  147,  195,   33,  126,  787,   98,  237,   20,   21,
+      22,   47,   65,   87,  100,  105,  107,  184,  187,  197,  222,  239,  251,  755,  775,  776,
+     828,  829,  840,   51,   89,  128,  189,  232,  244,  762,  763,  770,  803,  805,  828,  829,
+      10,   11,   23,   42,   59,   75,   76,   77,   85,   86,  114,  126,  147,  184,  188,  190,
+     195,  201,  211,  213,  227,  239,  244,  251,  752,  775,  776,  818,  832,  835,  836,  846,
+      80,  198,  205,  762,  763,  770,  845,   42,   51,   57,   62,  103,  130,  154,  215,  216,
+     218,  239,  758,  759,  762,  763,  766,  768,  770,  772,  775,  776,  777,  778,  781,  783,
+     784,  803,  805,  808,  809,   66,    3,    4,   15,   24,   27,   31,   38,   40,   67,   77,
+      81,   90,  111,  124,  143,  148,  155,  156,  160,  161,  164,  169,  173,  178,  181,  187,
+     196,  198,  214,  234,  243,  747,  755,  786,  796,  815,  846,   18,   68,   76,   77,  102,
+     123,  134,  143,  156,  169,  174,  188,  197,  220,  232,  234,  243,  744,  754,  785,  795,
+     796,  797,  798,  820,  832,  850,   29,   69,  155,  156,  240,  764,  815,  827,  185,  157,
+     158,  171,  142,   90,  111,  197,  226,  239,  251,  775,  776,   31,   32,   57,   75,   76,
+      77,  190,  204,  205,  206,  249,  250,  780,  781,  845,  846,   35,   70,   71,  822,  823,
+     143,  181,  796,   58,    0,  116,  117,   72,   73,  163,   42,   74,   75,   76,   77,  190,
+     204,  846,  242,  837,   33,  194,  208,   34,   78,   79,   99,  131,  177,  195,  199,  223,
+     230,  799,  811,  812,  233,    3,   10,   80,   81,  160,  161,  205,  845,    0,   82,   21,
+      32,   80,   83,  205,  241,  824,  825,  826,  845,  189,   18,  752,    6,   27,   50,   51,
+     146,  221,  224,  803,  804,  805,  807,  808,  809,  810,   84,   85,   86,  147,  188,  750,
+     832,  183,    7,    9,   66,   75,   87,   88,   89,   90,   91,   92,   93,  159,  171,  172,
+     235,  848,   64,  119,  784,    0,   16,   43,   82,   94,  137,  219,  243,  813,  814,   27,
+      51,   77,   95,  155,  156,  164,  184,  197,  205,  755,  805,  808,  811,  812,  813,  814,
+     815,  828,  829,  832,  833,  846,   44,   45,   69,   98,  129,  174,  216,  782,   96,   97,
+      98,  123,  792,  800,  816,   17,   46,  113,  126,   25,   99,  127,   52,  163,  783,   47,
+       2,    3,   11,   13,   14,   26,   27,   31,   34,   37,   48,   54,   66,   68,   69,   75,
+      76,   79,   80,  101,  102,  121,  124,  127,  130,  133,  139,  143,  146,  152,  157,  161,
+     164,  169,  180,  181,  186,  194,  196,  200,  201,  203,  205,  215,  218,  225,  239,  245,
+     756,  767,  768,  771,  772,  773,  774,  775,  776,  779,  780,  781,  782,  795,  796,  811,
+     812,  843,  845,   60,   83,  115,  124,  125,  152,    4,    8,   42,   51,   53,   57,   61,
+      62,   96,  100,  103,  109,  130,  142,  143,  159,  178,  204,  205,  215,  216,  218,  228,
+     234,  239,  747,  758,  759,  762,  763,  766,  768,  770,  772,  775,  776,  777,  778,  781,
+     783,  784,  795,  796,  801,  802,  803,  805,  808,  809,  845,  846,  224,   77,  126,  187,
+     198,  240,  764,    9,  160,  161,   15,   72,   58,  217,  789,    7,   30,   44,   50,  156,
+     174,  212,  219,  749,  810,  220,  246,  820,  821,   10,   17,   23,   27,   31,   32,   35,
+      45,   47,   61,   62,   66,   70,   73,   91,   92,   98,  101,  102,  126,  129,  138,  169,
+     171,  174,  184,  185,  186,  187,  188,  189,  190,  192,  193,  199,  207,  210,  216,  224,
+     231,  233,  236,  241,  750,  751,  773,  774,  785,  797,  818,  823,  824,  825,  826,  828,
+     829,  830,  831,  832,  840,  848,  850,   69,  181,  183,  773,  774,  827,  174,  193,  799,
+     847,  138,  150,  187,   32,   58,  103,  104,  105,  115,  175,  232,  241,  755,  765,  766,
+     789,  806,  819,  824,  825,  826,  838,    0,    1,   29,   31,   32,   41,   46,   47,   52,
+      70,   71,   92,   95,  103,  106,  107,  137,  163,  164,  167,  185,  202,  205,  211,  217,
+     225,  227,  228,  236,  237,  241,  242,  766,  822,  823,  824,  825,  826,  833,  837,  838,
+     839,  840,  845,  848,  849,  850,   31,   32,   67,   77,   94,   96,  108,  118,  127,  139,
+     140,  169,  175,  185,  214,  218,  232,  233,  234,  744,  750,  751,  772,  802,  838,  850,
+      21,  140,  162,  762,  763,  770,   26,   58,  134,  239,  773,  774,  775,  776,  789,  790,
+     216,  791,  841,  842,   22,   42,   65,   66,  137,  773,  774,   15,  109,  110,  211,  835,
+     836,   50,  239,  111,  190,   60,   72,  217,  823,   47,   70,  112,  116,  117,  215,   96,
+     113,  208,   47,  114,  222,  226,  840,  189,  113,   35,  115,  167,  185,  200,  217,  233,
+     237,  841,  842,   70,  822,  823,  847,  227,   98,  116,  117,  249,  250,  757,  758,  759,
+     760,  762,  763,  792,  231,  228,  118,  119,  784,    4,   31,   32,   41,   42,   62,   77,
+      96,  164,  169,  181,  190,  192,  202,  211,  215,  239,  241,  243,  755,  768,  775,  776,
+     802,  824,  825,  826,  835,  836,  838,  846,   98,  103,  129,  130,  143,  216,  218,  241,
+     757,  759,  760,  763,  774,  776,  778,  805,  812,  814,    1,    6,    7,   18,   20,   29,
+      32,   33,   41,   46,   47,   52,   70,   71,   73,   85,   89,   95,  100,  103,  105,  120,
+     121,  132,  133,  137,  155,  156,  158,  163,  164,  168,  176,  202,  205,  208,  211,  212,
+     214,  219,  222,  228,  236,  239,  241,  242,  251,  752,  753,  755,  766,  769,  770,  775,
+     776,  815,  816,  822,  823,  824,  825,  826,  833,  838,  839,  840,  845,  846,  849,  850,
+       2,  211,  834,  836,   95,  134,  144,  777,  778,  833,   44,   50,  106,  122,  123,  156,
+     157,  169,  184,  189,  197,  198,  220,  754,  762,  763,  770,  797,  810,  820,  828,  829,
+       3,   21,   34,   13,   22,   26,   42,   47,   51,   57,   62,  103,  124,  125,  126,  127,
+     130,  135,  146,  174,  203,  215,  216,  218,  239,  242,  758,  759,  762,  763,  766,  768,
+     770,  772,  773,  774,  775,  776,  777,  778,  781,  783,  784,  803,  805,  808,  809,  837,
+     840,  103,  216,   70,  163,  822,  823,    7,   50,  137,  156,  197,  242,  810,  816,  837,
+      48,   87,  187,  200,  201,  202,  783,   83,  136,  128,  186,  229,  773,  774,   65,   70,
+     823,   76,   96,  108,  236,  800,  850,   50,  120,  178,  193,  770,  786,  847,   16,   41,
+      46,   59,   70,   81,   89,  106,  109,  129,  130,  131,  132,  133,  134,  135,  136,  137,
+     138,  139,  140,  141,  151,  164,  166,  170,  180,  190,  192,  203,  211,  779,  780,  781,
+     788,  793,  794,  813,  814,  818,  823,  830,  831,  835,  836,   37,   48,   79,  128,  150,
+     245,  246,  811,  812,   95,  833,    4,   11,   38,  142,  193,  210,  227,  234,  244,  747,
+      61,   62,  103,  143,  152,  187,  232,  236,  766,  795,  796,  850,  129,  805,  810,    4,
+      49,   51,  144,  145,  146,  147,  148,  149,  150,  191,  202,  220,  762,  763,  770,  777,
+     778,  803,  805,  820,  821,   24,  151,  189,  828,  829,  826,   10,   27,   28,   35,   39,
+      45,   70,   75,   82,   86,   93,   95,   98,  129,  145,  152,  153,  164,  170,  184,  188,
+     210,  216,  240,  242,  764,  773,  774,  819,  823,  832,  833,  837,   74,   75,   76,   77,
+     188,  190,  193,  832,  846,  847,    1,    5,    9,   27,   29,   31,   32,   36,   41,   46,
+      47,   52,   70,   71,   73,   85,   95,   97,  100,  101,  102,  105,  137,  155,  156,  158,
+     163,  164,  176,  182,  185,  187,  188,  193,  202,  205,  211,  212,  214,  219,  224,  228,
+     230,  236,  241,  242,  752,  753,  755,  815,  816,  822,  823,  824,  825,  826,  832,  833,
+     836,  837,  838,  839,  840,  845,  846,  847,  849,  850,   33,   66,   76,   91,   92,  102,
+     143,  147,  154,  155,  156,  157,  158,  171,  174,  185,  188,  195,  198,  231,  239,  251,
+     775,  776,  787,  795,  796,  797,  815,  832,  848,    6,    7,   18,   47,   50,   51,   98,
+      99,  146,  199,  223,  233,  236,  752,  792,  803,  804,  805,  807,  808,  809,  810,  840,
+     850,    0,    2,   11,   23,   27,   61,   62,   68,  127,  130,  138,  139,  157,  159,  160,
+     161,  162,  169,  180,  183,  201,  218,  224,  225,  227,  232,  233,  234,  744,  771,  772,
+     779,  780,  781,  785,  827,  843,  850,  208,  798,   73,   85,   59,  151,  116,  122,  163,
+     164,  165,  192,  236,  250,  755,  760,  780,  781,  850,   90,  126,    8,    9,   10,   42,
+     147,  148,  156,  184,  185,  186,  187,  188,  189,  190,  818,  828,  829,  830,  831,  832,
+     846,  238,   81,  114,  218,  771,  772,    4,   54,  191,  790,  224,   31,   47,   51,  149,
+     762,  763,  770,  803,  805,  839,   37,   92,  189,  810,  829,   71,   51,  103,  106,  130,
+     143,  216,  218,  234,  758,  759,  762,  763,  766,  772,  773,  774,  775,  776,  777,  778,
+     781,  796,  803,  805,  808,  809,  221,   58,  789,   52,  222,    6,   26,   48,   76,   96,
+     144,  146,  163,  176,  202,  239,  773,  774,  775,  776,  777,  778,  800,  816,   48,   49,
+      61,   62,  166,  180,  193,  202,  203,  233,  847,   38,   50,   51,   68,   78,   95,   97,
+      98,  102,  122,  130,  143,  145,  146,  147,  148,  157,  181,  183,  187,  198,  202,  220,
+     223,  773,  774,  779,  780,  781,  792,  795,  796,  803,  804,  805,  807,  808,  809,  810,
+     819,  827,  833,   38,   52,  190,  831,   69,  762,  763,  770,    5,   31,   49,   63,   65,
+      66,   77,   80,  112,  116,  117,  149,  163,  164,  165,  169,  177,  199,  205,  220,  236,
+     249,  250,  755,  757,  758,  759,  760,  762,  763,  780,  781,  790,  820,  821,  845,  850,
+      19,   27,   47,   49,   53,  228,  769,  839,  843,   28,  123,  141,  753,  789,   29,   60,
+      77,   87,  117,  128,  204,  205,  206,  236,  249,  757,  845,  846,  850,   27,  144,  200,
+     201,  777,  778,  783,  150,   98,  129,  236,  804,  820,  850,  110,  154,  167,  168,  169,
+     170,  171,  172,  190,  207,  797,  745,  120,   40,   87,  173,  193,  762,  763,  770,  847,
+     847,  174,   69,  174,  175,  187,  838,  220,  762,  763,  770,  773,  774,  749,   76,  176,
+     177,  199,  174,   56,  193,  761,  847,   64,   42,   51,   57,   62,  103,  130,  171,  178,
+     215,  216,  218,  239,  745,  746,  758,  759,  762,  763,  766,  768,  770,  772,  775,  776,
+     777,  778,  781,  783,  784,  803,  805,  808,  809,  826,   46,   47,   70,  143,  156,  185,
+     228,  234,  236,  242,  762,  763,  770,  796,  823,  825,  837,  839,  850,  179,   70,  823,
+     241,  814,  745,  746,  826,   66,  138,  150,  187,   29,  184,  185,  186,  187,  188,  240,
+     750,  798,  818,  821,  828,  830,  832,    5,   13,   17,   30,   42,   50,   51,   74,   83,
+      97,  103,  104,  107,  143,  148,  159,  172,  181,  194,  198,  215,  231,  232,  243,  762,
+     763,  765,  766,  768,  770,  796,  803,  805,  810,  817,    9,   15,   19,  196,    8,  252,
+     846,   40,   95,  112,  211,  786,  833,  834,  836,   42,   51,   57,   58,   62,   67,   75,
+      76,   77,   84,   85,   86,  103,  105,  116,  117,  130,  187,  188,  190,  199,  215,  216,
+     218,  239,  249,  250,  750,  755,  757,  758,  759,  760,  762,  763,  766,  768,  770,  772,
+     775,  776,  777,  778,  781,  783,  784,  789,  803,  805,  806,  808,  809,  819,  827,  832,
+     846,  163,   10,   32,   80,  119,  128,  190,  205,  241,  784,  824,  825,  826,  845,    3,
+       4,   14,   31,   32,   34,   42,   46,   53,   66,   67,   77,  115,  124,  139,  140,  161,
+     164,  169,  178,  192,  193,  204,  208,  210,  215,  224,  234,  239,  747,  750,  751,  767,
+     768,  773,  774,  775,  776,  799,   35,   59,  189,  190,  226,  227,  228,  761,  829,  831,
+     841,  842,  155,  156,  214,  815,   11,   24,   81,  788,   77,   90,  164,  175,  243,  755,
+     838,  846,   38,   49,   54,   71,  143,  147,  149,  180,  795,  796,    5,   31,   58,   77,
+     148,  169,  187,  198,  111,  137,  116,  138,  164,  177,  178,  189,  190,  250,  755,  760,
+     780,  781,  818,  828,  829,  830,  831,   12,   20,   33,   36,   56,  153,  173,  181,  235,
+     756,  787,  165,  182,   31,   99,  169,  790,   27,    4,   33,   65,   92,   98,  129,  184,
+     185,  186,  187,  188,  189,  190,  191,  192,  193,  194,  205,  243,  247,  828,  829,  830,
+     831,  832,  845,  848,  131,  753,   90,   96,  111,  148,  195,  196,  197,  800,   18,   31,
+      32,  137,   76,  102,  133,  143,  181,  198,  199,  225,  756,  795,  796,  818,    1,   29,
+      32,   41,   46,   47,   52,   70,   71,   95,  103,  106,  137,  163,  164,  200,  201,  202,
+     205,  211,  228,  236,  241,  242,  745,  746,  749,  766,  783,  822,  823,  824,  825,  826,
+     833,  838,  839,  840,  845,  849,  850,   27,  843,   35,   77,  117,  123,  202,  203,  204,
+     205,  206,  249,  757,  845,  846,  207,  107,  208,   33,   92,  181,  756,  848,    0,   13,
+      14,   46,   53,   68,   96,  113,  119,  126,  143,  167,  169,  217,  220,  227,  234,  237,
+     243,  744,  773,  774,  790,  796,  797,  798,  799,  820,  821,  850,  206,  209,  210,  211,
+     834,  836,   28,  212,  213,  214,  785,  215,  767,  768,    0,    8,   25,   53,   83,   96,
+     108,  113,  119,  136,  139,  143,  167,  179,  216,  217,  218,  227,  234,  237,  744,  750,
+     751,  771,  772,  773,  774,  791,  796,  846,  850,  175,  838,   31,   58,   77,   89,   96,
+     126,  141,  143,  147,  169,  218,  220,  232,  233,  234,  243,  744,  772,  773,  774,  789,
+     796,  818,  820,  850,   51,   69,   77,  116,  117,  123,  127,  155,  156,  164,  189,  204,
+     205,  206,  219,  249,  250,  755,  757,  760,  780,  781,  805,  808,  811,  812,  813,  814,
+     815,  828,  829,  832,  845,  846,    8,    9,   10,   31,   32,   51,   54,   60,   94,   96,
+     115,  138,  140,  156,  169,  181,  190,  220,  762,  763,  770,  773,  774,  785,  797,  801,
+     802,  803,  805,  820,  821,  830,  831,  846,  236,  753,  850,   46,  764,   31,   66,   68,
+      77,  169,  178,  193,  221,  222,  223,  224,  847,   13,   14,   42,   67,  224,  799,   28,
+     148,  185,  141,  185,  177,  225,  226,  227,  228,  229,  238,  242,  837,  841,  121,   96,
+     802,  214,  157,  158,  171,    9,   63,   66,   87,   88,   89,  127,  159,  171,  172,  235,
+     238,  844,   12,   42,   51,   55,   57,   62,  103,  130,  215,  216,  218,  239,  758,  759,
+     762,  763,  766,  768,  770,  772,  775,  776,  777,  778,  781,  783,  784,  803,  805,  808,
+     809,  186,    9,   24,  194,  206,  209,   90,  138,  150,  162,  178,  187,  239,  251,  775,
+     776,  183,  847,  177,  230,  235,    7,   66,   75,   91,   92,  171,  848,  231,  748,   34,
+      21,   33,   36,   99,  183,  218,  225,  232,  233,  234,  242,  744,  772,  787,  827,  837,
+     850,   87,   35,   36,   97,  128,  139,  140,  153,  210,  226,  227,  228,  235,  773,  774,
+     788,  817,  841,   13,   14,   20,   33,   56,  140,  181,  236,  241,  247,  248,  756,  825,
+      25,   60,   77,  117,  204,  205,  206,  236,  242,  249,  757,  837,  845,  846,  850,   29,
+     229,  118,  128,   93,  237,   65,   96,  144,  200,  211,  229,  238,  239,  775,  776,  777,
+     778,  783,  801,  802,  834,  836,   29,   40,  134,  201,  239,  251,  775,  776,  786,  847,
+      26,   27,   32,   50,   70,  121,  185,  188,  240,  241,  764,  773,  774,  810,  823,  824,
+     825,  826,  832,   58,  789,  790,   96,  790,  800,   28,  118,  165,  182,  212,  216,  242,
+     754,  785,  791,  837,  213,  243,  246,  798,  842,  132,  205,  214,  845,  784,  128,  142,
+      93,  114,  125,  151,  197,  211,  244,  835,  836,  841,  842,  236,  850,   41,   76,  141,
+      56,   64,  119,  215,  767,  768,  784,  133,  119,  784,   50,  113,  150,  218,  245,  771,
+     772,  799,  806,  810,  237,   15,   22,   27,   57,  158,  214,  782,   30,  212,  246,  842,
+     119,  239,  251,  775,  776,   50,  810,    9,   27,   35,   53,  116,  117,  164,  171,  198,
+     205,  239,  242,  799,  845,  848,  215,  130,  143,  218,  757,  759,  760,  763,  774,  776,
+     778,  812,   92,  745,  215,  232,  768
+};
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""Writes countryalias.h, the table gbmunge looks country texts up in before
+matching them to the closest name, with a bigram index to that matching. Keys are the names of countrycodes.h,
+their ISO 3166 alpha-3 and alpha-2 codes and the aliases below, all folded
+to lower case, and map to an index into country[]. When keys collide the
+first one wins, in that order, so names which are already in country[]
+resolve as they always have.
+
+usage: python3 countryalias.py > countryalias.h   (or make aliases)"""
+
+import os
+import re
+import sys
+
+# ISO 3166 alpha-2 codes of the alpha-3 codes in countrycodes.h. NA, for
+# Namibia, is left out as it more often stands for a missing value
+ISO2 = {
+    "AFG": "AF", "ALA": "AX", "ALB": "AL", "DZA": "DZ", "ASM": "AS", "AND": "AD",
+    "AGO": "AO", "AIA": "AI", "ATA": "AQ", "ATG": "AG", "ARG": "AR", "ARM": "AM",
+    "ABW": "AW", "AUS": "AU", "AUT": "AT", "AZE": "AZ", "BHS": "BS", "BHR": "BH",
+    "BGD": "BD", "BRB": "BB", "BLR": "BY", "BEL": "BE", "BLZ": "BZ", "BEN": "BJ",
+    "BMU": "BM", "BTN": "BT", "BOL": "BO", "BIH": "BA", "BWA": "BW", "BVT": "BV",
+    "BRA": "BR", "IOT": "IO", "VGB": "VG", "BRN": "BN", "BGR": "BG", "BFA": "BF",
+    "BDI": "BI", "KHM": "KH", "CMR": "CM", "CAN": "CA", "CPV": "CV", "CYM": "KY",
+    "CAF": "CF", "TCD": "TD", "CHL": "CL", "CHN": "CN", "CXR": "CX", "CCK": "CC",
+    "COL": "CO", "COM": "KM", "COG": "CG", "COD": "CD", "COK": "CK", "CRI": "CR",
+    "HRV": "HR", "CUB": "CU", "CYP": "CY", "CZE": "CZ", "CIV": "CI", "DNK": "DK",
+    "DJI": "DJ", "DMA": "DM", "DOM": "DO", "ECU": "EC", "EGY": "EG", "SLV": "SV",
+    "GNQ": "GQ", "ERI": "ER", "EST": "EE", "ETH": "ET", "FLK": "FK", "FRO": "FO",
+    "FJI": "FJ", "FIN": "FI", "FRA": "FR", "GUF": "GF", "PYF": "PF", "ATF": "TF",
+    "GAB": "GA", "GMB": "GM", "GEO": "GE", "DEU": "DE", "GHA": "GH", "GIB": "GI",
+    "GRC": "GR", "GRL": "GL", "GRD": "GD", "GLP": "GP", "GUM": "GU", "GTM": "GT",
+    "GGY": "GG", "GIN": "GN", "GNB": "GW", "GUY": "GY", "HTI": "HT", "HMD": "HM",
+    "VAT": "VA", "HND": "HN", "HKG": "HK", "HUN": "HU", "ISL": "IS", "IND": "IN",
+    "IDN": "ID", "IRN": "IR", "IRQ": "IQ", "IRL": "IE", "IMN": "IM", "ISR": "IL",
+    "ITA": "IT", "JAM": "JM", "JPN": "JP", "JEY": "JE", "JOR": "JO", "KAZ": "KZ",
+    "KEN": "KE", "KIR": "KI", "PRK": "KP", "KOR": "KR", "KWT": "KW", "KGZ": "KG",
+    "LAO": "LA", "LVA": "LV", "LBN": "LB", "LSO": "LS", "LBR": "LR", "LBY": "LY",
+    "LIE": "LI", "LTU": "LT", "LUX": "LU", "MAC": "MO", "MKD": "MK", "MDG": "MG",
+    "MWI": "MW", "MYS": "MY", "MDV": "MV", "MLI": "ML", "MLT": "MT", "MHL": "MH",
+    "MTQ": "MQ", "MRT": "MR", "MUS": "MU", "MYT": "YT", "MEX": "MX", "FSM": "FM",
+    "MDA": "MD", "MCO": "MC", "MNG": "MN", "MNE": "ME", "MSR": "MS", "MAR": "MA",
+    "MOZ": "MZ", "MMR": "MM", "NRU": "NR", "NPL": "NP", "NLD": "NL", "ANT": "AN",
+    "NCL": "NC", "NZL": "NZ", "NIC": "NI", "NER": "NE", "NGA": "NG", "NIU": "NU",
+    "NFK": "NF", "MNP": "MP", "NOR": "NO", "OMN": "OM", "PAK": "PK", "PLW": "PW",
+    "PSE": "PS", "PAN": "PA", "PNG": "PG", "PRY": "PY", "PER": "PE", "PHL": "PH",
+    "PCN": "PN", "POL": "PL", "PRT": "PT", "PRI": "PR", "QAT": "QA", "ROU": "RO",
+    "RUS": "RU", "RWA": "RW", "REU": "RE", "SHN": "SH", "KNA": "KN", "LCA": "LC",
+    "SPM": "PM", "VCT": "VC", "BLM": "BL", "MAF": "MF", "WSM": "WS", "SMR": "SM",
+    "STP": "ST", "SAU": "SA", "SEN": "SN", "SRB": "RS", "SYC": "SC", "SLE": "SL",
+    "SGP": "SG", "SVK": "SK", "SVN": "SI", "SLB": "SB", "SOM": "SO", "ZAF": "ZA",
+    "SGS": "GS", "SSD": "SS", "ESP": "ES", "LKA": "LK", "SDN": "SD", "SUR": "SR",
+    "SJM": "SJ", "SWZ": "SZ", "SWE": "SE", "CHE": "CH", "SYR": "SY", "TWN": "TW",
+    "TJK": "TJ", "TZA": "TZ", "THA": "TH", "TLS": "TL", "TGO": "TG", "TKL": "TK",
+    "TON": "TO", "TTO": "TT", "TUN": "TN", "TUR": "TR", "TKM": "TM", "TCA": "TC",
+    "TUV": "TV", "UGA": "UG", "UKR": "UA", "ARE": "AE", "GBR": "GB", "USA": "US",
+    "URY": "UY", "UMI": "UM", "UZB": "UZ", "VUT": "VU", "VEN": "VE", "VNM": "VN",
+    "VIR": "VI", "WLF": "WF", "ESH": "EH", "YEM": "YE", "ZMB": "ZM", "ZWE": "ZW",
+}
+
+# Other spellings seen in /country and /geo_loc_name, by the name they stand for
+ALIASES = {
+    "United States of America": ["United States", "U.S.A.", "U.S.", "America"],
+    "United Kingdom": ["UK", "U.K.", "Great Britain", "Britain", "England", "Scotland",
+                       "Wales", "Northern Ireland"],
+    "Russian Federation": ["Russia"],
+    "Korea (South)": ["Korea, South", "Republic of Korea", "Korea, Republic of"],
+    "Korea (North)": ["Korea, North", "DPRK", "Democratic People's Republic of Korea",
+                      "Korea, Democratic People's Republic of"],
+    "Viet Nam": ["Vietnam"],
+    "Iran, Islamic Republic of": ["Iran", "Islamic Republic of Iran"],
+    "Syrian Arab Republic (Syria)": ["Syria", "Syrian Arab Republic"],
+    "Lao PDR": ["Laos", "Lao People's Democratic Republic"],
+    "Tanzania, United Republic of": ["Tanzania", "United Republic of Tanzania"],
+    "Bolivia": ["Plurinational State of Bolivia", "Bolivia, Plurinational State of"],
+    "Venezuela (Bolivarian Republic)": ["Bolivarian Republic of Venezuela",
+                                        "Venezuela, Bolivarian Republic of"],
+    "Moldova": ["Republic of Moldova", "Moldova, Republic of"],
+    "Macedonia, Republic of": ["Macedonia", "North Macedonia", "Republic of North Macedonia"],
+    "Czech Republic": ["Czechia"],
+    "Slovakia": ["Slovak Republic"],
+    "Kyrgyzstan": ["Kyrgyz Republic"],
+    "Swaziland": ["Eswatini"],
+    "Cape Verde": ["Cabo Verde"],
+    "Brunei Darussalam": ["Brunei"],
+    "Myanmar": ["Burma"],
+    "Côte d'Ivoire": ["Cote d'Ivoire", "Ivory Coast"],
+    "Taiwan, Republic of China": ["Taiwan"],
+    "Hong Kong, SAR China": ["Hong Kong"],
+    "Macao, SAR China": ["Macao", "Macau"],
+    "Micronesia, Federated States of": ["Micronesia", "Federated States of Micronesia"],
+    "Palestinian Territory": ["Palestine", "West Bank", "Gaza Strip"],
+    "Holy See (Vatican City State)": ["Holy See", "Vatican", "Vatican City"],
+    "Democratic Republic of the Congo": ["Democratic Republic of Congo", "DR Congo",
+                                         "Congo, Democratic Republic of the", "Zaire"],
+    "Congo (Brazzaville)": ["Congo", "Republic of the Congo", "Republic of Congo",
+                            "Congo-Brazzaville"],
+    "Gambia": ["The Gambia", "Gambia, The"],
+    "Bahamas": ["The Bahamas", "Bahamas, The"],
+    "Netherlands": ["The Netherlands", "Holland"],
+    "Netherlands Antilles": ["Curacao", "Sint Maarten", "Bonaire"],
+    "Timor-Leste": ["Timor Leste", "East Timor"],
+    "Falkland Islands (Malvinas)": ["Falkland Islands", "Falkland Islands (Islas Malvinas)"],
+    "Virgin Islands, US": ["Virgin Islands", "US Virgin Islands", "U.S. Virgin Islands"],
+    "Réunion": ["Reunion"],
+    "Saint-Barthélemy": ["Saint Barthelemy", "Saint-Barthelemy"],
+    "Saint-Martin (French part)": ["Saint Martin", "Saint-Martin"],
+    "Saint Vincent and Grenadines": ["Saint Vincent and the Grenadines"],
+    "Heard and Mcdonald Islands": ["Heard Island and McDonald Islands"],
+    "Svalbard and Jan Mayen Islands": ["Svalbard", "Jan Mayen", "Svalbard and Jan Mayen"],
+    "Wallis and Futuna Islands": ["Wallis and Futuna"],
+    "Pitcairn": ["Pitcairn Islands"],
+    "Cocos (Keeling) Islands": ["Cocos Islands", "Keeling Islands"],
+    "Turkey": ["Turkiye", "Türkiye"],
+    "Bosnia and Herzegovina": ["Bosnia"],
+    "United Arab Emirates": ["UAE"],
+    "South Georgia and the South Sandwich Islands": ["South Georgia and South Sandwich Islands"],
+    "French Southern Territories": ["French Southern and Antarctic Lands"],
+    "Sao Tome and Principe": ["São Tomé and Príncipe"],
+    "Guinea-Bissau": ["Guinea Bissau"],
+    "Aland Islands": ["Åland Islands"],
+    "US Minor Outlying Islands": ["United States Minor Outlying Islands"],
+}
+
+BIGRAMBITS = 10     # Lower case letter pairs do not collide
+SLOTBITS = 11
+SLOTNUM = 1 << SLOTBITS
+BUCKETNUM = 512
+
+
+def fold(sName):
+    return sName.strip().lower() if sName.isascii() else \
+        "".join(c.lower() if c.isascii() else c for c in sName.strip())
+
+
+def fnv(sKey):
+    iHash = 2166136261
+    for c in sKey.encode():
+        iHash = ((iHash ^ c) * 16777619) & 0xffffffff
+    return iHash
+
+
+def bigram(a, b):
+    return (a * 31 + b) & ((1 << BIGRAMBITS) - 1)
+
+
+def slot(sKey, iDisplace):
+    iMix = ((fnv(sKey) >> 9) ^ (iDisplace * 2654435761)) & 0xffffffff
+    return ((iMix * 2246822519) & 0xffffffff) >> (32 - SLOTBITS)
+
+
+def cString(sKey):
+    return '"%s"' % sKey.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def main():
+    sSource = open(os.path.join(os.path.dirname(os.path.abspath(__file__)), "countrycodes.h"),
+                   encoding="utf-8").read()
+    sNames, sCodes = sSource.split("char *countrycode")
+    asNames = re.findall(r'"((?:[^"\\]|\\.)*)"', sNames)
+    asCodes = re.findall(r'"((?:[^"\\]|\\.)*)"', sCodes)
+
+    atKeys = []     # (folded key, country index, comment)
+    dSeen = {}
+
+    def add(sKey, iCountry, sWhat):
+        sKey = fold(sKey)
+        if sKey and sKey not in dSeen:
+            dSeen[sKey] = iCountry
+            atKeys.append((sKey, iCountry, sWhat))
+
+    for i, sName in enumerate(asNames):
+        add(sName, i, "name")
+    for i, sCode in enumerate(asCodes):
+        add(sCode, i, "ISO3")
+    for i, sCode in enumerate(asCodes):
+        if sCode in ISO2:
+            add(ISO2[sCode], i, "ISO2")
+    for sName, asAliases in ALIASES.items():
+        for sAlias in asAliases:
+            add(sAlias, asNames.index(sName), "alias")
+
+    # Hash and displace: the low bits of a key's hash pick its bucket, and the
+    # bucket's displacement is mixed into the rest to land each key on a free slot
+    dBuckets = {}
+    for i, (sKey, _, _) in enumerate(atKeys):
+        dBuckets.setdefault(fnv(sKey) % BUCKETNUM, []).append(i)
+    aiSlots = [0] * SLOTNUM
+    aiDisplace = [0] * BUCKETNUM
+    for iBucket in sorted(dBuckets, key=lambda b: -len(dBuckets[b])):
+        for iDisplace in range(65536):
+            aiTry = [slot(atKeys[i][0], iDisplace) for i in dBuckets[iBucket]]
+            if len(set(aiTry)) == len(aiTry) and all(aiSlots[s] == 0 for s in aiTry):
+                for i, s in zip(dBuckets[iBucket], aiTry):
+                    aiSlots[s] = i + 1
+                aiDisplace[iBucket] = iDisplace
+                break
+        else:
+            sys.exit("No displacement for bucket %d, make SLOTNUM larger" % iBucket)
+
+    # Names and aliases are what fuzzy matching compares against; a bigram
+    # inverted index of them gives each a bound on its edit distance
+    aiFuzzy = [i for i, (_, _, sKind) in enumerate(atKeys) if sKind in ("name", "alias")]
+    aaiPostings = [[] for _ in range(1 << BIGRAMBITS)]
+    for i in aiFuzzy:
+        acKey = atKeys[i][0].encode()
+        for iBigram in sorted(set(bigram(acKey[j], acKey[j + 1]) for j in range(len(acKey) - 1))):
+            aaiPostings[iBigram].append(i)
+    aiStart = [0]
+    for aiPosting in aaiPostings:
+        aiStart.append(aiStart[-1] + len(aiPosting))
+
+    def rows(aiValues, iWidth=16):
+        return ",\n".join("    " + ", ".join("%4d" % v for v in aiValues[i:i + iWidth])
+                          for i in range(0, len(aiValues), iWidth))
+
+    out = sys.stdout
+    out.write("/* Generated by countryalias.py from countrycodes.h, do not edit */\n\n")
+    out.write("#define ALIASNUM %d\n#define ALIASSLOTBITS %d\n#define ALIASBUCKETNUM %d\n"
+              "#define ALIASLEN %d\n#define FUZZYNUM %d\n#define BIGRAMBITS %d\n\n"
+              % (len(atKeys), SLOTBITS, BUCKETNUM, max(len(k.encode()) for k, _, _ in atKeys),
+                 len(aiFuzzy), BIGRAMBITS))
+    out.write("/* Names, ISO3 and ISO2 codes and aliases in lower case, with their index into country[] */\n")
+    out.write("static const struct tAlias {\n    const char *sKey;\n    short iCountry;\n    short iLen;\n} atAliases[ALIASNUM] = {\n")
+    sWhat = None
+    for sKey, iCountry, sKind in atKeys:
+        if sKind != sWhat:
+            sWhat = sKind
+            out.write("    /* %s */\n" % {"name": "Names", "ISO3": "ISO 3166 alpha-3 codes",
+                                          "ISO2": "ISO 3166 alpha-2 codes", "alias": "Aliases"}[sKind])
+        out.write("    {%s, %d, %d}, /* %s */\n" % (cString(sKey), iCountry, len(sKey.encode()), asNames[iCountry]))
+    out.write("};\n\n")
+    out.write("/* Displacement of each bucket of the FNV-1a hash */\n")
+    out.write("static const unsigned short aiAliasDisplace[ALIASBUCKETNUM] = {\n%s\n};\n\n" % rows(aiDisplace))
+    out.write("/* 1 + the index into atAliases[] of the key in each slot, 0 for none */\n")
+    out.write("static const unsigned short aiAliasSlot[1 << ALIASSLOTBITS] = {\n%s\n};\n\n" % rows(aiSlots))
+    out.write("/* Indexes into atAliases[] of the names and aliases, which fuzzy matching compares against */\n")
+    out.write("static const unsigned short aiFuzzy[FUZZYNUM] = {\n%s\n};\n\n" % rows(aiFuzzy))
+    out.write("/* The names and aliases with a bigram (a, b) hashing to (31a + b) mod 2^BIGRAMBITS,\n"
+              "   from aiBigramList[aiBigramStart[h]] up to aiBigramList[aiBigramStart[h + 1]] */\n")
+    out.write("static const unsigned short aiBigramStart[(1 << BIGRAMBITS) + 1] = {\n%s\n};\n\n" % rows(aiStart))
+    out.write("static const unsigned short aiBigramList[%d] = {\n%s\n};\n" % (aiStart[-1], rows(sum(aaiPostings, []))))
+
+
+if __name__ == "__main__":
+    main()
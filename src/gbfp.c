@@ -5,6 +5,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <limits.h>
+#include <zlib.h>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -22,69 +23,295 @@
     #include <regex.h>
     #include <unistd.h>
     #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <pthread.h>
+#endif
+
+/* Vector kernels need GCC or clang on x86, which pick them at run time */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && ! defined(_WIN32) && ! defined(GB_NOSIMD)
+    #define GB_X86SIMD
+    #include <immintrin.h>
 #endif
  
 #include "gbfp.h"
+#include "qualifiers.h"
 
 const char sVer[] = "0.6.1";
 const char sNorBase[] = "ACGTRYMKWSBDHVNacgtrymkwsbdhvn";
 const char sComBase[] = "TGCAYRKMWSVHDBNtgcayrkmwsvhdbn";
 const unsigned int iBaseLen = 30;
-char sTempLine[LINELEN] = {'\0',};
-regex_t ptRegExLocus;
-regex_t ptRegExOneLine;
-regex_t ptRegExAccession;
-regex_t ptRegExVersion;
-regex_t ptRegExRegion;
-regex_t ptRegExGI;
+
+/* A slab of arena memory, followed by its data */
+typedef struct tChunk {
+    struct tChunk *ptNext;
+    size_t lSize;
+    size_t lUsed;
+} gb_chunk;
+
+/* Bump allocator holding everything parsed for a record. The newest chunk
+   is first; a reset folds all chunks into one slab of their total size, so
+   a reused arena soon serves whole records without calling malloc */
+struct tArena {
+    gb_chunk *ptChunks;
+    gb_reader *ptReader;    /* Takes the arena back when its record is freed */
+    gb_arena *ptPrev;       /* Arenas of the reader's records which are still alive */
+    gb_arena *ptNext;
+};
+
+/* Text which is built up line by line; it keeps its memory when emptied,
+   so that it can be reused for the next record */
+typedef struct tBuffer {
+    gb_string sStr;
+    size_t lLen;
+    size_t lMem;
+} gb_buffer;
+
+/* Regular expressions for header lines the scanners cannot make sense of */
+#define REGEXLOCUS          0
+#define REGEXONELINE        1
+#define REGEXACCESSION      2
+#define REGEXVERSION        3
+#define REGEXREGION         4
+#define REGEXGI             5
+#define REGEXNUM            6
+
+/* Everything a parse writes besides the record, one per reader, so that
+   readers on separate threads share nothing. The regular expressions are
+   compiled the first time a line needs them */
+typedef struct tParser {
+    regex_t atRegEx[REGEXNUM];
+    unsigned int iCompiled;     /* Bit per compiled regular expression */
+    gb_buffer tLocation;        /* Scratch space for feature locations */
+    gb_buffer tQualifier;       /* and for the qualifiers of the copying mode */
+} gb_parser;
+
+/* The lines of a single record, from its LOCUS line to its '//' line.
+   putLine() pushes the last line back */
+typedef struct tCursor {
+    const char *sPos;
+    const char *sEnd;
+    unsigned int iFlags;
+    unsigned int iFields;   /* GB_ALLFIELDS, or those asked for with selectGBFF() */
+    const char **psFeatures; /* Feature keys to parse, NULL for all */
+    gb_filter pFilter;      /* Asked whether to go on past the header fields */
+    void *pFilterArg;
+    int iFiltered;          /* The record was passed over by pFilter */
+    gb_arena *ptArena;
+    gb_parser *ptParser;
+} gb_cursor;
+
+/* Compressed input, inflated into the reader's buffer as it is parsed */
+typedef struct tGzip {
+    z_stream tStream;       /* Inflates members which are not BGZF blocks */
+    char *sIn;              /* Compressed input, read or mapped */
+    size_t lInLen;
+    size_t lInPos;
+    size_t lInMem;          /* Size of the input buffer, 0 when sIn is mapped */
+    int iInEOF;             /* No more compressed input can be read */
+    int iBGZF;              /* Inflating BGZF blocks, possibly on several threads */
+    int iStream;            /* tStream has been initialized */
+} gb_gzip;
+
+/* A BGZF block and where its data goes in the reader's buffer */
+typedef struct tBGZFBlock {
+    const unsigned char *sIn;
+    unsigned int iInLen;
+    unsigned int iLen;
+    unsigned long lCRC;
+    size_t lOut;
+    int iError;
+} gb_bgzfblock;
+
+/* BGZF blocks shared out among inflating threads */
+typedef struct tBGZFBatch {
+    gb_bgzfblock *ptBlocks;
+    char *sOut;
+    unsigned int iBlockNum;
+    unsigned int iStep;
+    unsigned int iFirst;
+} gb_bgzfbatch;
 
 #define skipSpace( x ) for (; isspace(*x); x++)
-#define putLine( x ) strcpy(sTempLine, x)
+#define putLine( x, y ) ((y)->sPos = (x)->sStr)
 #define getLine_w_rtrim( x, y ) \
     getLine(x, y); \
-    rtrim(x)
-
-/* Initializes regular expression */
-void initRegEx(void) {
-    const char sLocus[] = "^LOCUS +([a-z|A-Z|0-9|_]+) +([0-9]+) bp +([ss-|ds-|ms-]*[a-z|A-Z| ]+) ([a-z| ]{8}) ([A-Z| ]{3}) ([0-9]+-[A-Z]+-[0-9]+)";
-    const char sOneLine[] = "^ *([A-Z]+) +(.+)";
-    const char sAccession[] = "^ACCESSION +([a-z|A-Z|0-9|_]+) ?";
-    const char sRegion[] = " +REGION: ?([0-9]+)\\.\\.([0-9]+)";
-    const char sVersion[] = "^VERSION +([a-z|A-Z|0-9|_.]+) ?";
-    const char sGI[] = " +GI: ?([0-9]+)";
- 
-    regcomp(&ptRegExLocus, sLocus, REG_EXTENDED | REG_ICASE);
-    regcomp(&ptRegExOneLine, sOneLine, REG_EXTENDED | REG_ICASE);
-    regcomp(&ptRegExAccession, sAccession, REG_EXTENDED | REG_ICASE);
-    regcomp(&ptRegExVersion, sVersion, REG_EXTENDED | REG_ICASE);
-    regcomp(&ptRegExRegion, sRegion, REG_EXTENDED | REG_ICASE);
-    regcomp(&ptRegExGI, sGI, REG_EXTENDED | REG_ICASE);
+    rtrimSpan(x)
+#define isTerminator( x ) ((x)->lLen >= 2 && *((x)->sStr) == '/' && *((x)->sStr + 1) == '/')
+
+static const char *asRegEx[REGEXNUM] = {
+    "^LOCUS +([a-z|A-Z|0-9|_]+) +([0-9]+) bp +([ss-|ds-|ms-]*[a-z|A-Z| ]+) ([a-z| ]{8}) ([A-Z| ]{3}) ([0-9]+-[A-Z]+-[0-9]+)",
+    "^ *([A-Z]+) +(.+)",
+    "^ACCESSION +([a-z|A-Z|0-9|_]+) ?",
+    "^VERSION +([a-z|A-Z|0-9|_.]+) ?",
+    " +REGION: ?([0-9]+)\\.\\.([0-9]+)",
+    " +GI: ?([0-9]+)"
+};
+
+static void initParser(gb_parser *ptParser) {
+    ptParser->iCompiled = 0;
+    ptParser->tLocation.sStr = NULL;
+    ptParser->tLocation.lLen = ptParser->tLocation.lMem = 0;
+    ptParser->tQualifier.sStr = NULL;
+    ptParser->tQualifier.lLen = ptParser->tQualifier.lMem = 0;
+}
+
+static void freeParser(gb_parser *ptParser) {
+    int i;
+
+    for (i = 0; i < REGEXNUM; i++) {
+        if (ptParser->iCompiled & (1 << i)) regfree(ptParser->atRegEx + i);
+    }
+    ptParser->iCompiled = 0;
+    free(ptParser->tLocation.sStr);
+    free(ptParser->tQualifier.sStr);
+}
+
+/* Compiles a regular expression when it is first used */
+static regex_t *getRegEx(gb_parser *ptParser, int iRegEx) {
+    if ((ptParser->iCompiled & (1 << iRegEx)) == 0) {
+        regcomp(ptParser->atRegEx + iRegEx, asRegEx[iRegEx], REG_EXTENDED | REG_ICASE);
+        ptParser->iCompiled |= 1 << iRegEx;
+    }
+
+    return ptParser->atRegEx + iRegEx;
+}
+
+#define ARENAALIGN          16
+#define alignArena( x ) (((x) + ARENAALIGN - 1) & ~((size_t) ARENAALIGN - 1))
+
+static gb_chunk *newChunk(size_t lSize, gb_chunk *ptNext) {
+    gb_chunk *ptChunk;
+
+    ptChunk = malloc(alignArena(sizeof(gb_chunk)) + lSize);
+    ptChunk->ptNext = ptNext;
+    ptChunk->lSize = lSize;
+    ptChunk->lUsed = 0;
+
+    return ptChunk;
+}
+
+#define chunkData( x ) ((char *) (x) + alignArena(sizeof(gb_chunk)))
+
+/* Creates an arena whose first slab should hold a record of lSizeHint bytes */
+static gb_arena *newArena(size_t lSizeHint) {
+    gb_arena *ptArena;
+
+    ptArena = malloc(sizeof(gb_arena));
+    ptArena->ptChunks = newChunk(alignArena((lSizeHint > ARENAMINLEN) ? lSizeHint : ARENAMINLEN), NULL);
+    ptArena->ptReader = NULL;
+    ptArena->ptPrev = NULL;
+    ptArena->ptNext = NULL;
+
+    return ptArena;
+}
+
+/* Allocates memory from the arena */
+static void *allocArena(gb_arena *ptArena, size_t lLen) {
+    gb_chunk *ptChunk = ptArena->ptChunks;
+    void *pMemory;
+
+    lLen = alignArena(lLen);
+    if (ptChunk->lSize - ptChunk->lUsed < lLen) {
+        ptChunk = newChunk((lLen > ptChunk->lSize * 2) ? lLen : ptChunk->lSize * 2, ptChunk);
+        ptArena->ptChunks = ptChunk;
+    }
+
+    pMemory = chunkData(ptChunk) + ptChunk->lUsed;
+    ptChunk->lUsed += lLen;
+
+    return pMemory;
+}
+
+/* Resizes an allocation. The newest allocation grows or shrinks in place,
+   others are copied and the old space is left to the next reset */
+static void *growArena(gb_arena *ptArena, void *pOld, size_t lOldLen, size_t lNewLen) {
+    gb_chunk *ptChunk = ptArena->ptChunks;
+    void *pNew;
+
+    if (pOld == NULL) return allocArena(ptArena, lNewLen);
+
+    if ((char *) pOld + alignArena(lOldLen) == chunkData(ptChunk) + ptChunk->lUsed &&
+        (size_t) ((char *) pOld - chunkData(ptChunk)) + alignArena(lNewLen) <= ptChunk->lSize) {
+        ptChunk->lUsed = ((char *) pOld - chunkData(ptChunk)) + alignArena(lNewLen);
+        return pOld;
+    }
+
+    pNew = allocArena(ptArena, lNewLen);
+    memcpy(pNew, pOld, (lOldLen < lNewLen) ? lOldLen : lNewLen);
+
+    return pNew;
+}
+
+/* Copies a piece of text into the arena as a string */
+static gb_string copySpan(gb_arena *ptArena, const char *sStr, unsigned long lLen) {
+    gb_string sString;
+
+    sString = allocArena(ptArena, lLen + 1);
+    memcpy(sString, sStr, lLen);
+    *(sString + lLen) = '\0';
+
+    return sString;
 }
 
-void freeRegEx(void) {
-    regfree(&ptRegExLocus);
-    regfree(&ptRegExOneLine);
-    regfree(&ptRegExAccession);
-    regfree(&ptRegExVersion);
-    regfree(&ptRegExRegion);
-    regfree(&ptRegExGI);
+/* Releases all allocations at once */
+static void resetArena(gb_arena *ptArena) {
+    gb_chunk *ptChunk, *ptNext;
+    size_t lSize = 0;
+
+    if (ptArena->ptChunks->ptNext == NULL) {
+        ptArena->ptChunks->lUsed = 0;
+        return;
+    }
+
+    for (ptChunk = ptArena->ptChunks; ptChunk != NULL; ptChunk = ptNext) {
+        ptNext = ptChunk->ptNext;
+        lSize += ptChunk->lSize;
+        free(ptChunk);
+    }
+    ptArena->ptChunks = newChunk(lSize, NULL);
+}
+
+static void freeArena(gb_arena *ptArena) {
+    gb_chunk *ptChunk, *ptNext;
+
+    for (ptChunk = ptArena->ptChunks; ptChunk != NULL; ptChunk = ptNext) {
+        ptNext = ptChunk->ptNext;
+        free(ptChunk);
+    }
+    free(ptArena);
 }
 
-/* Forward declaration for freeSingleGBData */
-static void freeSingleGBData(gb_data *ptGBData);
+/* Appends text to a buffer, which stays '\0' terminated */
+static void appendBuffer(gb_buffer *ptBuffer, const char *sStr, size_t lLen) {
+    if (ptBuffer->lLen + lLen + 1 > ptBuffer->lMem) {
+        if (ptBuffer->lMem == 0) ptBuffer->lMem = INITBUFFERLEN;
+        while (ptBuffer->lLen + lLen + 1 > ptBuffer->lMem) ptBuffer->lMem *= 2;
+        ptBuffer->sStr = realloc(ptBuffer->sStr, ptBuffer->lMem);
+    }
+
+    memcpy(ptBuffer->sStr + ptBuffer->lLen, sStr, lLen);
+    ptBuffer->lLen += lLen;
+    *(ptBuffer->sStr + ptBuffer->lLen) = '\0';
+}
 
 /* Removes white spaces at end of a string */
 static void rtrim(gb_string sLine) {
     register int i;
-    
+
     for (i = (strlen(sLine) - 1); i >= 0; i--) if (! isspace(*(sLine + i))) break;
     *(sLine + i + 1) = '\0';
 }
 
+/* Removes white spaces at end of a line */
+static void rtrimSpan(gb_span *ptLine) {
+    while (ptLine->lLen > 0 && isspace(*(ptLine->sStr + ptLine->lLen - 1))) ptLine->lLen--;
+}
+
 /* Removes a specific character at end of a string */
 static void removeRChar(gb_string sLine, char cRemove) {
     register int i;
-    
+
     for (i = (strlen(sLine) - 1); i >= 0; i--) {
         if (sLine[i] == cRemove) {
             sLine[i] = '\0';
@@ -93,81 +320,198 @@ static void removeRChar(gb_string sLine, char cRemove) {
     }
 }
 
-/* Gets a line from either the line buffer or the file */
-static gb_string getLine(gb_string sLine, FILE *FSeqFile) {
-    gb_string sReturn;
+/* Gets the next line of the record, without its line terminator */
+static int getLine(gb_span *ptLine, gb_cursor *ptCursor) {
+    const char *sNewLine;
+
+    ptLine->sStr = ptCursor->sPos;
+    ptLine->lLen = 0;
 
-    if (*sTempLine != '\0') {
-        sReturn = strcpy(sLine, sTempLine);
-        *sTempLine = '\0';
+    if (ptCursor->sPos >= ptCursor->sEnd) return 0;
+
+    sNewLine = memchr(ptCursor->sPos, '\n', ptCursor->sEnd - ptCursor->sPos);
+    if (sNewLine == NULL) {
+        ptLine->lLen = ptCursor->sEnd - ptCursor->sPos;
+        ptCursor->sPos = ptCursor->sEnd;
     } else {
-        sReturn = fgets(sLine, LINELEN, FSeqFile);
+        ptLine->lLen = sNewLine - ptCursor->sPos;
+        ptCursor->sPos = sNewLine + 1;
     }
 
-    return sReturn;
+    return 1;
 }
 
-/* Concatenates lines which start with specific white spaces */
-static gb_string joinLines(FILE *FSeqFile, unsigned int iSpaceLen) {
-    char sLine[LINELEN];
-    gb_string sTemp, sJoinedLine;
+/* Copies a line into a string buffer of LINELEN characters */
+static gb_string copyLine(gb_string sLine, const gb_span *ptLine) {
+    unsigned long lLen = (ptLine->lLen < LINELEN) ? ptLine->lLen : LINELEN - 1;
+
+    memcpy(sLine, ptLine->sStr, lLen);
+    *(sLine + lLen) = '\0';
 
-    sJoinedLine = malloc(sizeof(char) * LINELEN);
+    return sLine;
+}
 
-    getLine_w_rtrim(sLine, FSeqFile);
-    strcpy(sJoinedLine, sLine + iSpaceLen);
+/* Points a span at a string */
+static void setSpan(gb_span *ptSpan, gb_string sString) {
+    ptSpan->sStr = sString;
+    ptSpan->lLen = (sString == NULL) ? 0 : strlen(sString);
+}
 
-    while (fgets(sLine, LINELEN, FSeqFile)) {
-        sTemp = sLine;
-        skipSpace(sTemp);
-        if ((sTemp - sLine) < iSpaceLen) break;
-        rtrim(sTemp);
-        sJoinedLine = strcat(sJoinedLine, sTemp - 1); /* '- 1' in order to insert a space character at the juncation */
+/* Concatenates lines which start with specific white spaces */
+static gb_string joinLines(gb_cursor *ptCursor, unsigned int iSpaceLen) {
+    gb_span tLine;
+    const char *sTemp;
+    gb_string sJoinedLine;
+    unsigned long lJoinedLen, lJoinedMem;
+
+    getLine_w_rtrim(&tLine, ptCursor);
+    lJoinedLen = (tLine.lLen > iSpaceLen) ? tLine.lLen - iSpaceLen : 0;
+    lJoinedMem = lJoinedLen * 4 + 1;
+    sJoinedLine = allocArena(ptCursor->ptArena, sizeof(char) * lJoinedMem);
+    memcpy(sJoinedLine, tLine.sStr + tLine.lLen - lJoinedLen, lJoinedLen);
+
+    while (getLine(&tLine, ptCursor)) {
+        for (sTemp = tLine.sStr; sTemp < tLine.sStr + tLine.lLen && isspace(*sTemp); sTemp++);
+        if ((unsigned long) (sTemp - tLine.sStr) < iSpaceLen) {
+            putLine(&tLine, ptCursor);
+            break;
+        }
+        rtrimSpan(&tLine);
+        if (tLine.lLen == 0) continue;
+        sTemp--; /* '- 1' in order to insert a space character at the juncation */
+        if (lJoinedLen + (tLine.sStr + tLine.lLen - sTemp) + 1 > lJoinedMem) {
+            while (lJoinedLen + (tLine.sStr + tLine.lLen - sTemp) + 1 > lJoinedMem) lJoinedMem *= 2;
+            sJoinedLine = growArena(ptCursor->ptArena, sJoinedLine, lJoinedLen, sizeof(char) * lJoinedMem);
+        }
+        memcpy(sJoinedLine + lJoinedLen, sTemp, tLine.sStr + tLine.lLen - sTemp);
+        lJoinedLen += tLine.sStr + tLine.lLen - sTemp;
     }
 
-    putLine(sLine);
+    *(sJoinedLine + lJoinedLen) = '\0';
 
-    return realloc(sJoinedLine, sizeof(char) * (strlen(sJoinedLine) + 1));
+    return growArena(ptCursor->ptArena, sJoinedLine, lJoinedLen + 1, sizeof(char) * (lJoinedLen + 1));
 }
 
-static int parseLocus(gb_string sLocusStr, gb_data *ptGBData) {
-    /*    
-    01-05      'LOCUS'
-    06-12      spaces
-    13-28      Locus name
-    29-29      space
-    30-40      Length of sequence, right-justified
-    41-41      space
-    42-43      bp
-    44-44      space
-    45-47      spaces, ss- (single-stranded), ds- (double-stranded), or
-               ms- (mixed-stranded)
-    48-53      NA, DNA, RNA, tRNA (transfer RNA), rRNA (ribosomal RNA),
-               mRNA (messenger RNA), uRNA (small nuclear RNA), snRNA,
-               snoRNA. Left justified.
-    54-55      space
-    56-63      'linear' followed by two spaces, or 'circular'
-    64-64      space
-    65-67      The division code (see Section 3.3)
-    68-68      space
-    69-79      Date, in the form dd-MMM-yyyy (e.g., 15-MAR-1991)
-    */
-    
+/* Checks that a line starts with a keyword */
+static int hasPrefix(const gb_span *ptLine, const char *sPrefix, unsigned long lPrefixLen) {
+    return ptLine->lLen >= lPrefixLen && memcmp(ptLine->sStr, sPrefix, lPrefixLen) == 0;
+}
+
+/* Checks whether a line contains a word anywhere */
+static int hasWord(const gb_span *ptLine, const char *sWord) {
+    const char *sPos, *sEnd;
+    size_t lWordLen = strlen(sWord);
+
+    if (ptLine->lLen < lWordLen) return 0;
+    sEnd = ptLine->sStr + ptLine->lLen - lWordLen;
+    for (sPos = ptLine->sStr; (sPos = memchr(sPos, *sWord, sEnd - sPos + 1)) != NULL; sPos++)
+        if (memcmp(sPos, sWord, lWordLen) == 0) return 1;
+
+    return 0;
+}
+
+/* Reads the decimal number at sPos, returning where it stops */
+static const char *scanNumber(const char *sPos, const char *sEnd, unsigned long *plNumber) {
+    unsigned long lNumber = 0;
+
+    for (; sPos < sEnd && isdigit(*sPos); sPos++) lNumber = lNumber * 10 + (*sPos - '0');
+    *plNumber = lNumber;
+
+    return sPos;
+}
+
+#define isIdChar( x ) (isalnum(x) || (x) == '_' || (x) == '|')
+
+/* Copies a span into a fixed size field and trims it like rtrim() */
+static void copyField(gb_string sField, unsigned int iSize, const char *sStr, unsigned long lLen) {
+    if (lLen > iSize) lLen = iSize;
+    while (lLen > 0 && isspace(*(sStr + lLen - 1))) lLen--;
+    memcpy(sField, sStr, lLen);
+    *(sField + lLen) = '\0';
+}
+
+/* Scans a LOCUS line in a single pass. The layout is walked token by token
+   from the left up to 'bp', and from the right for the date, division and
+   topology, which have fixed widths; the molecule type is what lies
+   between. This gives the same fields as the LOCUS regular expression without having to
+   trust the columns below, which long locus names shift. Returns 1 for
+   lines it cannot vouch for, so that the regular expression decides */
+static int scanLocus(const gb_span *ptLocus, gb_data *ptGBData, unsigned int iFlags) {
+    const char *sPos = ptLocus->sStr + 5;
+    const char *sEnd = ptLocus->sStr + ptLocus->lLen;
+    const char *sName, *sNameEnd, *sType, *sDate, *sTemp;
+    unsigned long lLength;
+
+    if (! hasPrefix(ptLocus, "LOCUS", 5)) return 1;
+    while (sEnd > sPos && isspace(*(sEnd - 1))) sEnd--;
+
+    /* Locus name */
+    for (sName = sPos; sName < sEnd && *sName == ' '; sName++);
+    if (sName == sPos) return 1;
+    for (sNameEnd = sName; sNameEnd < sEnd && isIdChar(*sNameEnd); sNameEnd++);
+    if (sNameEnd == sName) return 1;
+
+    /* Length and 'bp' */
+    for (sPos = sNameEnd; sPos < sEnd && *sPos == ' '; sPos++);
+    if (sPos == sNameEnd) return 1;
+    sTemp = sPos;
+    sPos = scanNumber(sPos, sEnd, &lLength);
+    if (sPos == sTemp || sEnd - sPos < 4 || *sPos != ' ' || tolower(*(sPos + 1)) != 'b' || tolower(*(sPos + 2)) != 'p' || *(sPos + 3) != ' ') return 1;
+    for (sType = sPos + 3; sType < sEnd && *sType == ' '; sType++);
+
+    /* Date, as digits-letters-digits, then ' DIV topology ' to its left */
+    for (sDate = sEnd; sDate > sType && *(sDate - 1) != ' '; sDate--);
+    for (sTemp = sDate; sTemp < sEnd && isdigit(*sTemp); sTemp++);
+    if (sTemp == sDate || sTemp == sEnd || *sTemp++ != '-') return 1;
+    for (sPos = sTemp; sTemp < sEnd && isalpha(*sTemp); sTemp++);
+    if (sTemp == sPos || sTemp == sEnd || *sTemp++ != '-') return 1;
+    for (sPos = sTemp; sTemp < sEnd && isdigit(*sTemp); sTemp++);
+    if (sTemp == sPos || sTemp != sEnd) return 1;
+
+    if (sDate - sType < 1 + 13) return 1;
+    sPos = sDate - 14; /* ' ' topology(8) ' ' division(3) ' ' */
+    if (*sPos != ' ' || *(sPos + 9) != ' ' || *(sPos + 13) != ' ') return 1;
+    for (sTemp = sPos + 1; sTemp < sPos + 9; sTemp++) if (! isalpha(*sTemp) && *sTemp != ' ' && *sTemp != '|') return 1;
+    for (sTemp = sPos + 10; sTemp < sPos + 13; sTemp++) if (! isalpha(*sTemp) && *sTemp != ' ' && *sTemp != '|') return 1;
+    if (sPos == sType) return 1;
+    for (sTemp = sType; sTemp < sPos; sTemp++) if (! isalpha(*sTemp) && *sTemp != ' ' && *sTemp != '|' && *sTemp != '-') return 1;
+
+    copyField(ptGBData->sLocusName, LOCUSLEN, sName, sNameEnd - sName);
+    ptGBData->lLength = lLength;
+    copyField(ptGBData->sType, TYPELEN, sType, sPos - sType);
+    copyField(ptGBData->sTopology, TOPOLOGYSTRLEN, sPos + 1, 8);
+    copyField(ptGBData->sDivisionCode, DIVISIONCODELEN, sPos + 10, 3);
+    copyField(ptGBData->sDate, DATESTRLEN, sDate, sEnd - sDate);
+
+    if (iFlags & GB_ZEROCOPY) {
+        ptGBData->tLocusName.sStr = sName;
+        ptGBData->tLocusName.lLen = sNameEnd - sName;
+    } else {
+        setSpan(&(ptGBData->tLocusName), ptGBData->sLocusName);
+    }
+
+    return 0;
+}
+
+/* Regular expression fallback of scanLocus() */
+static int matchLocus(gb_parser *ptParser, const gb_span *ptLocus, gb_data *ptGBData, unsigned int iFlags) {
+    char sLocusStr[LINELEN];
     char sTemp[LINELEN];
     unsigned int i, iErr, iLen;
-    
+
     regmatch_t ptRegMatch[7];
-    
+
     struct tData {
         char cType;
         void *Pointer;
+        unsigned int iSize;
     } tDatas[] = {
-        {STRING, NULL},
-        {LONG, NULL},
-        {STRING, NULL},
-        {STRING, NULL},
-        {STRING, NULL},
-        {STRING, NULL}};
+        {STRING, NULL, LOCUSLEN},
+        {LONG, NULL, 0},
+        {STRING, NULL, TYPELEN},
+        {STRING, NULL, TOPOLOGYSTRLEN},
+        {STRING, NULL, DIVISIONCODELEN},
+        {STRING, NULL, DATESTRLEN}};
 
     tDatas[0].Pointer = ptGBData->sLocusName;
     tDatas[1].Pointer = &(ptGBData->lLength);
@@ -175,14 +519,16 @@ static int parseLocus(gb_string sLocusStr, gb_data *ptGBData) {
     tDatas[3].Pointer = ptGBData->sTopology;
     tDatas[4].Pointer = ptGBData->sDivisionCode;
     tDatas[5].Pointer = ptGBData->sDate;
-    
+
+    copyLine(sLocusStr, ptLocus);
     rtrim(sLocusStr);
-        
-    if ((iErr = regexec(&ptRegExLocus, sLocusStr, 7, ptRegMatch, 0)) == 0) {
+
+    if ((iErr = regexec(getRegEx(ptParser, REGEXLOCUS), sLocusStr, 7, ptRegMatch, 0)) == 0) {
         for (i = 0; i < 6; i++) {
             iLen = ptRegMatch[i + 1].rm_eo - ptRegMatch[i + 1].rm_so;
             switch (tDatas[i].cType) {
             case STRING:
+                if (iLen > tDatas[i].iSize) iLen = tDatas[i].iSize;
                 memcpy(tDatas[i].Pointer, (sLocusStr + ptRegMatch[i + 1].rm_so), iLen);
                 *((gb_string) tDatas[i].Pointer + iLen) = '\0';
                 rtrim((gb_string) tDatas[i].Pointer);
@@ -196,8 +542,14 @@ static int parseLocus(gb_string sLocusStr, gb_data *ptGBData) {
                 perror("Unknown Data Type!");
             }
         }
+        if (iFlags & GB_ZEROCOPY) {
+            ptGBData->tLocusName.sStr = ptLocus->sStr + ptRegMatch[1].rm_so;
+            ptGBData->tLocusName.lLen = ptRegMatch[1].rm_eo - ptRegMatch[1].rm_so;
+        } else {
+            setSpan(&(ptGBData->tLocusName), ptGBData->sLocusName);
+        }
     } else {
-        /* regerror(iErr, &ptRegExLocus, sTemp, LINELEN); */
+        /* regerror(iErr, getRegEx(ptParser, REGEXLOCUS), sTemp, LINELEN); */
         /* perror("Invalid LOCUS line!"); */
         fprintf(stderr, "Invalid LOCUS line! - '%s\n'", sLocusStr);
         return 1;
@@ -205,102 +557,262 @@ static int parseLocus(gb_string sLocusStr, gb_data *ptGBData) {
     return 0;
 }
 
-static void parseDef(FILE *FSeqFile, gb_data *ptGBData) {
-    char sLine[LINELEN];
-    regmatch_t ptRegMatch[3];
+static int parseLocus(gb_parser *ptParser, gb_span *ptLocus, gb_data *ptGBData, unsigned int iFlags) {
+    /*
+    01-05      'LOCUS'
+    06-12      spaces
+    13-28      Locus name
+    29-29      space
+    30-40      Length of sequence, right-justified
+    41-41      space
+    42-43      bp
+    44-44      space
+    45-47      spaces, ss- (single-stranded), ds- (double-stranded), or
+               ms- (mixed-stranded)
+    48-53      NA, DNA, RNA, tRNA (transfer RNA), rRNA (ribosomal RNA),
+               mRNA (messenger RNA), uRNA (small nuclear RNA), snRNA,
+               snoRNA. Left justified.
+    54-55      space
+    56-63      'linear' followed by two spaces, or 'circular'
+    64-64      space
+    65-67      The division code (see Section 3.3)
+    68-68      space
+    69-79      Date, in the form dd-MMM-yyyy (e.g., 15-MAR-1991)
+    */
+
+    if (scanLocus(ptLocus, ptGBData, iFlags) == 0) return 0;
+
+    return matchLocus(ptParser, ptLocus, ptGBData, iFlags);
+}
 
-    getLine_w_rtrim(sLine, FSeqFile);
+/* Scans a '  KEYWORD   value' line for its value, as its regular expression does */
+static int scanOneLine(const gb_span *ptLine, gb_span *ptValue) {
+    const char *sPos = ptLine->sStr;
+    const char *sEnd = ptLine->sStr + ptLine->lLen;
+    const char *sTemp;
 
-    regexec(&ptRegExOneLine, sLine, 3, ptRegMatch, 0);
-    ptGBData->sDef = strdup(sLine + ptRegMatch[2].rm_so);
+    for (; sPos < sEnd && *sPos == ' '; sPos++);
+    for (sTemp = sPos; sPos < sEnd && isalpha(*sPos); sPos++);
+    if (sPos == sTemp || sPos == sEnd || *sPos != ' ') return 1;
+    for (; sPos < sEnd && *sPos == ' '; sPos++);
+    if (sPos == sEnd) return 1;
+
+    ptValue->sStr = sPos;
+    ptValue->lLen = sEnd - sPos;
+
+    return 0;
 }
 
-static void parseKeywords(FILE *FSeqFile, gb_data *ptGBData) {
+/* Regular expression fallback of scanOneLine() */
+static int matchOneLine(gb_parser *ptParser, const gb_span *ptLine, gb_span *ptValue) {
     char sLine[LINELEN];
     regmatch_t ptRegMatch[3];
 
-    getLine_w_rtrim(sLine, FSeqFile);
+    copyLine(sLine, ptLine);
+    if (regexec(getRegEx(ptParser, REGEXONELINE), sLine, 3, ptRegMatch, 0) != 0) return 1;
+
+    ptValue->sStr = ptLine->sStr + ptRegMatch[2].rm_so;
+    ptValue->lLen = ptRegMatch[2].rm_eo - ptRegMatch[2].rm_so;
+
+    return 0;
+}
+
+/* Gets the value of the next one-line field, NULL when there is none */
+static gb_string parseOneLine(gb_cursor *ptCursor) {
+    gb_span tLine, tValue;
+
+    getLine_w_rtrim(&tLine, ptCursor);
+
+    if (scanOneLine(&tLine, &tValue) != 0 && matchOneLine(ptCursor->ptParser, &tLine, &tValue) != 0) return NULL;
+
+    return copySpan(ptCursor->ptArena, tValue.sStr, tValue.lLen);
+}
+
+static void parseDef(gb_cursor *ptCursor, gb_data *ptGBData) {
+    ptGBData->sDef = parseOneLine(ptCursor);
+}
+
+static void parseKeywords(gb_cursor *ptCursor, gb_data *ptGBData) {
+    ptGBData->sKeywords = parseOneLine(ptCursor);
+}
+
+/* Scans 'KEYWORD   id' and the ' NAME: ...' text that may follow the id. The
+   id ends at the returned pointer, NULL when the line has to be matched */
+static const char *scanIdLine(const gb_span *ptLine, const char *sKeyword, unsigned long lKeywordLen, int iDots, gb_span *ptId) {
+    const char *sPos = ptLine->sStr + lKeywordLen;
+    const char *sEnd = ptLine->sStr + ptLine->lLen;
+    const char *sTemp;
+
+    if (! hasPrefix(ptLine, sKeyword, lKeywordLen)) return NULL;
+    for (sTemp = sPos; sPos < sEnd && *sPos == ' '; sPos++);
+    if (sPos == sTemp) return NULL;
+    for (sTemp = sPos; sPos < sEnd && (isIdChar(*sPos) || (iDots && *sPos == '.')); sPos++);
+    if (sPos == sTemp || (sPos < sEnd && *sPos != ' ')) return NULL;
+
+    ptId->sStr = sTemp;
+    ptId->lLen = sPos - sTemp;
+
+    return sPos;
+}
+
+/* Finds ' +NAME: ?' after sPos, returning the text after it, NULL if absent */
+static const char *scanTag(const char *sPos, const char *sEnd, const char *sTag, unsigned long lTagLen) {
+    for (; sPos + lTagLen < sEnd; sPos++) {
+        if (*sPos == ' ' && memcmp(sPos + 1, sTag, lTagLen) == 0) {
+            sPos += 1 + lTagLen;
+            if (sPos < sEnd && *sPos == ' ') sPos++;
+            return sPos;
+        }
+    }
+
+    return NULL;
+}
 
-    regexec(&ptRegExOneLine, sLine, 3, ptRegMatch, 0);
-    ptGBData->sKeywords = strdup(sLine + ptRegMatch[2].rm_so);
+/* Stores the accession or version id, which is a span or a copy */
+static void setId(gb_arena *ptArena, gb_string *psId, gb_span *ptId, const char *sStr, unsigned long lLen, unsigned int iFlags) {
+    if (iFlags & GB_ZEROCOPY) {
+        ptId->sStr = sStr;
+        ptId->lLen = lLen;
+    } else {
+        *psId = copySpan(ptArena, sStr, lLen);
+        setSpan(ptId, *psId);
+    }
 }
 
-static void parseAccession(FILE *FSeqFile, gb_data *ptGBData) {
+/* Regular expression fallback of the ACCESSION scanner */
+static void matchAccession(gb_parser *ptParser, const gb_span *ptLine, gb_data *ptGBData, unsigned int iFlags) {
     char sLine[LINELEN];
+    gb_string sRest;
     regmatch_t ptRegMatch[3];
 
-    getLine_w_rtrim(sLine, FSeqFile);
+    copyLine(sLine, ptLine);
+
+    if (regexec(getRegEx(ptParser, REGEXACCESSION), sLine, 2, ptRegMatch, 0) == 0) {
+        setId(ptGBData->ptArena, &(ptGBData->sAccession), &(ptGBData->tAccession),
+            ptLine->sStr + ptRegMatch[1].rm_so, ptRegMatch[1].rm_eo - ptRegMatch[1].rm_so, iFlags);
+    } else return;
+
+    /* Offsets of the second match are relative to the rest of the line */
+    sRest = sLine + ptRegMatch[1].rm_eo + 1;
+    if ((unsigned long) ptRegMatch[1].rm_eo < ptLine->lLen &&
+        regexec(getRegEx(ptParser, REGEXREGION), sRest, 3, ptRegMatch, 0) == 0) {
+        *(sRest + ptRegMatch[1].rm_eo) = '\0';
+        (ptGBData->lRegion)[0] = atol(sRest + ptRegMatch[1].rm_so);
+        *(sRest + ptRegMatch[2].rm_eo) = '\0';
+        (ptGBData->lRegion)[1] = atol(sRest + ptRegMatch[2].rm_so);
+    }
+}
+
+static void parseAccession(gb_cursor *ptCursor, gb_data *ptGBData) {
+    gb_span tLine, tId;
+    const char *sPos, *sEnd, *sTemp;
+    unsigned long lStart, lEnd;
+
+    getLine_w_rtrim(&tLine, ptCursor);
 
-    if (regexec(&ptRegExAccession, sLine, 2, ptRegMatch, 0) == 0) {
-        *(sLine + ptRegMatch[1].rm_eo) = '\0';
-        ptGBData->sAccession = strdup(sLine + ptRegMatch[1].rm_so);
+    if ((sPos = scanIdLine(&tLine, "ACCESSION", 9, 0, &tId)) == NULL) {
+        matchAccession(ptCursor->ptParser, &tLine, ptGBData, ptCursor->iFlags);
+        return;
     }
 
-    if (regexec(&ptRegExRegion, sLine + ptRegMatch[1].rm_eo + 1, 3, ptRegMatch, 0) == 0) {
-        *(sLine + ptRegMatch[1].rm_eo) = '\0';
-        (ptGBData->lRegion)[0] = atol(sLine + ptRegMatch[1].rm_so);
-        *(sLine + ptRegMatch[2].rm_eo) = '\0';
-        (ptGBData->lRegion)[1] = atol(sLine + ptRegMatch[2].rm_so);
+    /* ' REGION: 100..200' follows the accession of partial records */
+    sEnd = tLine.sStr + tLine.lLen;
+    if (sPos < sEnd && (sPos = scanTag(sPos + 1, sEnd, "REGION:", 7)) != NULL) {
+        sTemp = scanNumber(sPos, sEnd, &lStart);
+        if (sTemp == sPos || sEnd - sTemp < 3 || *sTemp != '.' || *(sTemp + 1) != '.' || scanNumber(sTemp + 2, sEnd, &lEnd) == sTemp + 2) {
+            matchAccession(ptCursor->ptParser, &tLine, ptGBData, ptCursor->iFlags);
+            return;
+        }
+        (ptGBData->lRegion)[0] = lStart;
+        (ptGBData->lRegion)[1] = lEnd;
     }
+
+    setId(ptGBData->ptArena, &(ptGBData->sAccession), &(ptGBData->tAccession), tId.sStr, tId.lLen, ptCursor->iFlags);
 }
 
-static void parseVersion(FILE *FSeqFile, gb_data *ptGBData) {
+/* Regular expression fallback of the VERSION scanner */
+static void matchVersion(gb_parser *ptParser, const gb_span *ptLine, gb_data *ptGBData, unsigned int iFlags) {
     char sLine[LINELEN];
+    gb_string sRest;
     regmatch_t ptRegMatch[2];
 
-    getLine_w_rtrim(sLine, FSeqFile);
+    copyLine(sLine, ptLine);
 
-    if (regexec(&ptRegExVersion, sLine, 2, ptRegMatch, 0) == 0) {
-        *(sLine + ptRegMatch[1].rm_eo) = '\0';
-        ptGBData->sVersion = strdup(sLine + ptRegMatch[1].rm_so);
-    }
-    if (regexec(&ptRegExGI, sLine + ptRegMatch[1].rm_eo + 1, 2, ptRegMatch, 0) == 0) {
-        *(sLine + ptRegMatch[1].rm_eo) = '\0';
-        ptGBData->sGI = strdup(sLine + ptRegMatch[1].rm_so);
+    if (regexec(getRegEx(ptParser, REGEXVERSION), sLine, 2, ptRegMatch, 0) == 0) {
+        setId(ptGBData->ptArena, &(ptGBData->sVersion), &(ptGBData->tVersion),
+            ptLine->sStr + ptRegMatch[1].rm_so, ptRegMatch[1].rm_eo - ptRegMatch[1].rm_so, iFlags);
+    } else return;
+
+    /* Offsets of the second match are relative to the rest of the line */
+    sRest = sLine + ptRegMatch[1].rm_eo + 1;
+    if ((unsigned long) ptRegMatch[1].rm_eo < ptLine->lLen &&
+        regexec(getRegEx(ptParser, REGEXGI), sRest, 2, ptRegMatch, 0) == 0) {
+        *(sRest + ptRegMatch[1].rm_eo) = '\0';
+        ptGBData->sGI = copySpan(ptGBData->ptArena, sRest + ptRegMatch[1].rm_so, strlen(sRest + ptRegMatch[1].rm_so));
     }
 }
 
-static void parseComment(FILE *FSeqFile, gb_data *ptGBData) {
-    ptGBData->sComment = joinLines(FSeqFile, 12);
-}
+static void parseVersion(gb_cursor *ptCursor, gb_data *ptGBData) {
+    gb_span tLine, tId;
+    const char *sPos, *sEnd, *sTemp;
 
-static void parseSource(FILE *FSeqFile, gb_data *ptGBData) {
-    char sLine[LINELEN];
-    regmatch_t ptRegMatch[3];
+    getLine_w_rtrim(&tLine, ptCursor);
 
-    getLine_w_rtrim(sLine, FSeqFile);
-    regexec(&ptRegExOneLine, sLine, 3, ptRegMatch, 0);
-    ptGBData->sSource = strdup(sLine + ptRegMatch[2].rm_so);
+    if ((sPos = scanIdLine(&tLine, "VERSION", 7, 1, &tId)) == NULL) {
+        matchVersion(ptCursor->ptParser, &tLine, ptGBData, ptCursor->iFlags);
+        return;
+    }
+
+    /* Older records carry '  GI:12345' after the version */
+    sEnd = tLine.sStr + tLine.lLen;
+    if (sPos < sEnd && (sPos = scanTag(sPos + 1, sEnd, "GI:", 3)) != NULL) {
+        for (sTemp = sPos; sTemp < sEnd && isdigit(*sTemp); sTemp++);
+        if (sTemp == sPos) {
+            matchVersion(ptCursor->ptParser, &tLine, ptGBData, ptCursor->iFlags);
+            return;
+        }
+        ptGBData->sGI = copySpan(ptGBData->ptArena, sPos, sTemp - sPos);
+    }
 
-    getLine_w_rtrim(sLine, FSeqFile);
-    regexec(&ptRegExOneLine, sLine, 3, ptRegMatch, 0);
-    ptGBData->sOrganism = strdup(sLine + ptRegMatch[2].rm_so);
+    setId(ptGBData->ptArena, &(ptGBData->sVersion), &(ptGBData->tVersion), tId.sStr, tId.lLen, ptCursor->iFlags);
+}
+
+static void parseComment(gb_cursor *ptCursor, gb_data *ptGBData) {
+    ptGBData->sComment = joinLines(ptCursor, 12);
+}
 
-    ptGBData->sLineage = joinLines(FSeqFile, 12);
+static void parseSource(gb_cursor *ptCursor, gb_data *ptGBData) {
+    ptGBData->sSource = parseOneLine(ptCursor);
+    ptGBData->sOrganism = parseOneLine(ptCursor);
+    ptGBData->sLineage = joinLines(ptCursor, 12);
 }
 
 #define processRef( x, y ) \
     y = NULL; \
-    getLine_w_rtrim(sLine, FSeqFile); \
-    putLine(sLine); \
-    if (strstr(sLine, x) != NULL) y = joinLines(FSeqFile, 12)
+    getLine_w_rtrim(&tLine, ptCursor); \
+    putLine(&tLine, ptCursor); \
+    if (hasWord(&tLine, x)) y = joinLines(ptCursor, 12)
 
-static void parseReference(FILE *FSeqFile, gb_data *ptGBData) {
-    char sLine[LINELEN];
-    regmatch_t ptRegMatch[3];
+static void parseReference(gb_cursor *ptCursor, gb_data *ptGBData) {
+    gb_span tLine, tValue;
     gb_reference *ptReferences = NULL;
     gb_reference *ptReference = NULL;
     unsigned int iReferenceNum = 0;
+    unsigned long lNum = 0;
 
     ptReferences = ptGBData->ptReferences;
     iReferenceNum = ptGBData->iReferenceNum;
 
-    ptReferences = realloc(ptReferences, sizeof(gb_reference) * (iReferenceNum + 1));
+    /* Room for INITREFERENCENUM references, doubled whenever it runs out */
+    if (iReferenceNum == 0 || (iReferenceNum >= INITREFERENCENUM && (iReferenceNum & (iReferenceNum - 1)) == 0))
+        ptReferences = growArena(ptCursor->ptArena, ptReferences, sizeof(gb_reference) * iReferenceNum,
+            sizeof(gb_reference) * ((iReferenceNum == 0) ? INITREFERENCENUM : iReferenceNum * 2));
     ptReference = ptReferences + iReferenceNum;
 
-    getLine_w_rtrim(sLine, FSeqFile);
-    regexec(&ptRegExOneLine, sLine, 3, ptRegMatch, 0);
-    ptReference->iNum = atoi(sLine + ptRegMatch[2].rm_so);
+    getLine_w_rtrim(&tLine, ptCursor);
+    if (scanOneLine(&tLine, &tValue) == 0 || matchOneLine(ptCursor->ptParser, &tLine, &tValue) == 0)
+        scanNumber(tValue.sStr, tValue.sStr + tValue.lLen, &lNum);
+    ptReference->iNum = lNum;
 
     processRef("  AUTHORS  ", ptReference->sAuthors);
     processRef("  CONSRTM  ", ptReference->sConsrtm);
@@ -374,7 +886,7 @@ static int convertPos2Num(gb_string sPositions, unsigned long *lStart, unsigned
 }
 
 /* Parsing a gb_string that contains gb_location information */
-static void parseLocation(gb_string sLocation, gb_feature *pFeature) {
+static void parseLocation(gb_arena *ptArena, gb_string sLocation, gb_feature *pFeature) {
     gb_string sTemp;
     gb_string sString = NULL;
     
@@ -397,7 +909,7 @@ static void parseLocation(gb_string sLocation, gb_feature *pFeature) {
 
     sTemp = sString - 1;
     while((sTemp = strchr((sTemp + 1), ','))) iLocationNum++;
-    pFeature->ptLocation = malloc(iLocationNum * sizeof(*(pFeature->ptLocation)));
+    pFeature->ptLocation = allocArena(ptArena, iLocationNum * sizeof(*(pFeature->ptLocation)));
 
     iLocationNum = 0;
     sLocation = strtok_r(sString, ",", &sTemp);
@@ -416,6 +928,40 @@ static void parseLocation(gb_string sLocation, gb_feature *pFeature) {
     pFeature->iLocationNum = iLocationNum;
 }
 
+/* The GB_QUAL_* key of a qualifier name, GB_QUAL_UNKNOWN if it has none */
+int qualifierKey(const char *sName, unsigned long lLen) {
+    unsigned long i;
+    unsigned int iHash = 2166136261U;
+    int iKey;
+
+    for (i = 0; i < lLen; i++) iHash = (iHash ^ (unsigned char) *(sName + i)) * 16777619U;
+
+    iKey = acQualSlot[(((iHash & 0xffffffffU) >> 8) + acQualDisplace[iHash % QUALBUCKETNUM]) & (QUALHASHLEN - 1)];
+    if (iKey == GB_QUAL_UNKNOWN || strncmp(asQualifiers[iKey - 1], sName, lLen) != 0 ||
+        *(asQualifiers[iKey - 1] + lLen) != '\0') return GB_QUAL_UNKNOWN;
+
+    return iKey;
+}
+
+/* The first qualifier of the feature with the given key, or NULL. Keys
+   the feature does not have are turned away by its bitmap */
+gb_qualifier *getQualifier(gb_feature *ptFeature, int iKey) {
+    gb_qualifier *ptQualifier;
+
+    if (iKey <= GB_QUAL_UNKNOWN || iKey >= GB_QUALNUM || ! (ptFeature->aiKeys[iKey / 32] & (1U << (iKey % 32)))) return NULL;
+
+    for (ptQualifier = ptFeature->ptQualifier; ptQualifier < ptFeature->ptQualifier + ptFeature->iQualifierNum; ptQualifier++)
+        if (ptQualifier->iKey == iKey) return ptQualifier;
+
+    return NULL;
+}
+
+/* Looks up the key of a parsed qualifier and marks it in its feature */
+static void internQualifier(gb_feature *pFeature, gb_qualifier *ptQualifier) {
+    ptQualifier->iKey = qualifierKey(ptQualifier->tQualifier.sStr, ptQualifier->tQualifier.lLen);
+    pFeature->aiKeys[ptQualifier->iKey / 32] |= 1U << (ptQualifier->iKey % 32);
+}
+
 static gb_string _parseQualifier(gb_string sQualifier, gb_string *psValue) {
     gb_string sPosition;
 
@@ -437,22 +983,26 @@ static gb_string _parseQualifier(gb_string sQualifier, gb_string *psValue) {
     return sQualifier;
 }
 
-static void parseQualifier(gb_string sQualifier, gb_feature *pFeature) {
+static void parseQualifier(gb_arena *ptArena, gb_string sQualifier, gb_feature *pFeature) {
     gb_string sValue;
     gb_string sTemp = NULL;
     gb_string sString = NULL;
     gb_qualifier *ptQualifier;
-   
-    ptQualifier = malloc(INITQUALIFIERNUM * sizeof(gb_qualifier));
+    unsigned int iQualifierNum = 0;
+
+    /* Every qualifier ends with a new line */
+    for (sTemp = sQualifier; (sTemp = strchr(sTemp, '\n')) != NULL; sTemp++) iQualifierNum++;
+
+    ptQualifier = allocArena(ptArena, iQualifierNum * sizeof(gb_qualifier));
     pFeature->ptQualifier = ptQualifier;
-    
+
 
     /* Parse the 1st gb_qualifier gb_string */
     sString = strtok_r(sQualifier, "\n", &sTemp);
     ptQualifier->sQualifier = _parseQualifier(sString, &sValue);
     ptQualifier->sValue = sValue;
     ptQualifier++;
-    
+
     /* Parse the rest gb_qualifier gb_string */
     while((sString = strtok_r(NULL, "\n", &sTemp)) != NULL) {
         ptQualifier->sQualifier = _parseQualifier(sString, &sValue);
@@ -462,67 +1012,182 @@ static void parseQualifier(gb_string sQualifier, gb_feature *pFeature) {
 
     /* Determine the number of actual qualifier data */
     pFeature->iQualifierNum = ptQualifier - pFeature->ptQualifier;
-    pFeature->ptQualifier =  realloc(pFeature->ptQualifier, pFeature->iQualifierNum * sizeof(gb_qualifier));
-    /*
-    ptQualifier = malloc(pFeature->iQualifierNum * sizeof(gb_qualifier));
-    memcpy(ptQualifier, pFeature->ptQualifier, pFeature->iQualifierNum * sizeof(gb_qualifier));
-    free(pFeature->ptQualifier);
-    pFeature->ptQualifier = ptQualifier;
-    */
+
+    for (ptQualifier = pFeature->ptQualifier; (ptQualifier - pFeature->ptQualifier) < pFeature->iQualifierNum; ptQualifier++) {
+        setSpan(&(ptQualifier->tQualifier), ptQualifier->sQualifier);
+        setSpan(&(ptQualifier->tValue), ptQualifier->sValue);
+        internQualifier(pFeature, ptQualifier);
+    }
+}
+
+/* Splits 'name="value"' into spans, following _parseQualifier() */
+static void _parseQualifierSpan(const char *sQualifier, const char *sEnd, gb_qualifier *ptQualifier) {
+    const char *sPosition;
+
+    for (; sQualifier < sEnd && isspace(*sQualifier); sQualifier++);
+
+    ptQualifier->sQualifier = NULL;
+    ptQualifier->sValue = NULL;
+    ptQualifier->tQualifier.sStr = sQualifier;
+
+    if ((sPosition = memchr(sQualifier, '=', sEnd - sQualifier)) == NULL) {
+        ptQualifier->tQualifier.lLen = sEnd - sQualifier;
+        ptQualifier->tValue.sStr = sEnd;
+        ptQualifier->tValue.lLen = 0;
+        return;
+    }
+
+    ptQualifier->tQualifier.lLen = sPosition++ - sQualifier;
+
+    if (sPosition < sEnd && *sPosition == '"') {
+        const char *sQuote;
+
+        for (sQuote = sEnd - 1; sQuote > sPosition && *sQuote != '"'; sQuote--);
+        if (sQuote > sPosition) sEnd = sQuote;
+        sPosition++;
+    }
+
+    ptQualifier->tValue.sStr = sPosition;
+    ptQualifier->tValue.lLen = sEnd - sPosition;
+}
+
+/* Adds the qualifier held by the lines between sStart and sEnd to a feature
+   without copying it, unless it has continuation lines which must be joined */
+static void addQualifierSpan(gb_cursor *ptCursor, gb_feature *pFeature, unsigned int *piQualifierMem, const char *sStart, const char *sEnd) {
+    gb_cursor tLines;
+    gb_span tLine;
+    gb_string sJoined;
+    unsigned long lJoinedLen = 0;
+    unsigned int iSkip = QUALIFIERSTART + 1;
+
+    tLines.sPos = sStart;
+    tLines.sEnd = sEnd;
+
+    getLine_w_rtrim(&tLine, &tLines);
+    if (tLines.sPos >= sEnd) {
+        /* The whole qualifier is on a single line */
+        if (tLine.lLen <= iSkip) return;
+        sStart = tLine.sStr + iSkip;
+        sEnd = tLine.sStr + tLine.lLen;
+    } else {
+        sJoined = allocArena(ptCursor->ptArena, sEnd - sStart);
+        do {
+            if (tLine.lLen > iSkip) {
+                memcpy(sJoined + lJoinedLen, tLine.sStr + iSkip, tLine.lLen - iSkip);
+                lJoinedLen += tLine.lLen - iSkip;
+            }
+            iSkip = QUALIFIERSTART;
+            getLine_w_rtrim(&tLine, &tLines);
+        } while (tLine.sStr < sEnd);
+        if (lJoinedLen == 0) return;
+        sStart = sJoined;
+        sEnd = sJoined + lJoinedLen;
+    }
+
+    if (pFeature->iQualifierNum == *piQualifierMem) {
+        *piQualifierMem = (*piQualifierMem == 0) ? INITQUALIFIERNUM : *piQualifierMem * 2;
+        pFeature->ptQualifier = growArena(ptCursor->ptArena, pFeature->ptQualifier,
+            pFeature->iQualifierNum * sizeof(gb_qualifier), *piQualifierMem * sizeof(gb_qualifier));
+    }
+
+    _parseQualifierSpan(sStart, sEnd, pFeature->ptQualifier + pFeature->iQualifierNum);
+    internQualifier(pFeature, pFeature->ptQualifier + pFeature->iQualifierNum++);
+}
+
+/* Completes a feature once all of its lines have been read */
+static void endFeature(gb_cursor *ptCursor, gb_feature *pFeature) {
+    gb_buffer *ptLocation = &(ptCursor->ptParser->tLocation);
+    gb_buffer *ptQualifier = &(ptCursor->ptParser->tQualifier);
+
+    if (ptLocation->lLen != 0) parseLocation(ptCursor->ptArena, ptLocation->sStr, pFeature);
+    ptLocation->lLen = 0;
+
+    if (ptQualifier->lLen != 0) {
+        appendBuffer(ptQualifier, "\n", 1);
+        parseQualifier(ptCursor->ptArena, copySpan(ptCursor->ptArena, ptQualifier->sStr, ptQualifier->lLen), pFeature);
+        ptQualifier->lLen = 0;
+    }
+}
+
+/* Whether the feature whose key starts at sKey was asked for */
+static int isWantedFeature(const char **psFeatures, const char *sKey, unsigned long lLen) {
+    const char **psFeature;
+
+    if (psFeatures == NULL) return 1;
+
+    for (lLen = (lLen < FEATURELEN) ? lLen : FEATURELEN; lLen > 0 && *(sKey + lLen - 1) == ' '; lLen--);
+    for (psFeature = psFeatures; *psFeature != NULL; psFeature++) {
+        if (strlen(*psFeature) == lLen && memcmp(*psFeature, sKey, lLen) == 0) return 1;
+    }
+
+    return 0;
 }
 
-static void parseFeature(FILE *FSeqFile, gb_data *ptGBData) {
-    char sLine[LINELEN] = {'\0',};
-    char sLocation[LINELEN] = {'\0',};
-    gb_string sQualifier = NULL;
-    gb_string sQualifierTemp = NULL;
+static void parseFeature(gb_cursor *ptCursor, gb_data *ptGBData) {
+    gb_span tLine;
+    gb_buffer *ptLocation = &(ptCursor->ptParser->tLocation);
+    gb_buffer *ptQualifier = &(ptCursor->ptParser->tQualifier);
+    const char *sQualifierStart = NULL;
+    const char *sQualifierEnd = NULL;
     unsigned int iReadPos = INELSE;
     unsigned int iFeatureNum = 0;
     unsigned int iFeatureMem = INITFEATURENUM;
+    unsigned int iQualifierMem = 0;
     unsigned int i = 0;
+    int iNewFeature, iNewQualifier;
+    int iSkip = 0;
+    int iZeroCopy = (ptCursor->iFlags & GB_ZEROCOPY) != 0;
     gb_feature *pFeatures = NULL;
     gb_feature *pFeature = NULL;
-    
-    pFeatures = (gb_feature *) malloc(iFeatureMem * sizeof(gb_feature));
+
+    pFeatures = (gb_feature *) allocArena(ptCursor->ptArena, iFeatureMem * sizeof(gb_feature));
+    ptLocation->lLen = 0;
+    ptQualifier->lLen = 0;
+
+    getLine(&tLine, ptCursor); /* Skip the FEATURES line */
 
     /* Parse FEATURES */
-    while(fgets(sLine, LINELEN, FSeqFile)) {
-        if (! isspace(*sLine)) {
-            putLine(sLine);
+    while(getLine(&tLine, ptCursor)) {
+        if (tLine.lLen > 0 && ! isspace(*(tLine.sStr))) {
+            putLine(&tLine, ptCursor);
             break;
         }
-        
-        rtrim(sLine);
-        if (memcmp(sLine + 5, "               ", 15) != 0) {
-            if (iFeatureNum == iFeatureMem) {
-                iFeatureMem += INITFEATURENUM;
-                pFeatures = realloc(pFeatures, sizeof(gb_feature) * iFeatureMem);
-            }
 
-            if (strlen(sLocation) != 0) parseLocation(sLocation, (pFeatures + iFeatureNum - 1));
-            if (sQualifier < sQualifierTemp) {
-                *sQualifierTemp++ = '\n';
-                *sQualifierTemp = '\0';
-                sQualifierTemp = malloc((sQualifierTemp - sQualifier + 1) * sizeof(*sQualifier));
-                strcpy(sQualifierTemp, sQualifier);
-                free(sQualifier);
-                sQualifier = sQualifierTemp;
-                parseQualifier(sQualifier, (pFeatures + iFeatureNum - 1));
-            } else {
-                free(sQualifier);
-                sQualifier = NULL;
-            }
+        rtrimSpan(&tLine);
+        iNewFeature = (tLine.lLen > 5 && memcmp(tLine.sStr + 5, "               ", (tLine.lLen < 20 ? tLine.lLen : 20) - 5) != 0);
+        iNewQualifier = (! iNewFeature && tLine.lLen > QUALIFIERSTART && *(tLine.sStr + QUALIFIERSTART) == '/');
 
-            *sLocation = '\0';
-            sQualifier = malloc(sizeof(*sQualifier) * MEGA);
-            sQualifierTemp = sQualifier;
-            
-            iReadPos = INFEATURE;
-            
-            memcpy((pFeatures + iFeatureNum)->sFeature, (sLine + 5), 15);
-            *(((pFeatures + iFeatureNum)->sFeature) + 15) = '\0';
+        /* In zero-copy mode a qualifier is added once all of its lines are known */
+        if (sQualifierStart != NULL && (iNewFeature || iNewQualifier)) {
+            addQualifierSpan(ptCursor, pFeature, &iQualifierMem, sQualifierStart, sQualifierEnd);
+            sQualifierStart = NULL;
+        }
+
+        if (iNewFeature) {
+            if (pFeature != NULL) endFeature(ptCursor, pFeature);
+            pFeature = NULL;
+            iQualifierMem = 0;
+
+            /* Lines of features which were not asked for are passed over */
+            if ((iSkip = ! isWantedFeature(ptCursor->psFeatures, tLine.sStr + 5, tLine.lLen - 5))) {
+                iReadPos = INELSE;
+                continue;
+            }
+
+            /* Bacterial records have thousands of features, so grow geometrically */
+            if (iFeatureNum == iFeatureMem) {
+                iFeatureMem *= 2;
+                pFeatures = growArena(ptCursor->ptArena, pFeatures, sizeof(gb_feature) * iFeatureNum, sizeof(gb_feature) * iFeatureMem);
+            }
+
+            iReadPos = INFEATURE;
+
+            i = (tLine.lLen < 20) ? tLine.lLen - 5 : 15;
+            memcpy((pFeatures + iFeatureNum)->sFeature, (tLine.sStr + 5), i);
+            *(((pFeatures + iFeatureNum)->sFeature) + i) = '\0';
             rtrim((pFeatures + iFeatureNum)->sFeature);
-            strcpy(sLocation, (sLine + 21));
+            if (tLine.lLen > QUALIFIERSTART)
+                appendBuffer(ptLocation, tLine.sStr + QUALIFIERSTART, tLine.lLen - QUALIFIERSTART);
 
             /* Feature Initalize */
             pFeature = pFeatures + iFeatureNum;
@@ -534,71 +1199,273 @@ static void parseFeature(FILE *FSeqFile, gb_data *ptGBData) {
             pFeature->iQualifierNum = 0;
             pFeature->ptLocation = NULL;
             pFeature->ptQualifier = NULL;
+            memset(pFeature->aiKeys, 0, sizeof(pFeature->aiKeys));
 
             iFeatureNum++;
-        } else if (*(sLine + QUALIFIERSTART) == '/') {
+        } else if (iSkip) {
+            continue;
+        } else if (iNewQualifier) {
             iReadPos = INQUALIFIER;
-            if (sQualifier < sQualifierTemp) *sQualifierTemp++ = '\n';
-            i = strlen(sLine) - (QUALIFIERSTART + 1);
-            memcpy(sQualifierTemp, sLine + (QUALIFIERSTART + 1), i);
-            sQualifierTemp += i;
-        } else {
+            if (iZeroCopy) {
+                sQualifierStart = tLine.sStr;
+                sQualifierEnd = tLine.sStr + tLine.lLen;
+                continue;
+            }
+            if (ptQualifier->lLen != 0) appendBuffer(ptQualifier, "\n", 1);
+            appendBuffer(ptQualifier, tLine.sStr + (QUALIFIERSTART + 1), tLine.lLen - (QUALIFIERSTART + 1));
+        } else if (tLine.lLen > QUALIFIERSTART) {
             if (iReadPos == INFEATURE) {
-                strcpy((sLocation + strlen(sLocation)), (sLine + QUALIFIERSTART));
+                appendBuffer(ptLocation, tLine.sStr + QUALIFIERSTART, tLine.lLen - QUALIFIERSTART);
             } else if (iReadPos == INQUALIFIER) {
-                i = strlen(sLine) - QUALIFIERSTART;
-                memcpy(sQualifierTemp, sLine + QUALIFIERSTART, i);
-                sQualifierTemp += i;
+                if (iZeroCopy) {
+                    sQualifierEnd = tLine.sStr + tLine.lLen;
+                    continue;
+                }
+                appendBuffer(ptQualifier, tLine.sStr + QUALIFIERSTART, tLine.lLen - QUALIFIERSTART);
             }
         }
     }
 
     /* Finishing of the parsing */
 
-    if (iFeatureNum == iFeatureMem) {
-        iFeatureMem += INITFEATURENUM;
-        pFeatures = realloc(pFeatures, sizeof(gb_feature) * iFeatureMem);
+    if (sQualifierStart != NULL) addQualifierSpan(ptCursor, pFeature, &iQualifierMem, sQualifierStart, sQualifierEnd);
+    if (pFeature != NULL) endFeature(ptCursor, pFeature);
+
+    ptGBData->iFeatureNum = iFeatureNum;
+    ptGBData->ptFeatures = pFeatures;
+}
+
+/* Same as isalpha() in the C locale */
+#define isLetter( x ) ((unsigned char) (((unsigned char) (x) | 0x20) - 'a') < 26)
+
+/* Copies the letters of sIn to sOut, returning how many there were. Vector
+   kernels may write up to SEQUENCESLACK bytes past the letters */
+typedef size_t (*gb_compact)(char *sOut, const char *sIn, size_t lLen);
+
+static size_t compactScalar(char *sOut, const char *sIn, size_t lLen) {
+    const char *sEnd = sIn + lLen;
+    char *sStart = sOut;
+
+    for (; sIn < sEnd; sIn++) if (isLetter(*sIn)) *(sOut++) = *sIn;
+
+    return sOut - sStart;
+}
+
+#ifdef GB_X86SIMD
+/* Shuffles which move the letters of 8 bytes to the front, by letter mask */
+static unsigned long long alCompact[256];
+
+static void initCompact(void) {
+    unsigned int iMask, iBit, iPos;
+
+    for (iMask = 0; iMask < 256; iMask++) {
+        alCompact[iMask] = 0;
+        for (iBit = iPos = 0; iBit < 8; iBit++) {
+            if (iMask & (1 << iBit)) alCompact[iMask] |= (unsigned long long) iBit << (8 * iPos++);
+        }
+    }
+}
+
+/* Letters give 0 below 26 after folding case and subtracting 'a'; the signed
+   compare needs the bias of 128 */
+#define LETTERBIAS (26 - 128)
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t compactSSE(char *sOut, const char *sIn, size_t lLen) {
+    const char *sEnd = sIn + lLen;
+    char *sStart = sOut;
+    __m128i vIn, vLetter, vShuffle;
+    unsigned int iMask;
+
+    for (; sIn + 16 <= sEnd; sIn += 16) {
+        vIn = _mm_loadu_si128((const __m128i *) sIn);
+        vLetter = _mm_sub_epi8(_mm_or_si128(vIn, _mm_set1_epi8(0x20)), _mm_set1_epi8('a' - 128));
+        iMask = _mm_movemask_epi8(_mm_cmplt_epi8(vLetter, _mm_set1_epi8(LETTERBIAS)));
+        if (iMask == 0xffff) {
+            _mm_storeu_si128((__m128i *) sOut, vIn);
+            sOut += 16;
+            continue;
+        }
+        vShuffle = _mm_set_epi64x(alCompact[iMask >> 8] + 0x0808080808080808ULL, alCompact[iMask & 0xff]);
+        vIn = _mm_shuffle_epi8(vIn, vShuffle);
+        _mm_storel_epi64((__m128i *) sOut, vIn);
+        sOut += _mm_popcnt_u32(iMask & 0xff);
+        _mm_storel_epi64((__m128i *) sOut, _mm_srli_si128(vIn, 8));
+        sOut += _mm_popcnt_u32(iMask >> 8);
+    }
+
+    return (sOut - sStart) + compactScalar(sOut, sIn, sEnd - sIn);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t compactAVX2(char *sOut, const char *sIn, size_t lLen) {
+    const char *sEnd = sIn + lLen;
+    char *sStart = sOut;
+    __m256i vIn, vLetter, vShuffle;
+    __m128i vHalf;
+    unsigned int iMask, i;
+
+    for (; sIn + 32 <= sEnd; sIn += 32) {
+        vIn = _mm256_loadu_si256((const __m256i *) sIn);
+        vLetter = _mm256_sub_epi8(_mm256_or_si256(vIn, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a' - 128));
+        iMask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(LETTERBIAS), vLetter));
+        if (iMask == 0xffffffff) {
+            _mm256_storeu_si256((__m256i *) sOut, vIn);
+            sOut += 32;
+            continue;
+        }
+        /* The shuffle works within each 16-byte lane */
+        vShuffle = _mm256_set_epi64x(alCompact[iMask >> 24] + 0x0808080808080808ULL, alCompact[(iMask >> 16) & 0xff],
+            alCompact[(iMask >> 8) & 0xff] + 0x0808080808080808ULL, alCompact[iMask & 0xff]);
+        vIn = _mm256_shuffle_epi8(vIn, vShuffle);
+        for (i = 0; i < 4; i++) {
+            vHalf = (i < 2) ? _mm256_castsi256_si128(vIn) : _mm256_extracti128_si256(vIn, 1);
+            if (i & 1) vHalf = _mm_srli_si128(vHalf, 8);
+            _mm_storel_epi64((__m128i *) sOut, vHalf);
+            sOut += _mm_popcnt_u32((iMask >> (8 * i)) & 0xff);
+        }
     }
 
-    if (strlen(sLocation) != 0) parseLocation(sLocation, (pFeatures + iFeatureNum - 1));
-    if (sQualifier < sQualifierTemp) {
-        *sQualifierTemp++ = '\n';
-        *sQualifierTemp = '\0';
-        sQualifierTemp = malloc((sQualifierTemp - sQualifier + 1) * sizeof(*sQualifier));
-        strcpy(sQualifierTemp, sQualifier);
-        free(sQualifier);
-        sQualifier = sQualifierTemp;
-        parseQualifier(sQualifier, (pFeatures + iFeatureNum - 1));
+    return (sOut - sStart) + compactSSE(sOut, sIn, sEnd - sIn);
+}
+
+static gb_compact fCompact = compactScalar;
+static pthread_once_t tCompactOnce = PTHREAD_ONCE_INIT;
+
+static void pickCompact(void) {
+    initCompact();
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) fCompact = compactAVX2;
+    else if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) fCompact = compactSSE;
+}
+
+static gb_compact getCompact(void) {
+    pthread_once(&tCompactOnce, pickCompact);
+    return fCompact;
+}
+#else
+#define getCompact() compactScalar
+#endif
+
+/* 4-bit codes follow sNorBase; 2-bit codes are bits 1-2 of the ASCII bases,
+   so that A, C, T and G are 0 to 3 */
+static const char sPacked2[] = "ACTG";
+static const char sPacked4[] = "ACGTRYMKWSBDHVN";
+static const unsigned char acPackedCom4[16] = {3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 13, 12, 11, 10, 14, 15};
+
+/* 4-bit code plus one of each base, 0 for other characters */
+static const unsigned char acBaseCode[256] = {
+    ['A'] = 1, ['C'] = 2, ['G'] = 3, ['T'] = 4, ['R'] = 5, ['Y'] = 6, ['M'] = 7, ['K'] = 8,
+    ['W'] = 9, ['S'] = 10, ['B'] = 11, ['D'] = 12, ['H'] = 13, ['V'] = 14, ['N'] = 15,
+    ['a'] = 1, ['c'] = 2, ['g'] = 3, ['t'] = 4, ['r'] = 5, ['y'] = 6, ['m'] = 7, ['k'] = 8,
+    ['w'] = 9, ['s'] = 10, ['b'] = 11, ['d'] = 12, ['h'] = 13, ['v'] = 14, ['n'] = 15
+};
+
+#define packedLen( x, y ) (((x) * (y) + 7) / 8)
+
+/* Packs lLen bases into sOut, which may be sIn. Returns -1, leaving sOut
+   alone, when the bases mix case or are not all IUPAC codes */
+static int packBases(unsigned char *sOut, const char *sIn, unsigned long lLen, gb_packed *ptPacked) {
+    const unsigned char *sBase = (const unsigned char *) sIn;
+    unsigned int iSeen = 0; /* 1 for upper case, 2 for lower case, 4 for ambiguity codes */
+    unsigned char acBase[4];
+    unsigned long i, j;
+
+    for (i = 0; i < lLen; i++) {
+        if (acBaseCode[*(sBase + i)] == 0) return -1;
+        iSeen |= ((*(sBase + i) & 0x20) ? 2 : 1) | ((acBaseCode[*(sBase + i)] > 4) ? 4 : 0);
+    }
+    if ((iSeen & 3) == 3) return -1;
+
+    ptPacked->lLen = lLen;
+    ptPacked->iBits = (iSeen & 4) ? 4 : 2;
+    ptPacked->cCase = (iSeen & 2) ? 'a' : 'A';
+
+    /* Every output byte is written after the input bytes it covers are read */
+    if (ptPacked->iBits == 2) {
+        for (i = 0; i < lLen; i += 4) {
+            for (j = 0; j < 4; j++) acBase[j] = (i + j < lLen) ? (*(sBase + i + j) >> 1) & 3 : 0;
+            *(sOut + i / 4) = acBase[0] | (acBase[1] << 2) | (acBase[2] << 4) | (acBase[3] << 6);
+        }
     } else {
-        free(sQualifier);
-        sQualifier = NULL;
+        for (i = 0; i < lLen; i += 2) {
+            acBase[0] = acBaseCode[*(sBase + i)] - 1;
+            acBase[1] = (i + 1 < lLen) ? acBaseCode[*(sBase + i + 1)] - 1 : 0;
+            *(sOut + i / 2) = acBase[0] | (acBase[1] << 4);
+        }
     }
 
-    ptGBData->iFeatureNum = iFeatureNum;
-    ptGBData->ptFeatures = pFeatures;
+    return 0;
+}
+
+/* Writes lLen bases from lStart on, or their reverse complement */
+static void unpackBases(char *sOut, const gb_packed *ptPacked, unsigned long lStart, unsigned long lLen, int iRevCom) {
+    const unsigned char *sData = ptPacked->sData;
+    char cCase = (ptPacked->cCase == 'a') ? 0x20 : 0;
+    unsigned long i, k;
+    unsigned int iCode;
+
+    if (ptPacked->iBits == 2) {
+        for (k = 0; k < lLen; k++) {
+            i = iRevCom ? lStart + lLen - 1 - k : lStart + k;
+            iCode = (*(sData + i / 4) >> (2 * (i % 4))) & 3;
+            *(sOut + k) = sPacked2[iRevCom ? iCode ^ 2 : iCode] | cCase;
+        }
+    } else {
+        for (k = 0; k < lLen; k++) {
+            i = iRevCom ? lStart + lLen - 1 - k : lStart + k;
+            iCode = (*(sData + i / 2) >> (4 * (i % 2))) & 15;
+            *(sOut + k) = sPacked4[iRevCom ? acPackedCom4[iCode] : iCode] | cCase;
+        }
+    }
 }
 
-/* Parse sequences */
-static void parseSequence(FILE *FSeqFile, gb_data *ptGBData) {
-    register char c;
-    char sLine[LINELEN] = {'\0',};
-    gb_string sSequence, sSequence2;
+/* Packs the sequence of a record in place, shrinking it in its arena */
+static void packRecord(gb_arena *ptArena, gb_data *ptGBData, size_t lLen, size_t lMem) {
+    if (packBases((unsigned char *) ptGBData->sSequence, ptGBData->sSequence, lLen, &(ptGBData->tPacked)) != 0) return;
 
-    ptGBData->sSequence = malloc((ptGBData->lLength + 1) * sizeof(char));
-    sSequence2 = ptGBData->sSequence;
-    
-    while(fgets(sLine, LINELEN, FSeqFile)) {
-        if (*sLine == '/' && *(sLine + 1) == '/') {
-            putLine(sLine);
+    ptGBData->tPacked.sData = growArena(ptArena, ptGBData->sSequence, lMem, packedLen(lLen, ptGBData->tPacked.iBits));
+    ptGBData->sSequence = NULL;
+}
+
+/* Parse sequences. The LOCUS length sizes the sequence, which grows when
+   a record holds more bases than it says */
+static void parseSequence(gb_cursor *ptCursor, gb_data *ptGBData) {
+    gb_span tLine;
+    gb_compact fCompactLetters = getCompact();
+    size_t lLen = 0;
+    size_t lMem = ptGBData->lLength + 1 + SEQUENCESLACK;
+    size_t lNeed;
+
+    ptGBData->sSequence = allocArena(ptCursor->ptArena, lMem);
+
+    getLine(&tLine, ptCursor); /* Skip the ORIGIN line */
+    if (ptCursor->iFlags & GB_ZEROCOPY) ptGBData->tOrigin.sStr = ptCursor->sPos;
+
+    while(getLine(&tLine, ptCursor)) {
+        if (isTerminator(&tLine)) {
+            putLine(&tLine, ptCursor);
             break;
         }
-        sSequence = sLine + 9; /* '+ 9' in order to skip a numbers */
-        while((c = *(sSequence++)) != '\0') if (isalpha(c)) *(sSequence2++) = c;
+        if (tLine.lLen <= 9) continue;
+        /* '+ 9' in order to skip a numbers */
+        if ((lNeed = lLen + (tLine.lLen - 9) + 1 + SEQUENCESLACK) > lMem) {
+            lNeed = (lNeed > 2 * lMem) ? lNeed : 2 * lMem;
+            ptGBData->sSequence = growArena(ptCursor->ptArena, ptGBData->sSequence, lLen, lNeed);
+            lMem = lNeed;
+        }
+        lLen += fCompactLetters(ptGBData->sSequence + lLen, tLine.sStr + 9, tLine.lLen - 9);
     }
-    *(sSequence2) = '\0';
+    *(ptGBData->sSequence + lLen) = '\0';
+
+    if (ptCursor->iFlags & GB_PACKED) packRecord(ptCursor->ptArena, ptGBData, lLen, lMem);
+
+    if (ptCursor->iFlags & GB_ZEROCOPY) ptGBData->tOrigin.lLen = ptCursor->sPos - ptGBData->tOrigin.sStr;
 }
 
 static void initGBData(gb_data *ptGBData) {
+    gb_span tEmpty = {NULL, 0};
+
     ptGBData->sAccession = NULL;
     ptGBData->sComment = NULL;
     ptGBData->sDef = NULL;
@@ -611,78 +1478,526 @@ static void initGBData(gb_data *ptGBData) {
     ptGBData->sVersion = NULL;
     ptGBData->ptReferences = NULL;
     ptGBData->ptFeatures = NULL;
+    ptGBData->ptIndex = NULL;
+    ptGBData->tAccession = tEmpty;
+    ptGBData->tVersion = tEmpty;
+    ptGBData->tLocusName = tEmpty;
+    ptGBData->tOrigin = tEmpty;
+    ptGBData->tPacked.sData = NULL;
+    ptGBData->tPacked.lLen = 0;
+    ptGBData->tPacked.iBits = 0;
+    ptGBData->tPacked.cCase = 'a';
     ptGBData->iFeatureNum = 0;
     ptGBData->iReferenceNum = 0;
     ptGBData->lLength = 0;
     ptGBData->lRegion[0] = 0;
     ptGBData->lRegion[1] = 0;
+    ptGBData->lOffset = 0;
+    ptGBData->lTextLen = 0;
     ptGBData->sLocusName[0] = '\0';
     ptGBData->sType[0] = '\0';
     ptGBData->sTopology[0] = '\0';
     ptGBData->sDivisionCode[0] = '\0';
     ptGBData->sDate[0] = '\0';
+    ptGBData->ptArena = NULL;
 }
 
-static gb_data *_parseGBFF(FILE *FSeqFile) {
+/* Fields which come before a filter is asked about a record */
+#define HEADERFIELDS        (GB_DEFINITION | GB_ACCESSION | GB_VERSION)
+
+/* Parses a record into the cursor's arena; the cursor starts at its LOCUS line */
+static gb_data *_parseGBFF(gb_cursor *ptCursor) {
     int i;
-    char sLine[LINELEN] = {'\0',};
+    gb_span tLine;
     gb_data *ptGBData = NULL;
 
     struct tField {
         char sField[FIELDLEN + 1];
-        void (*vFunction)(FILE *FSeqFile, gb_data *ptGBData);
+        unsigned int iField;
+        void (*vFunction)(gb_cursor *ptCursor, gb_data *ptGBData);
     } atFields[] = {
-        {"DEFINITION", parseDef},
-        {"ACCESSION", parseAccession},
-        {"VERSION", parseVersion},
-        {"KEYWORDS", parseKeywords},
-        {"SOURCE", parseSource},
-        {"REFERENCE", parseReference},
-        {"COMMENT", parseComment},
-        {"FEATURE", parseFeature},
-        {"ORIGIN", parseSequence},
-        {"", NULL} /* To terminate seeking */
+        {"DEFINITION", GB_DEFINITION, parseDef},
+        {"ACCESSION", GB_ACCESSION, parseAccession},
+        {"VERSION", GB_VERSION, parseVersion},
+        {"KEYWORDS", GB_KEYWORDS, parseKeywords},
+        {"SOURCE", GB_SOURCE, parseSource},
+        {"REFERENCE", GB_REFERENCE, parseReference},
+        {"COMMENT", GB_COMMENT, parseComment},
+        {"FEATURE", GB_FEATURES, parseFeature},
+        {"ORIGIN", GB_ORIGIN, parseSequence},
+        {"", 0, NULL} /* To terminate seeking */
     };
 
-    /* Confirming GBFF File with LOCUS line */
-    while(fgets(sLine, LINELEN, FSeqFile)) {
-        if (strstr(sLine, "LOCUS") == sLine) {
-            ptGBData = malloc(sizeof(gb_data));
-            initGBData(ptGBData);
-            break;
-        }
-    }
+    ptGBData = allocArena(ptCursor->ptArena, sizeof(gb_data));
+    initGBData(ptGBData);
+    ptGBData->ptArena = ptCursor->ptArena;
 
-    /* If there is a no LOCUS line, next statement return NULL value to end parsing */
-    if (ptGBData == NULL) return NULL;
-   
-    /* Parse LOCUS line */ 
-    if (parseLocus(sLine, ptGBData) != 0) {
-        freeSingleGBData(ptGBData);
+    /* Parse LOCUS line */
+    getLine(&tLine, ptCursor);
+    if (parseLocus(ptCursor->ptParser, &tLine, ptGBData, ptCursor->iFlags) != 0) {
+        freeGBRecord(ptGBData);
         return NULL;
     }
 
-    while(getLine(sLine, FSeqFile)) {
-        if (*sLine == '/' && *(sLine + 1) == '/') break;
+    while(getLine(&tLine, ptCursor)) {
+        if (isTerminator(&tLine)) break;
+        /* Fields start at the first column; the lines of skipped fields do not */
+        if (tLine.lLen == 0 || *(tLine.sStr) == ' ') continue;
         for(i = 0; *((atFields + i)->sField); i++) {
-            if (strstr(sLine, (atFields + i)->sField) == sLine) {
-                putLine(sLine);
-                ((atFields + i)->vFunction)(FSeqFile, ptGBData);
+            if (tLine.lLen >= strlen((atFields + i)->sField) &&
+                memcmp(tLine.sStr, (atFields + i)->sField, strlen((atFields + i)->sField)) == 0) {
+                /* The filter has the header fields once the first later field is reached */
+                if (ptCursor->pFilter != NULL && ((atFields + i)->iField & ~HEADERFIELDS) != 0) {
+                    if (! (ptCursor->pFilter)(ptGBData, ptCursor->pFilterArg)) {
+                        ptCursor->iFiltered = 1;
+                        freeGBRecord(ptGBData);
+                        return NULL;
+                    }
+                    ptCursor->pFilter = NULL;
+                }
+                if (((atFields + i)->iField & ptCursor->iFields) == 0) break;
+                putLine(&tLine, ptCursor);
+                ((atFields + i)->vFunction)(ptCursor, ptGBData);
                 break;
             }
         }
     }
-    
+
+    /* Records with nothing past the header fields are only asked about now */
+    if (ptCursor->pFilter != NULL && ! (ptCursor->pFilter)(ptGBData, ptCursor->pFilterArg)) {
+        ptCursor->iFiltered = 1;
+        freeGBRecord(ptGBData);
+        return NULL;
+    }
+
     return ptGBData;
 }
 
-/* parse sequence datas in a GBF file */
-gb_data **parseGBFF(gb_string spFileName) {
-    unsigned int iGBFSeqPos = 0;
-    unsigned int iGBFSeqNum = INITGBFSEQNUM;
-    gb_data **pptGBDatas;
+/* Sequential reader over a GBF file; one record is held in memory at a time.
+   The input is either mapped as a whole or read into a growing buffer */
+struct tGBReader {
     FILE *FSeqFile;
- 
+    int iOwnFile;
+    int iEOF;
+    int iError;         /* A record could not be parsed */
+    int iMapped;        /* sData is a mapping of the file */
+    unsigned int iFlags;
+    char *sData;        /* The read buffer, or the mapped file */
+    size_t lDataLen;    /* Bytes held in sData */
+    size_t lDataMem;    /* Size of the read buffer, 0 when sData is mapped or borrowed */
+    size_t lPos;        /* Start of the input which has not been parsed yet */
+    size_t lDropped;    /* Mapped bytes already handed back to the kernel */
+    unsigned long long lShifted; /* Input moved out of the front of the read buffer */
+    gb_arena *ptSpare;  /* Arena of the last freed record, kept for the next one */
+    gb_arena *ptLive;   /* Arenas of records which have not been freed yet */
+    gb_parser tParser;
+    gb_gzip *ptGzip;    /* Set for gzip input; sData then holds inflated text */
+    unsigned int iThreads; /* Threads inflating BGZF input */
+    unsigned int iFields;
+    const char **psFeatures;
+    gb_filter pFilter;
+    void *pFilterArg;
+};
+
+#define isGzip( x, y ) ((y) >= 2 && (unsigned char) *(x) == 0x1f && (unsigned char) *((x) + 1) == 0x8b)
+
+static unsigned long getLE(const unsigned char *sIn, int iBytes) {
+    unsigned long lValue = 0;
+
+    while (iBytes-- > 0) lValue = (lValue << 8) | *(sIn + iBytes);
+
+    return lValue;
+}
+
+/* Reads more compressed input, dropping what has been inflated already */
+static int readGzip(gb_reader *ptReader) {
+    gb_gzip *ptGzip = ptReader->ptGzip;
+    size_t lRead;
+
+    if (ptGzip->iInEOF) return 0;
+
+    if (ptGzip->lInPos > 0) {
+        memmove(ptGzip->sIn, ptGzip->sIn + ptGzip->lInPos, ptGzip->lInLen - ptGzip->lInPos);
+        ptGzip->lInLen -= ptGzip->lInPos;
+        ptGzip->lInPos = 0;
+    }
+
+    if (ptGzip->lInLen == ptGzip->lInMem) {
+        ptGzip->lInMem *= 2;
+        ptGzip->sIn = realloc(ptGzip->sIn, ptGzip->lInMem);
+    }
+
+    lRead = fread(ptGzip->sIn + ptGzip->lInLen, 1, ptGzip->lInMem - ptGzip->lInLen, ptReader->FSeqFile);
+    if (lRead == 0) {
+        ptGzip->iInEOF = 1;
+        return 0;
+    }
+    ptGzip->lInLen += lRead;
+
+    return 1;
+}
+
+/* Size of the BGZF block at sIn, 0 when it is some other gzip member.
+   Only the first BGZFHEADLEN bytes are looked at */
+static unsigned int sizeBGZF(const unsigned char *sIn) {
+    unsigned int iExtraLen, iFieldLen, i;
+
+    if (*sIn != 0x1f || *(sIn + 1) != 0x8b || *(sIn + 2) != 8 || *(sIn + 3) != 4) return 0;
+
+    iExtraLen = getLE(sIn + 10, 2);
+    for (i = 12; i + 4 <= 12 + iExtraLen && i + 6 <= BGZFHEADLEN; i += 4 + iFieldLen) {
+        iFieldLen = getLE(sIn + i + 2, 2);
+        if (*(sIn + i) == 'B' && *(sIn + i + 1) == 'C' && iFieldLen == 2) return getLE(sIn + i + 4, 2) + 1;
+    }
+
+    return 0;
+}
+
+/* Inflates members one after the other, for gzip input which is not BGZF */
+static size_t inflateGzip(gb_reader *ptReader) {
+    gb_gzip *ptGzip = ptReader->ptGzip;
+    z_stream *ptStream = &(ptGzip->tStream);
+    size_t lAvail;
+    int iResult;
+
+    if (! ptGzip->iStream) {
+        memset(ptStream, 0, sizeof(z_stream));
+        if (inflateInit2(ptStream, 15 + 16) != Z_OK) return 0;
+        ptGzip->iStream = 1;
+    }
+
+    lAvail = ptReader->lDataMem - ptReader->lDataLen;
+    if (lAvail > UINT_MAX) lAvail = UINT_MAX;
+
+    ptStream->next_out = (unsigned char *) ptReader->sData + ptReader->lDataLen;
+    ptStream->avail_out = lAvail;
+    while (ptStream->avail_out == lAvail) {
+        if (ptGzip->lInPos == ptGzip->lInLen && ! readGzip(ptReader)) {
+            /* The input ends inside a member */
+            if (ptStream->total_in > 0) ptReader->iError = 1;
+            break;
+        }
+        ptStream->next_in = (unsigned char *) ptGzip->sIn + ptGzip->lInPos;
+        ptStream->avail_in = (ptGzip->lInLen - ptGzip->lInPos > UINT_MAX) ? UINT_MAX : ptGzip->lInLen - ptGzip->lInPos;
+        iResult = inflate(ptStream, Z_NO_FLUSH);
+        ptGzip->lInPos = (char *) ptStream->next_in - ptGzip->sIn;
+        if (iResult == Z_STREAM_END) {
+            /* Another member may follow; anything else after the last one is ignored */
+            inflateReset(ptStream);
+            if (ptGzip->lInLen - ptGzip->lInPos < 2) readGzip(ptReader);
+            if (! isGzip(ptGzip->sIn + ptGzip->lInPos, ptGzip->lInLen - ptGzip->lInPos)) {
+                ptGzip->lInPos = ptGzip->lInLen;
+                ptGzip->iInEOF = 1;
+                break;
+            }
+        } else if (iResult != Z_OK && iResult != Z_BUF_ERROR) {
+            ptReader->iError = 1;
+            ptGzip->iInEOF = 1;
+            ptGzip->lInPos = ptGzip->lInLen;
+            break;
+        }
+    }
+
+    return lAvail - ptStream->avail_out;
+}
+
+/* Inflates every iStep-th block of a batch, starting from iFirst */
+static void *inflateBGZF(void *pBatch) {
+    gb_bgzfbatch *ptBatch = pBatch;
+    gb_bgzfblock *ptBlock;
+    z_stream tStream;
+    unsigned int i;
+
+    memset(&tStream, 0, sizeof(z_stream));
+    if (inflateInit2(&tStream, -15) != Z_OK) {
+        for (i = ptBatch->iFirst; i < ptBatch->iBlockNum; i += ptBatch->iStep) (ptBatch->ptBlocks + i)->iError = 1;
+        return NULL;
+    }
+
+    for (i = ptBatch->iFirst; i < ptBatch->iBlockNum; i += ptBatch->iStep) {
+        ptBlock = ptBatch->ptBlocks + i;
+        inflateReset(&tStream);
+        tStream.next_in = (unsigned char *) ptBlock->sIn;
+        tStream.avail_in = ptBlock->iInLen;
+        tStream.next_out = (unsigned char *) ptBatch->sOut + ptBlock->lOut;
+        tStream.avail_out = ptBlock->iLen;
+        ptBlock->iError = (inflate(&tStream, Z_FINISH) != Z_STREAM_END || tStream.avail_out != 0 ||
+            crc32(0L, (unsigned char *) ptBatch->sOut + ptBlock->lOut, ptBlock->iLen) != ptBlock->lCRC);
+    }
+
+    inflateEnd(&tStream);
+
+    return NULL;
+}
+
+/* Inflates a batch of BGZF blocks, in parallel when there are threads to spare */
+static size_t inflateBatch(gb_reader *ptReader) {
+    gb_gzip *ptGzip = ptReader->ptGzip;
+    gb_bgzfblock atBlocks[BGZFBATCHNUM];
+    gb_bgzfbatch atBatches[BGZFBATCHNUM];
+    const unsigned char *sIn;
+    unsigned int iBlockNum = 0, iSize, iThreads, i;
+    size_t lInPos, lOut = 0;
+#ifndef _WIN32
+    pthread_t atThreads[BGZFBATCHNUM];
+#endif
+
+    /* Take the whole blocks which have been read, reading more for the first one */
+    for (lInPos = ptGzip->lInPos; iBlockNum < BGZFBATCHNUM; lInPos += iSize) {
+        sIn = (unsigned char *) ptGzip->sIn + lInPos;
+        if (ptGzip->lInLen - lInPos < BGZFHEADLEN || ptGzip->lInLen - lInPos < sizeBGZF(sIn)) {
+            if (iBlockNum > 0) break;
+            if (readGzip(ptReader)) {
+                lInPos = ptGzip->lInPos;
+                iSize = 0;
+                continue;
+            }
+            if (ptGzip->lInLen - lInPos >= BGZFHEADLEN && sizeBGZF(sIn) != 0) {
+                ptReader->iError = 1; /* The input ends inside a block */
+            } else if (ptGzip->lInLen > lInPos) {
+                break; /* Left to the stream to make sense of */
+            }
+            ptGzip->lInPos = ptGzip->lInLen;
+            return 0;
+        }
+        if ((iSize = sizeBGZF(sIn)) == 0) break;
+        (atBlocks + iBlockNum)->sIn = sIn + 12 + getLE(sIn + 10, 2);
+        (atBlocks + iBlockNum)->iInLen = sIn + iSize - 8 - (atBlocks + iBlockNum)->sIn;
+        (atBlocks + iBlockNum)->lCRC = getLE(sIn + iSize - 8, 4);
+        (atBlocks + iBlockNum)->iLen = getLE(sIn + iSize - 4, 4);
+        (atBlocks + iBlockNum)->lOut = lOut;
+        if ((atBlocks + iBlockNum)->iLen > BGZFBLOCKLEN || sIn + iSize - 8 < (atBlocks + iBlockNum)->sIn) {
+            ptReader->iError = 1;
+            break;
+        }
+        lOut += (atBlocks + iBlockNum)->iLen;
+        iBlockNum++;
+    }
+
+    if (iBlockNum == 0) {
+        /* Members which are not BGZF blocks are inflated as a stream */
+        if (ptReader->iError) {
+            ptGzip->lInPos = ptGzip->lInLen;
+            return 0;
+        }
+        ptGzip->lInPos = lInPos;
+        ptGzip->iBGZF = 0;
+        return inflateGzip(ptReader);
+    }
+
+    while (ptReader->lDataMem - ptReader->lDataLen < lOut) {
+        ptReader->lDataMem *= 2;
+        ptReader->sData = realloc(ptReader->sData, ptReader->lDataMem);
+    }
+
+    iThreads = (ptReader->iThreads < iBlockNum) ? ptReader->iThreads : iBlockNum;
+    if (iThreads < 1) iThreads = 1;
+    for (i = 0; i < iThreads; i++) {
+        (atBatches + i)->ptBlocks = atBlocks;
+        (atBatches + i)->sOut = ptReader->sData + ptReader->lDataLen;
+        (atBatches + i)->iBlockNum = iBlockNum;
+        (atBatches + i)->iStep = iThreads;
+        (atBatches + i)->iFirst = i;
+    }
+#ifndef _WIN32
+    for (i = 1; i < iThreads; i++) {
+        if (pthread_create(atThreads + i, NULL, inflateBGZF, atBatches + i) != 0) break;
+    }
+    inflateBGZF(atBatches);
+    iThreads = i;
+    for (i = 1; i < iThreads; i++) pthread_join(atThreads[i], NULL);
+    /* Blocks of threads which could not be started */
+    for (i = iThreads; i < (ptReader->iThreads < iBlockNum ? ptReader->iThreads : iBlockNum); i++) inflateBGZF(atBatches + i);
+#else
+    for (i = 0; i < iThreads; i++) inflateBGZF(atBatches + i);
+#endif
+
+    /* Keep the text up to the first broken block */
+    for (i = 0; i < iBlockNum && ! (atBlocks + i)->iError; i++);
+    if (i < iBlockNum) {
+        ptReader->iError = 1;
+        ptGzip->iInEOF = 1;
+        ptGzip->lInPos = ptGzip->lInLen;
+        return (atBlocks + i)->lOut;
+    }
+    ptGzip->lInPos = lInPos;
+
+    return lOut;
+}
+
+/* Inflates more input into the reader's buffer, 0 at the end */
+static size_t inflateReader(gb_reader *ptReader) {
+    size_t lRead;
+
+    /* The empty block which ends BGZF input yields nothing, so go on */
+    do {
+        lRead = ptReader->ptGzip->iBGZF ? inflateBatch(ptReader) : inflateGzip(ptReader);
+    } while (lRead == 0 && ! ptReader->iError &&
+        (ptReader->ptGzip->lInPos < ptReader->ptGzip->lInLen || ! ptReader->ptGzip->iInEOF));
+
+    return lRead;
+}
+
+/* Switches the reader to inflating its input when it starts like gzip */
+static void startGzip(gb_reader *ptReader) {
+    gb_gzip *ptGzip;
+
+    if (! isGzip(ptReader->sData + ptReader->lPos, ptReader->lDataLen - ptReader->lPos)) return;
+
+    ptGzip = calloc(1, sizeof(gb_gzip));
+    ptGzip->sIn = ptReader->sData;
+    ptGzip->lInLen = ptReader->lDataLen;
+    ptGzip->lInPos = ptReader->lPos;
+    ptGzip->lInMem = ptReader->lDataMem;
+    ptGzip->iInEOF = ptReader->iEOF;
+    ptGzip->iBGZF = (ptReader->lDataLen - ptReader->lPos >= BGZFHEADLEN &&
+        sizeBGZF((unsigned char *) ptReader->sData + ptReader->lPos) != 0);
+    ptReader->ptGzip = ptGzip;
+
+    ptReader->lDataMem = MEGA;
+    ptReader->sData = malloc(ptReader->lDataMem);
+    ptReader->lDataLen = ptReader->lPos = 0;
+    ptReader->lShifted = 0; /* Offsets are into the inflated text from now on */
+    ptReader->iEOF = 0;
+    ptReader->iMapped = 0; /* The mapping is in sIn now */
+}
+
+/* Reads more input, dropping what has already been parsed */
+static int fillReader(gb_reader *ptReader) {
+    size_t lRead;
+
+    if (ptReader->iEOF) return 0;
+
+    if (ptReader->lPos > 0) {
+        memmove(ptReader->sData, ptReader->sData + ptReader->lPos, ptReader->lDataLen - ptReader->lPos);
+        ptReader->lShifted += ptReader->lPos;
+        ptReader->lDataLen -= ptReader->lPos;
+        ptReader->lPos = 0;
+    }
+
+    if (ptReader->lDataLen == ptReader->lDataMem) {
+        ptReader->lDataMem *= 2;
+        ptReader->sData = realloc(ptReader->sData, ptReader->lDataMem);
+    }
+
+    if (ptReader->ptGzip != NULL) lRead = inflateReader(ptReader);
+    else lRead = fread(ptReader->sData + ptReader->lDataLen, 1, ptReader->lDataMem - ptReader->lDataLen, ptReader->FSeqFile);
+    if (lRead == 0) {
+        ptReader->iEOF = 1;
+        return 0;
+    }
+    ptReader->lDataLen += lRead;
+
+    return 1;
+}
+
+/* Finds the first line starting with '//' whose first '/' is at or after
+   sFrom, which must be past the start of the input. Returns the end of that
+   line, or NULL when there is none or it is incomplete */
+static const char *findEnd(const char *sFrom, const char *sEnd) {
+    const char *sFound;
+
+    for (sFound = sFrom; (sFound = memchr(sFound, '/', sEnd - sFound)) != NULL; sFound++) {
+        if (*(sFound - 1) == '\n' && sFound + 1 < sEnd && *(sFound + 1) == '/') break;
+    }
+
+    return (sFound == NULL) ? NULL : memchr(sFound, '\n', sEnd - sFound);
+}
+
+/* Points the cursor at the lLen bytes of the next record and moves past them */
+static void startCursor(gb_reader *ptReader, gb_cursor *ptCursor, size_t lLen) {
+    ptCursor->sPos = ptReader->sData + ptReader->lPos;
+    ptCursor->sEnd = ptCursor->sPos + lLen;
+    ptCursor->iFlags = ptReader->iFlags;
+    ptCursor->iFields = ptReader->iFields;
+    ptCursor->psFeatures = ptReader->psFeatures;
+    ptCursor->pFilter = ptReader->pFilter;
+    ptCursor->pFilterArg = ptReader->pFilterArg;
+    ptCursor->iFiltered = 0;
+    ptCursor->ptArena = NULL;
+    ptCursor->ptParser = &(ptReader->tParser);
+    ptReader->lPos += lLen;
+}
+
+/* Finds the next LOCUS .. // block and moves past it */
+static int nextRecord(gb_reader *ptReader, gb_cursor *ptCursor) {
+    const char *sData, *sFound;
+    size_t lAvail, lScan, lLen;
+
+    /* Skip everything up to a LOCUS line */
+    for (;;) {
+        sData = ptReader->sData + ptReader->lPos;
+        lAvail = ptReader->lDataLen - ptReader->lPos;
+        if (lAvail >= 5 && memcmp(sData, "LOCUS", 5) == 0) break;
+        if ((sFound = memchr(sData, '\n', lAvail)) != NULL) {
+            ptReader->lPos += sFound - sData + 1;
+        } else if (! fillReader(ptReader)) {
+            ptReader->lPos = ptReader->lDataLen;
+            return 0;
+        }
+    }
+
+    /* The record ends with the first line starting with '//' */
+    lScan = 5;
+    for (;;) {
+        sData = ptReader->sData + ptReader->lPos;
+        lAvail = ptReader->lDataLen - ptReader->lPos;
+        if ((sFound = findEnd(sData + lScan, sData + lAvail)) != NULL) {
+            lLen = sFound - sData + 1;
+            break;
+        }
+        /* Rescan the last line once more input has been read */
+        for (lScan = lAvail; lScan > 5 && *(sData + lScan - 1) != '\n'; lScan--);
+        if (! fillReader(ptReader)) {
+            lLen = ptReader->lDataLen - ptReader->lPos;
+            break;
+        }
+    }
+
+    startCursor(ptReader, ptCursor, lLen);
+
+    return 1;
+}
+
+static gb_reader *newReader(FILE *FSeqFile, int iOwnFile, unsigned int iFlags) {
+    gb_reader *ptReader;
+
+    ptReader = malloc(sizeof(gb_reader));
+    ptReader->FSeqFile = FSeqFile;
+    ptReader->iOwnFile = iOwnFile;
+    ptReader->iEOF = 0;
+    ptReader->iError = 0;
+    ptReader->iMapped = 0;
+    ptReader->iFlags = iFlags;
+    ptReader->sData = NULL;
+    ptReader->lDataLen = 0;
+    ptReader->lDataMem = 0;
+    ptReader->lPos = 0;
+    ptReader->lDropped = 0;
+    ptReader->lShifted = 0;
+    ptReader->ptSpare = NULL;
+    ptReader->ptLive = NULL;
+    initParser(&(ptReader->tParser));
+    ptReader->ptGzip = NULL;
+    ptReader->iThreads = 1;
+    ptReader->iFields = GB_ALLFIELDS;
+    ptReader->psFeatures = NULL;
+    ptReader->pFilter = NULL;
+    ptReader->pFilterArg = NULL;
+
+    return ptReader;
+}
+
+/* Opens a GBF file for sequential reading, NULL means stdin */
+gb_reader *openGBFF(gb_string spFileName, unsigned int iFlags) {
+    gb_reader *ptReader;
+    FILE *FSeqFile;
+#ifndef _WIN32
+    struct stat tStat;
+    off_t lOffset;
+    void *pMap;
+#endif
+
     if (spFileName == NULL) {
         FSeqFile = stdin;
     } else {
@@ -691,81 +2006,331 @@ gb_data **parseGBFF(gb_string spFileName) {
             return NULL;
         } else {
             FSeqFile = fopen(spFileName, "r");
+            if (FSeqFile == NULL) return NULL;
         }
     }
-   
-    initRegEx(); /* Initalize for regular expression */
 
-    pptGBDatas = malloc(iGBFSeqNum * sizeof(gb_data *));
+    ptReader = newReader(FSeqFile, spFileName != NULL, iFlags);
 
-    do {
-        if (iGBFSeqNum == iGBFSeqPos) {
-            iGBFSeqNum += INITGBFSEQNUM;
-            pptGBDatas = realloc(pptGBDatas, iGBFSeqNum * sizeof(gb_data *));
+#ifndef _WIN32
+    /* Regular files are mapped, so records can be parsed in place */
+    if ((iFlags & GB_MMAP) && fstat(fileno(FSeqFile), &tStat) == 0 && S_ISREG(tStat.st_mode) && tStat.st_size > 0) {
+        lOffset = lseek(fileno(FSeqFile), 0, SEEK_CUR);
+        pMap = mmap(NULL, tStat.st_size, PROT_READ, MAP_PRIVATE, fileno(FSeqFile), 0);
+        if (pMap != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(pMap, tStat.st_size, MADV_SEQUENTIAL);
+#endif
+            ptReader->sData = pMap;
+            ptReader->lDataLen = tStat.st_size;
+            ptReader->lPos = (lOffset > 0) ? lOffset : 0;
+            ptReader->iEOF = 1;
+            ptReader->iMapped = 1;
         }
-        *(pptGBDatas + iGBFSeqPos) = _parseGBFF(FSeqFile);
-    } while (*(pptGBDatas + iGBFSeqPos++) != NULL);
-    
-    if (spFileName) fclose(FSeqFile);
+    }
+#endif
+
+    if (ptReader->sData == NULL) {
+        ptReader->lDataMem = MEGA;
+        ptReader->sData = malloc(ptReader->lDataMem);
+        fillReader(ptReader);
+    }
 
-    freeRegEx();
+    startGzip(ptReader);
 
-    return pptGBDatas;
+    return ptReader;
 }
 
-/* Free a single gb_data structure and all its contents */
-static void freeSingleGBData(gb_data *ptGBData) {
-    unsigned int i;
-    gb_feature *ptFeatures = NULL;
-    gb_reference *ptReferences = NULL;
-    unsigned int iFeatureNum = 0;
-    unsigned int iReferenceNum = 0;
+/* Sets how many threads inflate BGZF input */
+void setThreadsGBFF(gb_reader *ptReader, unsigned int iThreads) {
+    if (ptReader != NULL) ptReader->iThreads = (iThreads > BGZFBATCHNUM) ? BGZFBATCHNUM : iThreads;
+}
 
-    if (ptGBData == NULL) return;
+/* Limits parsing to the given fields and, within FEATURES, to the features
+   with the given keys (a NULL terminated list which must outlive the reader,
+   or NULL for all of them). Everything else is left empty and passed over
+   at the cost of finding its lines */
+void selectGBFF(gb_reader *ptReader, unsigned int iFields, const char **psFeatures) {
+    if (ptReader == NULL) return;
+
+    ptReader->iFields = iFields;
+    ptReader->psFeatures = psFeatures;
+}
 
-    ptFeatures = ptGBData->ptFeatures;
-    iFeatureNum = ptGBData->iFeatureNum;
+/* Has readGBFF() pass over the records for which pFilter returns 0. It is
+   called with the LOCUS line and, if they are selected, the DEFINITION,
+   ACCESSION and VERSION fields parsed, before anything else of the record */
+void filterGBFF(gb_reader *ptReader, gb_filter pFilter, void *pArg) {
+    if (ptReader == NULL) return;
 
-    /* Release memory space for features */    
-    if (ptFeatures != NULL) {
-        for (i = 0; i < iFeatureNum; i++) {
-            free((ptFeatures + i)->ptLocation);
-            if ((ptFeatures + i)->ptQualifier != NULL) {
-                free(((ptFeatures + i)->ptQualifier)->sQualifier);
-                free((ptFeatures + i)->ptQualifier);
-            }
+    ptReader->pFilter = pFilter;
+    ptReader->pFilterArg = pArg;
+}
+
+/* Reads records out of memory, which must outlive the reader; GB_MMAP is ignored */
+gb_reader *openGBMemory(const char *sData, unsigned long lLen, unsigned int iFlags) {
+    gb_reader *ptReader;
+
+    ptReader = newReader(NULL, 0, iFlags);
+    ptReader->sData = (char *) sData;
+    ptReader->lDataLen = lLen;
+    ptReader->iEOF = 1;
+
+    return ptReader;
+}
+
+/* Moves past whole records of at least lMinLen bytes in all, unless the input
+   ends first, for parsing elsewhere with openGBMemory(). Returns 0 at the end */
+int readGBBlock(gb_reader *ptReader, size_t lMinLen, gb_block *ptBlock) {
+    const char *sData, *sFound;
+    size_t lAvail, lScan, lLen;
+
+    ptBlock->sData = ptBlock->sOwned = NULL;
+    ptBlock->lLen = 0;
+    ptBlock->lOffset = 0;
+    ptBlock->iMapped = 0;
+
+    if (ptReader == NULL) return 0;
+
+    /* The block ends with the first line starting with '//' past lMinLen */
+    lScan = (lMinLen > 0) ? lMinLen : 1;
+    for (;;) {
+        sData = ptReader->sData + ptReader->lPos;
+        lAvail = ptReader->lDataLen - ptReader->lPos;
+        if (lScan < lAvail && (sFound = findEnd(sData + lScan, sData + lAvail)) != NULL) {
+            lLen = sFound - sData + 1;
+            break;
+        }
+        if (lScan < lAvail) {
+            /* Rescan the last line once more input has been read */
+            for (lScan = lAvail; lScan > lMinLen && lScan > 1 && *(sData + lScan - 1) != '\n'; lScan--);
+        }
+        if (! fillReader(ptReader)) {
+            lLen = ptReader->lDataLen - ptReader->lPos;
+            break;
         }
-        free(ptFeatures);
     }
 
-    /* Release memory space for References */
-    ptReferences = ptGBData->ptReferences;
-    iReferenceNum = ptGBData->iReferenceNum;
-    if (ptReferences != NULL) {
-        for (i = 0; i < iReferenceNum; i++) {
-            free((ptReferences + i)->sAuthors);
-            free((ptReferences + i)->sConsrtm);
-            free((ptReferences + i)->sTitle);
-            free((ptReferences + i)->sJournal);
-            free((ptReferences + i)->sMedline);
-            free((ptReferences + i)->sPubMed);
-            free((ptReferences + i)->sRemark);
+    if (lLen == 0) return 0;
+
+    if (ptReader->lDataMem == 0) {
+        ptBlock->sData = ptReader->sData + ptReader->lPos;
+        ptBlock->iMapped = ptReader->iMapped;
+    } else {
+        ptBlock->sOwned = malloc(lLen);
+        memcpy(ptBlock->sOwned, ptReader->sData + ptReader->lPos, lLen);
+        ptBlock->sData = ptBlock->sOwned;
+    }
+    ptBlock->lLen = lLen;
+    ptBlock->lOffset = ptReader->lShifted + ptReader->lPos;
+    ptReader->lPos += lLen;
+
+    return 1;
+}
+
+void freeGBBlock(gb_block *ptBlock) {
+#if !defined(_WIN32) && defined(MADV_DONTNEED)
+    /* Pages wholly inside a mapped block are not needed by any other block */
+    if (ptBlock->iMapped) {
+        size_t lPageMask = (size_t) sysconf(_SC_PAGESIZE) - 1;
+        size_t lStart = ((size_t) ptBlock->sData + lPageMask) & ~lPageMask;
+        size_t lEnd = ((size_t) ptBlock->sData + ptBlock->lLen) & ~lPageMask;
+        if (lEnd > lStart) madvise((void *) lStart, lEnd - lStart, MADV_DONTNEED);
+    }
+#endif
+    free(ptBlock->sOwned);
+    ptBlock->sData = ptBlock->sOwned = NULL;
+    ptBlock->lLen = 0;
+}
+
+/* Gets an arena for the next record, reusing the one of the last freed record */
+static gb_arena *takeArena(gb_reader *ptReader, size_t lSizeHint) {
+    gb_arena *ptArena;
+
+    if (ptReader->ptSpare != NULL) {
+        ptArena = ptReader->ptSpare;
+        ptReader->ptSpare = NULL;
+    } else {
+        ptArena = newArena(lSizeHint);
+    }
+
+    ptArena->ptReader = ptReader;
+    ptArena->ptPrev = NULL;
+    ptArena->ptNext = ptReader->ptLive;
+    if (ptReader->ptLive != NULL) ptReader->ptLive->ptPrev = ptArena;
+    ptReader->ptLive = ptArena;
+
+    return ptArena;
+}
+
+/* Hands the arena of a freed record back to its reader, or frees it */
+static void releaseArena(gb_arena *ptArena) {
+    gb_reader *ptReader = ptArena->ptReader;
+
+    if (ptReader == NULL) {
+        freeArena(ptArena);
+        return;
+    }
+
+    if (ptArena->ptPrev != NULL) ptArena->ptPrev->ptNext = ptArena->ptNext;
+    else ptReader->ptLive = ptArena->ptNext;
+    if (ptArena->ptNext != NULL) ptArena->ptNext->ptPrev = ptArena->ptPrev;
+
+    if (ptReader->ptSpare == NULL) {
+        resetArena(ptArena);
+        ptArena->ptReader = NULL;
+        ptReader->ptSpare = ptArena;
+    } else {
+        freeArena(ptArena);
+    }
+}
+
+/* Parses the record under the cursor into an arena of the reader */
+static gb_data *parseCursor(gb_reader *ptReader, gb_cursor *ptCursor) {
+    gb_data *ptGBData;
+    unsigned long long lOffset = ptReader->lShifted + (ptCursor->sPos - ptReader->sData);
+    unsigned long lLen = ptCursor->sEnd - ptCursor->sPos;
+
+    /* The parsed record takes about as much memory as its text */
+    ptCursor->ptArena = takeArena(ptReader, lLen + sizeof(gb_data));
+
+    if ((ptGBData = _parseGBFF(ptCursor)) != NULL) {
+        ptGBData->lOffset = lOffset;
+        ptGBData->lTextLen = lLen;
+    }
+
+    return ptGBData;
+}
+
+/* Parses the next record, NULL at the end of the file or when the record
+   cannot be parsed (see errorGBFF()). With GB_ZEROCOPY its spans into the
+   input are only valid until the next call */
+gb_data *readGBFF(gb_reader *ptReader) {
+    gb_cursor tCursor;
+    gb_data *ptGBData;
+
+    if (ptReader == NULL) return NULL;
+
+    /* Records turned down by the filter are passed over */
+    do {
+#if !defined(_WIN32) && defined(MADV_DONTNEED)
+        /* Spans of earlier records are dead now, so their pages need not stay resident */
+        if (ptReader->iMapped && ptReader->lPos >= ptReader->lDropped + MAPDROPLEN) {
+            size_t lEnd = ptReader->lPos & ~((size_t) sysconf(_SC_PAGESIZE) - 1);
+            madvise(ptReader->sData + ptReader->lDropped, lEnd - ptReader->lDropped, MADV_DONTNEED);
+            ptReader->lDropped = lEnd;
         }
-        free(ptReferences);
+#endif
+
+        if (nextRecord(ptReader, &tCursor) == 0) return NULL;
+    } while ((ptGBData = parseCursor(ptReader, &tCursor)) == NULL && tCursor.iFiltered);
+
+    if (ptGBData == NULL) ptReader->iError = 1;
+
+    return ptGBData;
+}
+
+/* Parses the record whose text is the lLen bytes at lOffset, as given by
+   the lOffset and lTextLen of an earlier read of the same file. Compressed
+   input cannot be fetched from. Returns NULL when there is no record there;
+   otherwise reading goes on after the record, and spans into the input are
+   valid until the next call as with readGBFF() */
+gb_data *fetchGBFF(gb_reader *ptReader, unsigned long long lOffset, unsigned long lLen) {
+    gb_cursor tCursor;
+
+    if (ptReader == NULL || ptReader->ptGzip != NULL || lLen < 5) return NULL;
+
+    if (ptReader->iMapped) {
+        if (lOffset > ptReader->lDataLen || lLen > ptReader->lDataLen - lOffset) return NULL;
+        ptReader->lPos = lOffset;
+    } else {
+        if (ptReader->lDataMem < lLen) {
+            ptReader->lDataMem = lLen;
+            ptReader->sData = realloc(ptReader->sData, ptReader->lDataMem);
+        }
+#ifdef _WIN32
+        if (_fseeki64(ptReader->FSeqFile, lOffset, SEEK_SET) != 0) return NULL;
+#else
+        if (fseeko(ptReader->FSeqFile, lOffset, SEEK_SET) != 0) return NULL;
+#endif
+        ptReader->lShifted = lOffset;
+        ptReader->lDataLen = fread(ptReader->sData, 1, lLen, ptReader->FSeqFile);
+        ptReader->lPos = 0;
+        ptReader->iEOF = 0;
+        if (ptReader->lDataLen != lLen) return NULL;
     }
 
-    free(ptGBData->sDef);
-    free(ptGBData->sAccession);
-    free(ptGBData->sComment);
-    free(ptGBData->sGI);
-    free(ptGBData->sKeywords);
-    free(ptGBData->sLineage);
-    free(ptGBData->sOrganism);
-    free(ptGBData->sSequence);
-    free(ptGBData->sSource);
-    free(ptGBData->sVersion);
+    if (memcmp(ptReader->sData + ptReader->lPos, "LOCUS", 5) != 0) return NULL;
 
-    free(ptGBData);
+    startCursor(ptReader, &tCursor, lLen);
+    tCursor.pFilter = NULL;
+
+    return parseCursor(ptReader, &tCursor);
+}
+
+/* Whether reading stopped at a record which could not be parsed, or at
+   compressed input which could not be inflated */
+int errorGBFF(gb_reader *ptReader) {
+    return (ptReader == NULL) ? 0 : ptReader->iError;
+}
+
+void closeGBFF(gb_reader *ptReader) {
+    if (ptReader == NULL) return;
+
+#ifndef _WIN32
+    if (ptReader->iMapped) munmap(ptReader->sData, ptReader->lDataLen);
+#endif
+    if (ptReader->lDataMem != 0) free(ptReader->sData);
+
+    if (ptReader->ptGzip != NULL) {
+#ifndef _WIN32
+        if (ptReader->ptGzip->lInMem == 0) munmap(ptReader->ptGzip->sIn, ptReader->ptGzip->lInLen);
+        else
+#endif
+        free(ptReader->ptGzip->sIn);
+        if (ptReader->ptGzip->iStream) inflateEnd(&(ptReader->ptGzip->tStream));
+        free(ptReader->ptGzip);
+    }
+
+    /* Records still alive keep their arenas, which are freed with them */
+    for (; ptReader->ptLive != NULL; ptReader->ptLive = ptReader->ptLive->ptNext) ptReader->ptLive->ptReader = NULL;
+    if (ptReader->ptSpare != NULL) freeArena(ptReader->ptSpare);
+    freeParser(&(ptReader->tParser));
+
+    if (ptReader->iOwnFile) fclose(ptReader->FSeqFile);
+
+    free(ptReader);
+}
+
+/* parse sequence datas in a GBF file */
+gb_data **parseGBFF(gb_string spFileName) {
+    unsigned int iGBFSeqPos = 0;
+    unsigned int iGBFSeqNum = INITGBFSEQNUM;
+    gb_data **pptGBDatas;
+    gb_reader *ptReader;
+
+    if ((ptReader = openGBFF(spFileName, GB_MMAP)) == NULL) return NULL;
+
+    pptGBDatas = malloc(iGBFSeqNum * sizeof(gb_data *));
+
+    do {
+        if (iGBFSeqNum == iGBFSeqPos) {
+            iGBFSeqNum *= 2;
+            pptGBDatas = realloc(pptGBDatas, iGBFSeqNum * sizeof(gb_data *));
+        }
+        *(pptGBDatas + iGBFSeqPos) = readGBFF(ptReader);
+    } while (*(pptGBDatas + iGBFSeqPos++) != NULL);
+
+    closeGBFF(ptReader);
+
+    return pptGBDatas;
+}
+
+/* Free a single gb_data structure and all its contents, which live in its arena */
+void freeGBRecord(gb_data *ptGBData) {
+    if (ptGBData == NULL) return;
+
+    releaseArena(ptGBData->ptArena);
 }
 
 void freeGBData(gb_data **pptGBData) {
@@ -774,7 +2339,7 @@ void freeGBData(gb_data **pptGBData) {
     if (pptGBData == NULL) return;
 
     for (iSeqPos = 0; *(pptGBData + iSeqPos) != NULL; iSeqPos++) {
-        freeSingleGBData(*(pptGBData + iSeqPos));
+        freeGBRecord(*(pptGBData + iSeqPos));
     }
 
     free(pptGBData);
@@ -783,9 +2348,11 @@ void freeGBData(gb_data **pptGBData) {
 static void getRevCom(gb_string sSequence) {
     char c;
     unsigned int k;
-    unsigned long i, j;
+    unsigned long i, j, lLen = strlen(sSequence);
     
-    for (i = 0, j = strlen(sSequence) - 1; i < j; i++, j--) {
+    /* The middle base of an odd length is complemented with itself */
+    for (i = 0; i < (lLen + 1) / 2; i++) {
+	j = lLen - 1 - i;
 	c = *(sSequence + i);
 	*(sSequence + i) = 'X';
 	for (k = 0; k < iBaseLen; k++)
@@ -829,3 +2396,237 @@ gb_string getSequence(gb_string sSequence, gb_feature *ptFeature) {
     return sSequenceTemp;
 }
 
+/* Packs a sequence into memory of its own, see freePacked() */
+int packSequence(gb_packed *ptPacked, const char *sSequence, unsigned long lLen) {
+    gb_packed tPacked;
+
+    ptPacked->sData = NULL;
+    ptPacked->lLen = 0;
+    ptPacked->iBits = 0;
+    ptPacked->cCase = 'a';
+
+    tPacked.sData = malloc(packedLen(lLen, 4) + 1);
+    if (packBases(tPacked.sData, sSequence, lLen, &tPacked) != 0) {
+        free(tPacked.sData);
+        return -1;
+    }
+    tPacked.sData = realloc(tPacked.sData, packedLen(lLen, tPacked.iBits) + 1);
+    *ptPacked = tPacked;
+
+    return 0;
+}
+
+/* Writes lLen bases from the 0-based lStart on, and a '\0' */
+void unpackSequence(gb_string sOut, const gb_packed *ptPacked, unsigned long lStart, unsigned long lLen) {
+    unpackBases(sOut, ptPacked, lStart, lLen, 0);
+    *(sOut + lLen) = '\0';
+}
+
+/* Frees a sequence packed by packSequence(); those of records live in their arenas */
+void freePacked(gb_packed *ptPacked) {
+    free(ptPacked->sData);
+    ptPacked->sData = NULL;
+    ptPacked->lLen = 0;
+    ptPacked->iBits = 0;
+}
+
+/* Same as getSequence(), unpacking only the bases of the feature */
+gb_string getPackedSequence(const gb_packed *ptPacked, gb_feature *ptFeature) {
+    unsigned long lSeqLen = 1; /* For the '\0' characher */
+    unsigned long lStart, lEnd;
+    unsigned int i, j;
+    int iRevCom = (ptFeature->cDirection == REVCOM);
+    gb_string sSequenceTemp;
+
+    for (i = 0; i < ptFeature->iLocationNum; i++)
+        lSeqLen += (((ptFeature->ptLocation) + i)->lEnd - ((ptFeature->ptLocation) + i)->lStart + 1);
+
+    sSequenceTemp = malloc(lSeqLen * sizeof(char));
+
+    lSeqLen = 0;
+
+    /* The reverse complement takes the locations last to first */
+    for (j = 0; j < ptFeature->iLocationNum; j++) {
+        i = iRevCom ? ptFeature->iLocationNum - 1 - j : j;
+        lStart = ((ptFeature->ptLocation) + i)->lStart;
+        lEnd = ((ptFeature->ptLocation) + i)->lEnd;
+        unpackBases(sSequenceTemp + lSeqLen, ptPacked, lStart - 1, lEnd - lStart + 1, iRevCom);
+        lSeqLen += (lEnd - lStart + 1);
+    }
+
+    *(sSequenceTemp + lSeqLen) = '\0';
+
+    return sSequenceTemp;
+}
+
+/* Reverse complements a packed sequence in place */
+void getPackedRevCom(gb_packed *ptPacked) {
+    unsigned char *sData = ptPacked->sData;
+    unsigned long i, j;
+    unsigned int iShiftI, iShiftJ, iCodeI, iCodeJ, iMask;
+    unsigned int iBits = ptPacked->iBits;
+
+    if (ptPacked->lLen == 0 || iBits == 0) return;
+
+    iMask = (1 << iBits) - 1;
+    for (i = 0, j = ptPacked->lLen - 1; i <= j; i++, j--) {
+        iShiftI = iBits * (i % (8 / iBits));
+        iShiftJ = iBits * (j % (8 / iBits));
+        iCodeI = (*(sData + i * iBits / 8) >> iShiftI) & iMask;
+        iCodeJ = (*(sData + j * iBits / 8) >> iShiftJ) & iMask;
+        iCodeI = (iBits == 2) ? iCodeI ^ 2 : acPackedCom4[iCodeI];
+        iCodeJ = (iBits == 2) ? iCodeJ ^ 2 : acPackedCom4[iCodeJ];
+        *(sData + i * iBits / 8) = (*(sData + i * iBits / 8) & ~(iMask << iShiftI)) | (iCodeJ << iShiftI);
+        *(sData + j * iBits / 8) = (*(sData + j * iBits / 8) & ~(iMask << iShiftJ)) | (iCodeI << iShiftJ);
+        if (j == 0) break;
+    }
+}
+
+static int compareIntervals(const void *pA, const void *pB) {
+    const gb_interval *ptA = pA;
+    const gb_interval *ptB = pB;
+
+    return (ptA->lStart > ptB->lStart) - (ptA->lStart < ptB->lStart);
+}
+
+static int compareFeatureNums(const void *pA, const void *pB) {
+    unsigned int iA = *(const unsigned int *) pA;
+    unsigned int iB = *(const unsigned int *) pB;
+
+    return (iA > iB) - (iA < iB);
+}
+
+/* Builds the index of the record's feature locations in its arena, once.
+   The locations are sorted by start and read as an implicit binary tree:
+   leaves sit at even positions, a node of level k has its k low bits set
+   and its children k-1 levels down at either side. Each keeps the largest
+   end under it, so subtrees ending before a query are skipped */
+gb_index *indexFeatures(gb_data *ptGBData) {
+    gb_index *ptIndex;
+    gb_interval *ptIntervals;
+    gb_feature *ptFeature;
+    gb_location *ptLocation;
+    unsigned long i, x, lNum = 0, lLast = 0, lLastMax = 0, lMax;
+    int k;
+
+    if (ptGBData->ptIndex != NULL) return ptGBData->ptIndex;
+
+    for (ptFeature = ptGBData->ptFeatures; ptFeature < ptGBData->ptFeatures + ptGBData->iFeatureNum; ptFeature++)
+        lNum += ptFeature->iLocationNum;
+
+    ptIndex = allocArena(ptGBData->ptArena, sizeof(gb_index));
+    ptIntervals = allocArena(ptGBData->ptArena, lNum * sizeof(gb_interval));
+
+    lNum = 0;
+    for (ptFeature = ptGBData->ptFeatures; ptFeature < ptGBData->ptFeatures + ptGBData->iFeatureNum; ptFeature++) {
+        for (ptLocation = ptFeature->ptLocation; ptLocation < ptFeature->ptLocation + ptFeature->iLocationNum; ptLocation++) {
+            (ptIntervals + lNum)->lStart = ptLocation->lStart < ptLocation->lEnd ? ptLocation->lStart : ptLocation->lEnd;
+            (ptIntervals + lNum)->lEnd = ptLocation->lStart < ptLocation->lEnd ? ptLocation->lEnd : ptLocation->lStart;
+            (ptIntervals + lNum)->iFeature = ptFeature - ptGBData->ptFeatures;
+            lNum++;
+        }
+    }
+    qsort(ptIntervals, lNum, sizeof(gb_interval), compareIntervals);
+
+    for (i = 0; i < lNum; i += 2) {
+        lLast = i;
+        lLastMax = (ptIntervals + i)->lMaxEnd = (ptIntervals + i)->lEnd;
+    }
+
+    /* A node missing its right subtree takes the largest end of the last
+       subtree instead, which is all that lies right of it */
+    for (k = 1; (1UL << k) <= lNum; k++) {
+        x = 1UL << (k - 1);
+        for (i = (x << 1) - 1; i < lNum; i += x << 2) {
+            lMax = (ptIntervals + i)->lEnd;
+            if ((ptIntervals + i - x)->lMaxEnd > lMax) lMax = (ptIntervals + i - x)->lMaxEnd;
+            if (i + x < lNum) {
+                if ((ptIntervals + i + x)->lMaxEnd > lMax) lMax = (ptIntervals + i + x)->lMaxEnd;
+            } else if (lLastMax > lMax) lMax = lLastMax;
+            (ptIntervals + i)->lMaxEnd = lMax;
+        }
+        lLast = ((lLast >> k) & 1) ? lLast - x : lLast + x;
+        if (lLast < lNum && (ptIntervals + lLast)->lMaxEnd > lLastMax) lLastMax = (ptIntervals + lLast)->lMaxEnd;
+    }
+
+    ptIndex->ptIntervals = ptIntervals;
+    ptIndex->lIntervalNum = lNum;
+    ptIndex->iLevel = lNum == 0 ? -1 : k - 1;
+    ptGBData->ptIndex = ptIndex;
+
+    return ptIndex;
+}
+
+/* Features with a location overlapping lFrom..lTo, both 1-based and
+   inclusive, in the order of the record. The list ends with NULL and is
+   freed with free(); the features live in the record */
+gb_feature **findFeatures(gb_data *ptGBData, unsigned long lFrom, unsigned long lTo) {
+    gb_index *ptIndex = indexFeatures(ptGBData);
+    gb_interval *ptIntervals = ptIndex->ptIntervals;
+    gb_feature **pptFound;
+    unsigned long i, lStop, lNum = ptIndex->lIntervalNum;
+    unsigned int *piHits = NULL;
+    unsigned int iHitNum = 0, iHitMem = 0, j, iFoundNum = 0;
+    int iTop = 0;
+
+    struct tNode {
+        unsigned long x;
+        int k;
+        int iLeftDone;
+    } atStack[INDEXSTACKLEN];
+
+#define addHit(p) do { \
+        if (iHitNum == iHitMem) { \
+            iHitMem = iHitMem ? iHitMem * 2 : INITFEATURENUM; \
+            piHits = realloc(piHits, iHitMem * sizeof(unsigned int)); \
+        } \
+        *(piHits + iHitNum++) = (p)->iFeature; \
+    } while (0)
+
+    if (ptIndex->iLevel >= 0) {
+        atStack[iTop].x = (1UL << ptIndex->iLevel) - 1;
+        atStack[iTop].k = ptIndex->iLevel;
+        atStack[iTop++].iLeftDone = 0;
+    }
+
+    while (iTop > 0) {
+        struct tNode tNode = atStack[--iTop];
+
+        if (tNode.k <= INDEXSCANLEVEL) {
+            /* Small subtrees are scanned in order of start */
+            i = tNode.x >> tNode.k << tNode.k;
+            lStop = i + (1UL << (tNode.k + 1)) - 1;
+            if (lStop > lNum) lStop = lNum;
+            for (; i < lStop && (ptIntervals + i)->lStart <= lTo; i++)
+                if ((ptIntervals + i)->lEnd >= lFrom) addHit(ptIntervals + i);
+        } else if (! tNode.iLeftDone) {
+            /* Come back for the node and its right subtree after the left one */
+            i = tNode.x - (1UL << (tNode.k - 1));
+            atStack[iTop] = tNode;
+            atStack[iTop++].iLeftDone = 1;
+            if (i >= lNum || (ptIntervals + i)->lMaxEnd >= lFrom) {
+                atStack[iTop].x = i;
+                atStack[iTop].k = tNode.k - 1;
+                atStack[iTop++].iLeftDone = 0;
+            }
+        } else if (tNode.x < lNum && (ptIntervals + tNode.x)->lStart <= lTo) {
+            if ((ptIntervals + tNode.x)->lEnd >= lFrom) addHit(ptIntervals + tNode.x);
+            atStack[iTop].x = tNode.x + (1UL << (tNode.k - 1));
+            atStack[iTop].k = tNode.k - 1;
+            atStack[iTop++].iLeftDone = 0;
+        }
+    }
+
+#undef addHit
+
+    /* A feature is listed once however many of its locations overlap */
+    if (iHitNum > 1) qsort(piHits, iHitNum, sizeof(unsigned int), compareFeatureNums);
+    pptFound = malloc((iHitNum + 1) * sizeof(gb_feature *));
+    for (j = 0; j < iHitNum; j++)
+        if (j == 0 || *(piHits + j) != *(piHits + j - 1))
+            *(pptFound + iFoundNum++) = ptGBData->ptFeatures + *(piHits + j);
+    *(pptFound + iFoundNum) = NULL;
+    free(piHits);
+
+    return pptFound;
+}
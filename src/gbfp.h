@@ -1,9 +1,21 @@
+#ifndef GBFP_H
+#define GBFP_H
+
 #define LINELEN             65536
 #define MEGA                1048576
+#define MAPDROPLEN          (64 * MEGA)
 #define INITGBFSEQNUM       4
 #define INITREFERENCENUM    16
 #define INITFEATURENUM      64
 #define INITQUALIFIERNUM    128
+#define ARENAMINLEN         4096
+#define INITBUFFERLEN       256
+#define SEQUENCESLACK       32      /* Room for vector stores past the sequence */
+#define BGZFHEADLEN         18      /* Header of a BGZF block, up to its size */
+#define BGZFBLOCKLEN        65536   /* Most text a BGZF block holds */
+#define BGZFBATCHNUM        64      /* BGZF blocks inflated together */
+#define INDEXSCANLEVEL      3       /* Subtrees of the feature index scanned in a row */
+#define INDEXSTACKLEN       64
 #define FIELDLEN            16
 #define FEATURELEN          16
 #define QUALIFIERLEN        16
@@ -27,8 +39,54 @@
 #define LONG                'L'
 #define STRING              'S'
 
+#define GB_MMAP             1   /* Map regular files instead of reading them */
+#define GB_ZEROCOPY         2   /* Fill spans only, pointing into the input */
+#define GB_PACKED           4   /* Keep sequences packed in tPacked where they allow it */
+
+/* Fields to parse, see selectGBFF(); the LOCUS line is always parsed */
+#define GB_DEFINITION       0x001
+#define GB_ACCESSION        0x002
+#define GB_VERSION          0x004
+#define GB_KEYWORDS         0x008
+#define GB_SOURCE           0x010
+#define GB_REFERENCE        0x020
+#define GB_COMMENT          0x040
+#define GB_FEATURES         0x080
+#define GB_ORIGIN           0x100
+#define GB_ALLFIELDS        0x1ff
+
 typedef char *gb_string;
 
+typedef struct tGBReader gb_reader;
+typedef struct tArena gb_arena;
+
+/* A piece of text which is not '\0' terminated. Spans mirror the matching
+   gb_string, except with GB_ZEROCOPY where the string is left NULL and the
+   span points into the input and is valid until the next readGBFF() call.
+   Joined lines are rewritten into the record's arena instead */
+typedef struct tSpan {
+    const char *sStr;
+    unsigned long lLen;
+} gb_span;
+
+/* A run of whole records handed out by readGBBlock() */
+typedef struct tGBBlock {
+    const char *sData;
+    unsigned long lLen;
+    unsigned long long lOffset; /* Of sData in the input */
+    char *sOwned;   /* Copy of the input when it is not mapped */
+    int iMapped;
+} gb_block;
+
+/* A sequence packed 2 bits a base when it only holds ACGT, else 4 bits a
+   base for the IUPAC codes in sNorBase. The first base is in the low bits */
+typedef struct tPacked {
+    unsigned char *sData;
+    unsigned long lLen;     /* In bases */
+    unsigned int iBits;     /* 2 or 4, 0 when there is no packed sequence */
+    char cCase;             /* 'A' for upper case bases, 'a' for lower case */
+} gb_packed;
+
 typedef struct tReference {
     gb_string sAuthors;
     gb_string sConsrtm;
@@ -45,9 +103,122 @@ typedef struct tLocation {
     unsigned long lEnd;
 } gb_location;
 
+/* Qualifier names of the INSDC feature table, see qualifierKey() */
+enum {
+    GB_QUAL_UNKNOWN,    /* Any other name, which is still in tQualifier */
+    GB_QUAL_ALLELE,
+    GB_QUAL_ALTITUDE,
+    GB_QUAL_ANTICODON,
+    GB_QUAL_ARTIFICIAL_LOCATION,
+    GB_QUAL_BIO_MATERIAL,
+    GB_QUAL_BOUND_MOIETY,
+    GB_QUAL_CELL_LINE,
+    GB_QUAL_CELL_TYPE,
+    GB_QUAL_CHROMOSOME,
+    GB_QUAL_CIRCULAR_RNA,
+    GB_QUAL_CITATION,
+    GB_QUAL_CLONE,
+    GB_QUAL_CLONE_LIB,
+    GB_QUAL_CODON_START,
+    GB_QUAL_COLLECTED_BY,
+    GB_QUAL_COLLECTION_DATE,
+    GB_QUAL_COMPARE,
+    GB_QUAL_COUNTRY,
+    GB_QUAL_CULTIVAR,
+    GB_QUAL_CULTURE_COLLECTION,
+    GB_QUAL_DB_XREF,
+    GB_QUAL_DEV_STAGE,
+    GB_QUAL_DIRECTION,
+    GB_QUAL_EC_NUMBER,
+    GB_QUAL_ECOTYPE,
+    GB_QUAL_ENVIRONMENTAL_SAMPLE,
+    GB_QUAL_ESTIMATED_LENGTH,
+    GB_QUAL_EXCEPTION,
+    GB_QUAL_EXPERIMENT,
+    GB_QUAL_FOCUS,
+    GB_QUAL_FREQUENCY,
+    GB_QUAL_FUNCTION,
+    GB_QUAL_GAP_TYPE,
+    GB_QUAL_GENE,
+    GB_QUAL_GENE_SYNONYM,
+    GB_QUAL_GEO_LOC_NAME,
+    GB_QUAL_GERMLINE,
+    GB_QUAL_HAPLOGROUP,
+    GB_QUAL_HAPLOTYPE,
+    GB_QUAL_HOST,
+    GB_QUAL_IDENTIFIED_BY,
+    GB_QUAL_INFERENCE,
+    GB_QUAL_ISOLATE,
+    GB_QUAL_ISOLATION_SOURCE,
+    GB_QUAL_LAB_HOST,
+    GB_QUAL_LAT_LON,
+    GB_QUAL_LINKAGE_EVIDENCE,
+    GB_QUAL_LOCUS_TAG,
+    GB_QUAL_MACRONUCLEAR,
+    GB_QUAL_MAP,
+    GB_QUAL_MATING_TYPE,
+    GB_QUAL_METAGENOME_SOURCE,
+    GB_QUAL_MOBILE_ELEMENT_TYPE,
+    GB_QUAL_MOD_BASE,
+    GB_QUAL_MOL_TYPE,
+    GB_QUAL_NCRNA_CLASS,
+    GB_QUAL_NOTE,
+    GB_QUAL_NUMBER,
+    GB_QUAL_OLD_LOCUS_TAG,
+    GB_QUAL_OPERON,
+    GB_QUAL_ORGANELLE,
+    GB_QUAL_ORGANISM,
+    GB_QUAL_PARTIAL,
+    GB_QUAL_PCR_CONDITIONS,
+    GB_QUAL_PCR_PRIMERS,
+    GB_QUAL_PHENOTYPE,
+    GB_QUAL_PLASMID,
+    GB_QUAL_POP_VARIANT,
+    GB_QUAL_PRODUCT,
+    GB_QUAL_PROTEIN_ID,
+    GB_QUAL_PROVIRAL,
+    GB_QUAL_PSEUDO,
+    GB_QUAL_PSEUDOGENE,
+    GB_QUAL_REARRANGED,
+    GB_QUAL_RECOMBINATION_CLASS,
+    GB_QUAL_REGULATORY_CLASS,
+    GB_QUAL_REPLACE,
+    GB_QUAL_RIBOSOMAL_SLIPPAGE,
+    GB_QUAL_RPT_FAMILY,
+    GB_QUAL_RPT_TYPE,
+    GB_QUAL_RPT_UNIT_RANGE,
+    GB_QUAL_RPT_UNIT_SEQ,
+    GB_QUAL_SATELLITE,
+    GB_QUAL_SEGMENT,
+    GB_QUAL_SEROTYPE,
+    GB_QUAL_SEROVAR,
+    GB_QUAL_SEX,
+    GB_QUAL_SPECIMEN_VOUCHER,
+    GB_QUAL_STANDARD_NAME,
+    GB_QUAL_STRAIN,
+    GB_QUAL_SUB_CLONE,
+    GB_QUAL_SUB_SPECIES,
+    GB_QUAL_SUB_STRAIN,
+    GB_QUAL_SUBMITTER_SEQID,
+    GB_QUAL_TAG_PEPTIDE,
+    GB_QUAL_TISSUE_LIB,
+    GB_QUAL_TISSUE_TYPE,
+    GB_QUAL_TRANS_SPLICING,
+    GB_QUAL_TRANSGENIC,
+    GB_QUAL_TRANSLATION,
+    GB_QUAL_TRANSL_EXCEPT,
+    GB_QUAL_TRANSL_TABLE,
+    GB_QUAL_TYPE_MATERIAL,
+    GB_QUAL_VARIETY,
+    GB_QUALNUM
+};
+
 typedef struct tQualifier {
     gb_string sQualifier;
     gb_string sValue;
+    gb_span tQualifier;
+    gb_span tValue;
+    int iKey;           /* GB_QUAL_* of the name */
 } gb_qualifier;
 
 typedef struct tFeature {
@@ -58,10 +229,27 @@ typedef struct tFeature {
     unsigned int iNum;
     unsigned int iLocationNum;
     unsigned int iQualifierNum;
+    unsigned int aiKeys[(GB_QUALNUM + 31) / 32]; /* Bitmap of the keys of its qualifiers */
     char sFeature[FEATURELEN + 1];
     char cDirection;
 } gb_feature;
 
+/* One location of a feature in the feature index */
+typedef struct tInterval {
+    unsigned long lStart;
+    unsigned long lEnd;
+    unsigned long lMaxEnd;  /* Largest lEnd in the subtree under it */
+    unsigned int iFeature;
+} gb_interval;
+
+/* Locations of a record's features sorted by start, which doubles as an
+   implicit binary tree, see indexFeatures() */
+typedef struct tFeatureIndex {
+    gb_interval *ptIntervals;
+    unsigned long lIntervalNum;
+    int iLevel;             /* Of the root, -1 when there are no locations */
+} gb_index;
+
 typedef struct tGBFFData {
     gb_string sAccession;
     gb_string sComment;
@@ -73,19 +261,61 @@ typedef struct tGBFFData {
     gb_string sSequence;
     gb_string sSource;
     gb_string sVersion;
+    gb_span tAccession;
+    gb_span tVersion;
+    gb_span tLocusName;
+    gb_span tOrigin; /* Raw ORIGIN lines, only set with GB_ZEROCOPY */
+    gb_packed tPacked; /* With GB_PACKED it replaces sSequence, unless the
+                          sequence mixes case or holds other letters */
     gb_reference *ptReferences;
     gb_feature *ptFeatures;
+    gb_index *ptIndex; /* Built on the first findFeatures() */
     unsigned int iFeatureNum;
     unsigned int iReferenceNum;
     unsigned long lLength;
     unsigned long lRegion[2];
+    unsigned long long lOffset; /* Of the LOCUS line in the input, inflated if it was compressed */
+    unsigned long lTextLen;     /* From the LOCUS line to the end of the '//' line */
     char sLocusName[LOCUSLEN + 1];
     char sType[TYPELEN + 1];
     char sTopology[TOPOLOGYSTRLEN + 1];
     char sDivisionCode[DIVISIONCODELEN + 1];
     char sDate[DATESTRLEN + 1];
+    gb_arena *ptArena; /* Holds the record and everything it points to */
 } gb_data;
 
+/* Decides from the LOCUS, ACCESSION and VERSION lines whether to parse the
+   rest of a record, see filterGBFF() */
+typedef int (*gb_filter)(const gb_data *ptGBData, void *pArg);
+
+gb_reader *openGBFF(gb_string spFileName, unsigned int iFlags);
+gb_data *readGBFF(gb_reader *ptReader);
+void freeGBRecord(gb_data *ptGBData);
+void closeGBFF(gb_reader *ptReader);
+int errorGBFF(gb_reader *ptReader);
+void setThreadsGBFF(gb_reader *ptReader, unsigned int iThreads);
+void selectGBFF(gb_reader *ptReader, unsigned int iFields, const char **psFeatures);
+void filterGBFF(gb_reader *ptReader, gb_filter pFilter, void *pArg);
+gb_data *fetchGBFF(gb_reader *ptReader, unsigned long long lOffset, unsigned long lLen);
+
+gb_reader *openGBMemory(const char *sData, unsigned long lLen, unsigned int iFlags);
+int readGBBlock(gb_reader *ptReader, size_t lMinLen, gb_block *ptBlock);
+void freeGBBlock(gb_block *ptBlock);
+
 gb_data **parseGBFF(gb_string spFileName);
 void freeGBData(gb_data **pptGBFFData);
 gb_string getSequence(gb_string sSequence, gb_feature *ptFeature);
+
+int qualifierKey(const char *sName, unsigned long lLen);
+gb_qualifier *getQualifier(gb_feature *ptFeature, int iKey);
+
+gb_index *indexFeatures(gb_data *ptGBData);
+gb_feature **findFeatures(gb_data *ptGBData, unsigned long lFrom, unsigned long lTo);
+
+int packSequence(gb_packed *ptPacked, const char *sSequence, unsigned long lLen);
+void unpackSequence(gb_string sOut, const gb_packed *ptPacked, unsigned long lStart, unsigned long lLen);
+void freePacked(gb_packed *ptPacked);
+gb_string getPackedSequence(const gb_packed *ptPacked, gb_feature *ptFeature);
+void getPackedRevCom(gb_packed *ptPacked);
+
+#endif
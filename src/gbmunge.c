@@ -2,119 +2,56 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
-#include <time.h>
+#include <limits.h>
+#include <errno.h>
+#include <zlib.h>
 #include "gbfp.h"
+#include "arrow.h"
 #include "countrycodes.h"
+#include "countryalias.h"
 
 /* Platform-specific includes and definitions */
 #ifdef _WIN32
     #include <windows.h>
+    #include <io.h>
     #define strcasecmp _stricmp
+    #define fileno _fileno
 #else
     #include <sys/types.h>
+    #include <sys/uio.h>
     #include <unistd.h>
     #include <getopt.h>
+    #include <pthread.h>
 #endif
 
+/* Printed for a missing span */
+static const gb_span tNA = {"NA", 2};
+
+/* printf arguments for a "%.*s" conversion, printing NA for a missing span */
+#define SPANARG(t) (int)((t).sStr == NULL ? tNA.lLen : (t).lLen), ((t).sStr == NULL ? tNA.sStr : (t).sStr)
+
+/* Input handed to each worker thread with -j */
+#define BLOCKLEN (4 * MEGA)
+
 #define MIN3(a, b, c) ((a) < (b) ? ((a) < (c) ? (a) : (c)) : ((b) < (c) ? (b) : (c)))
 
-/* Portable strptime implementation for Windows */
 #ifdef _WIN32
-static const char *month_names[] = {
-    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
-    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+/* writev(2) for Windows, one buffer at a time */
+struct iovec {
+    void *iov_base;
+    size_t iov_len;
 };
 
-static int parse_month(const char *str) {
-    for (int i = 0; i < 12; i++) {
-        if (_strnicmp(str, month_names[i], 3) == 0) {
-            return i;
-        }
-    }
-    return -1;
-}
+static long writev(int iFd, const struct iovec *ptIov, int iIovNum) {
+    long lDone = 0;
+    int i, iWritten;
 
-/* Simple strptime implementation supporting formats used in this program */
-static char *strptime_portable(const char *s, const char *format, struct tm *tm) {
-    memset(tm, 0, sizeof(struct tm));
-    
-    if (strcmp(format, "%d-%b-%Y") == 0) {
-        /* Format: 01-Jan-2020 */
-        int day, year;
-        char mon[4] = {0};
-        if (sscanf(s, "%d-%3s-%d", &day, mon, &year) == 3) {
-            tm->tm_mday = day;
-            tm->tm_mon = parse_month(mon);
-            tm->tm_year = year - 1900;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%Y-%m-%d") == 0) {
-        /* Format: 2020-01-15 */
-        int year, mon, day;
-        if (sscanf(s, "%d-%d-%d", &year, &mon, &day) == 3) {
-            tm->tm_year = year - 1900;
-            tm->tm_mon = mon - 1;
-            tm->tm_mday = day;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%d-%m-%Y") == 0) {
-        /* Format: 15-01-2020 */
-        int day, mon, year;
-        if (sscanf(s, "%d-%d-%d", &day, &mon, &year) == 3) {
-            tm->tm_mday = day;
-            tm->tm_mon = mon - 1;
-            tm->tm_year = year - 1900;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%Y-%b") == 0) {
-        /* Format: 2020-Jan */
-        int year;
-        char mon[4] = {0};
-        if (sscanf(s, "%d-%3s", &year, mon) == 2) {
-            tm->tm_year = year - 1900;
-            tm->tm_mon = parse_month(mon);
-            tm->tm_mday = 1;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%b-%Y") == 0) {
-        /* Format: Jan-2020 */
-        int year;
-        char mon[4] = {0};
-        if (sscanf(s, "%3s-%d", mon, &year) == 2) {
-            tm->tm_mon = parse_month(mon);
-            tm->tm_year = year - 1900;
-            tm->tm_mday = 1;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%Y-%m") == 0) {
-        /* Format: 2020-01 */
-        int year, mon;
-        if (sscanf(s, "%d-%d", &year, &mon) == 2) {
-            tm->tm_year = year - 1900;
-            tm->tm_mon = mon - 1;
-            tm->tm_mday = 1;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%m-%Y") == 0) {
-        /* Format: 01-2020 */
-        int mon, year;
-        if (sscanf(s, "%d-%d", &mon, &year) == 2) {
-            tm->tm_mon = mon - 1;
-            tm->tm_year = year - 1900;
-            tm->tm_mday = 1;
-            return (char *)(s + strlen(s));
-        }
-    } else if (strcmp(format, "%Y") == 0) {
-        /* Format: 2020 */
-        int year;
-        if (sscanf(s, "%d", &year) == 1) {
-            tm->tm_year = year - 1900;
-            tm->tm_mon = 0;
-            tm->tm_mday = 1;
-            return (char *)(s + strlen(s));
-        }
+    for (i = 0; i < iIovNum; i++) {
+        if ((iWritten = _write(iFd, ptIov[i].iov_base, (unsigned int) ptIov[i].iov_len)) < 0) return lDone > 0 ? lDone : -1;
+        lDone += iWritten;
+        if ((size_t) iWritten < ptIov[i].iov_len) break;
     }
-    return NULL;
+    return lDone;
 }
 
 /* Simple getopt implementation for Windows */
@@ -150,23 +87,88 @@ static int getopt(int argc, char *const argv[], const char *optstring) {
     optind++;
     return opt;
 }
-
-#define strptime strptime_portable
 #endif /* _WIN32 */
 
 void help(void) {
         printf("Extract from a GenBank flat file.\n"
         "\n"
-        "Usage: gbmunge [-h] -i <Genbank_file> -f <sequence_output> -o <metadata_output> [-t] [-s]\n"
+        "Usage: gbmunge [-h] -i <Genbank_file> -f <sequence_output> -o <metadata_output> [-t] [-s] [-j <threads>]\n"
+        "               [-r <from>..<to> -g <feature_output>] [-x <index> [-F <accession_list>]]\n"
+        "               [-u <state_file>] [-a <gazetteer>] [-O <format>] [-z] [-w <width>]\n"
+        "\n"
+        "Use '-' as a filename to read from stdin or write to stdout.\n"
+        "Use -j to parse with several threads; output keeps the input order.\n"
+        "Use -r and -g to list the features overlapping a range of each record.\n"
+        "Use -x to write an index of where each record is in the input; with -F\n"
+        "only the records of the listed accessions are looked up in it and munged.\n"
+        "Use -u to only munge records which are new or changed since the last run\n"
+        "with the same state file, appending them to the outputs.\n"
+        "Use -a to add admin1 and admin2 columns, resolved from the part of the\n"
+        "country after the colon through a tab-separated gazetteer of country,\n"
+        "admin1, admin2 and aliases separated by '|'.\n"
+        "Use -O arrow to write the metadata as an Arrow IPC (Feather v2) file with\n"
+        "typed columns instead of tab-separated text (-O tsv, the default).\n"
+        "Use -z to compress the FASTA and tab-separated outputs as BGZF, on the\n"
+        "threads given with -j.\n"
+        "Use -w to wrap FASTA lines at <width> bases (0 keeps each sequence on one\n"
+        "line) and write a .fai index next to the FASTA file, and a .gzi with -z.\n"
         "\n");
 }
 
-static char *getQualValue(char *sQualifier, gb_feature *ptFeature) {
-    gb_qualifier *i;
-    for (i = ptFeature->ptQualifier; (i - ptFeature->ptQualifier) < ptFeature->iQualifierNum; i++)
-        if (strcmp(sQualifier, i->sQualifier) == 0)
-            return i->sValue;
-    return NULL;
+/* Columns of the table, with the fields of a record they are taken from
+   (besides the LOCUS line, which is always parsed) and their type in an
+   Arrow file */
+static const struct tColumn {
+    const char *sName;
+    unsigned int iFields;
+    int iType;
+} atColumns[] = {
+    {"name", GB_ACCESSION | GB_FEATURES, AR_UTF8},
+    {"accession", GB_ACCESSION, AR_UTF8},
+    {"length", 0, AR_UINT64},
+    {"submission_date", 0, AR_DATE32},
+    {"host", GB_FEATURES, AR_DICTIONARY},
+    {"country_original", GB_FEATURES, AR_UTF8},
+    {"country", GB_FEATURES, AR_DICTIONARY},
+    {"countrycode", GB_FEATURES, AR_DICTIONARY},
+    {"collection_original", GB_FEATURES, AR_UTF8},
+    {"collection_date", GB_FEATURES, AR_UTF8}, /* Of any precision */
+    {"country_confidence", GB_FEATURES, AR_FLOAT64},
+    {"collection_precision", GB_FEATURES, AR_DICTIONARY},
+    {"collection_lower", GB_FEATURES, AR_DATE32},
+    {"collection_upper", GB_FEATURES, AR_DATE32},
+    {"collection_decimal", GB_FEATURES, AR_FLOAT64},
+    {"admin1", GB_FEATURES, AR_DICTIONARY}, /* Only with -a */
+    {"admin2", GB_FEATURES, AR_DICTIONARY},
+    {"sequence", GB_ORIGIN, AR_UTF8}, /* Only with -s */
+    {NULL, 0, 0}
+};
+
+/* Only qualifiers of the source feature are used, unless -r lists features */
+static const char *asFeatures[] = {"source", NULL};
+
+/* Columns of the -g table; the sequence is only there with -s */
+static const char *asFeatureColumns[] = {"accession", "feature", "start", "end", "strand", "sequence", NULL};
+
+/* Qualifier values are spans into the input; sStr is NULL when absent */
+static gb_span getQualValue(int iKey, gb_feature *ptFeature) {
+    gb_qualifier *ptQualifier = getQualifier(ptFeature, iKey);
+    gb_span tNone = {NULL, 0};
+    return ptQualifier == NULL ? tNone : ptQualifier->tValue;
+}
+
+/* Same token strtok(3) would return for the first field, without writing to the input */
+static gb_span firstToken(gb_span tValue, char cDelim) {
+    const char *sEnd = tValue.sStr + tValue.lLen;
+    const char *sStart = tValue.sStr;
+    const char *sStop;
+    gb_span tToken;
+    while (sStart < sEnd && *sStart == cDelim) sStart++;
+    sStop = memchr(sStart, cDelim, sEnd - sStart);
+    tToken.sStr = sStart;
+    tToken.lLen = (sStop == NULL ? sEnd : sStop) - sStart;
+    if (tToken.lLen == 0) tToken.sStr = NULL;
+    return tToken;
 }
 
 int minIndex(int *a, int n){
@@ -214,14 +216,113 @@ int levenshteinDistance(char *s1, char *s2) {
     return (int)result;
 }
 
+/* Longest pattern of myersDistance(), a bit per character */
+#define MYERSLEN 64
+
+/* Bit-parallel edit distance (Myers 1999, as put by Hyyro 2001) between
+   the m byte pattern whose match masks are in alPeq and the n byte sText.
+   Each text byte updates a whole column of the DP matrix in a few word
+   operations. As a text byte can lower the distance by at most one, it
+   stops and returns iBound + 1 once the distance must end above iBound */
+static int myersDistance(const unsigned long long *alPeq, int m, const char *sText, int n, int iBound) {
+    unsigned long long lPv = (m == MYERSLEN) ? ~0ULL : (1ULL << m) - 1;
+    unsigned long long lMv = 0, lEq, lXv, lXh, lPh, lMh;
+    unsigned long long lLast = 1ULL << (m - 1);
+    int j, iScore = m;
+
+    for (j = 0; j < n; j++) {
+        lEq = alPeq[(unsigned char) sText[j]];
+        lXv = lEq | lMv;
+        lXh = (((lEq & lPv) + lPv) ^ lPv) | lEq;
+        lPh = lMv | ~(lXh | lPv);
+        lMh = lPv & lXh;
+        if (lPh & lLast) iScore++;
+        else if (lMh & lLast) iScore--;
+        if (iScore - (n - j - 1) > iBound) return iBound + 1;
+        /* The top row of the matrix counts up, hence the 1 shifted in */
+        lPh = (lPh << 1) | 1;
+        lMh <<= 1;
+        lPv = lMh | ~(lXv | lPh);
+        lMv = lPh & lXv;
+    }
+
+    return iScore;
+}
+
+#if ALIASLEN > MYERSLEN
+#error "The names in countryalias.h must fit myersDistance()"
+#endif
+
+/* Scratch space of nearestCountry(), which must start out all zero and is left so */
+typedef struct tMatcher {
+    unsigned long long alPeq[256];      /* Match masks of a name */
+    unsigned int aiShared[ALIASNUM];    /* Bigrams a name shares with the text, or more */
+    unsigned short aiLevels[ALIASLEN + 2];
+} mg_matcher;
+
+/* Index into atAliases[] of the name or alias closest to sName, which is in
+   lower case, by edit distance; the first of equally close ones. Each is
+   given a lower bound on its distance from the bigrams it shares with
+   sName, counted through the bigram index, and they are compared in the
+   order of their bounds until no bound is below the best distance so far.
+   Names which cannot come closer part way through are given up on */
+static int nearestCountry(mg_matcher *ptMatcher, const char *sName, int *piDistance) {
+    int iBest = INT_MAX, iFound = 0, iMin = INT_MAX, iDistance, iLong, m, n = strlen(sName), i, j, k;
+    int aiBound[FUZZYNUM];
+    unsigned short aiOrder[FUZZYNUM];
+    unsigned int h;
+
+    for (j = 0; j + 1 < n; j++) {
+        h = ((unsigned char) sName[j] * 31 + (unsigned char) sName[j + 1]) & ((1 << BIGRAMBITS) - 1);
+        for (i = aiBigramStart[h]; i < aiBigramStart[h + 1]; i++) ptMatcher->aiShared[aiBigramList[i]]++;
+    }
+    /* An edit changes at most two bigrams, and each bigram of a name which is
+       not in sName must have been changed (Ukkonen's q-gram lemma) */
+    for (i = 0; i < FUZZYNUM; i++) {
+        k = aiFuzzy[i];
+        m = atAliases[k].iLen;
+        iLong = m > n ? m : n;
+        aiBound[i] = (iLong - 1 - (int) ptMatcher->aiShared[k] + 1) / 2;
+        if (aiBound[i] < abs(m - n)) aiBound[i] = abs(m - n);
+        if (aiBound[i] < iMin) iMin = aiBound[i];
+        ptMatcher->aiShared[k] = 0;
+    }
+    /* Bounds lie within ALIASLEN of each other, so a counting sort orders them */
+    for (i = 0; i < FUZZYNUM; i++) ptMatcher->aiLevels[aiBound[i] - iMin + 1]++;
+    for (j = 1; j < ALIASLEN + 2; j++) ptMatcher->aiLevels[j] += ptMatcher->aiLevels[j - 1];
+    for (i = 0; i < FUZZYNUM; i++) aiOrder[ptMatcher->aiLevels[aiBound[i] - iMin]++] = i;
+    memset(ptMatcher->aiLevels, 0, sizeof(ptMatcher->aiLevels));
+
+    for (j = 0; j < FUZZYNUM && aiBound[aiOrder[j]] <= iBest; j++) {
+        k = aiFuzzy[aiOrder[j]];
+        if (aiBound[aiOrder[j]] == iBest && k > iFound) continue;
+        m = atAliases[k].iLen;
+        for (i = 0; i < m; i++) ptMatcher->alPeq[(unsigned char) atAliases[k].sKey[i]] |= 1ULL << i;
+        iDistance = myersDistance(ptMatcher->alPeq, m, sName, n, k < iFound ? iBest : iBest - 1);
+        for (i = 0; i < m; i++) ptMatcher->alPeq[(unsigned char) atAliases[k].sKey[i]] = 0;
+        if (iDistance < iBest || (iDistance == iBest && k < iFound)) {
+            iBest = iDistance;
+            iFound = k;
+        }
+    }
+
+    *piDistance = iBest;
+    return iFound;
+}
+
 int compareStrings(char *s1, char *s2)
 {
 for (; *s1 && *s2 && (toupper(*s1) == toupper(*s2)); ++s1, ++s2);
 return *s1 - *s2;
 }
 
+/* Dice's coefficient of two strings, ignoring case: twice the bigrams they
+   share, each bigram counted as often as it is in both, over all bigrams */
 double diceMatch(const char *string1, const char *string2) {
-    // https://en.wikibooks.org/wiki/Algorithm_Implementation/Strings/Dice%27s_coefficient#C
+    size_t strlen1, strlen2, i, j;
+    double matches = 0;
+    char *used;
+
     if (((string1 != NULL) && (string1[0] == '\0')) ||
         ((string2 != NULL) && (string2[0] == '\0'))) {
         return 0;
@@ -230,30 +331,28 @@ double diceMatch(const char *string1, const char *string2) {
         return 1;
     }
 
-    size_t strlen1 = strlen(string1);
-    size_t strlen2 = strlen(string2);
+    strlen1 = strlen(string1);
+    strlen2 = strlen(string2);
     if (strlen1 < 2 || strlen2 < 2) {
         return 0;
     }
 
-    size_t length1 = strlen1 - 1;
-    size_t length2 = strlen2 - 1;
-
-    double matches = 0;
-    size_t i = 0, j = 0;
-
-    while (i < length1 && j < length2) {
+    /* Each bigram of string2 can only be matched once */
+    used = calloc(strlen2 - 1, 1);
+    for (i = 0; i < strlen1 - 1; i++) {
         char a[3] = {string1[i], string1[i + 1], '\0'};
-        char b[3] = {string2[j], string2[j + 1], '\0'};
-        int cmp = compareStrings(a, b);
-        if (cmp == 0) {
-            matches += 2;
+        for (j = 0; j < strlen2 - 1; j++) {
+            char b[3] = {string2[j], string2[j + 1], '\0'};
+            if (!used[j] && compareStrings(a, b) == 0) {
+                used[j] = 1;
+                matches += 2;
+                break;
+            }
         }
-        i++;
-        j++;
     }
+    free(used);
 
-    return matches / (length1 + length2);
+    return matches / (strlen1 - 1 + strlen2 - 1);
 }
 
 char* uppercase ( char *sPtr )
@@ -276,31 +375,1561 @@ char* uppercase ( char *sPtr )
     return(sCopy);
 }
 
+static size_t hashName(const char *sName, size_t lLen) {
+    size_t lHash = 2166136261U;
+    while (lLen-- > 0) lHash = (lHash ^ (unsigned char) *sName++) * 16777619U;
+    return lHash;
+}
+
+/* Surrounding blanks taken off */
+static gb_span trimBlanks(gb_span tName) {
+    while (tName.lLen > 0 && isspace((unsigned char) *tName.sStr)) { tName.sStr++; tName.lLen--; }
+    while (tName.lLen > 0 && isspace((unsigned char) tName.sStr[tName.lLen-1])) tName.lLen--;
+    return tName;
+}
+
+/* Copies a name to sKey in lower case, leaving bytes outside ASCII alone */
+static void foldName(char *sKey, const char *sName, size_t lLen) {
+    size_t k;
+    for (k = 0; k < lLen; k++) sKey[k] = ((unsigned char) sName[k] < 128) ? tolower((unsigned char) sName[k]) : sName[k];
+    sKey[lLen] = '\0';
+}
+
+/* The country[] index of a name, ISO 3166 code or alias in countryalias.h,
+   ignoring case and surrounding blanks; -1 if it is none of them */
+static int aliasCountry(const char *sName, size_t lLen) {
+    char sKey[ALIASLEN + 1];
+    gb_span tName = {sName, lLen};
+    size_t k, lHash, lMix;
+
+    tName = trimBlanks(tName);
+    if (tName.lLen == 0 || tName.lLen > ALIASLEN) return -1;
+    foldName(sKey, tName.sStr, tName.lLen);
+
+    /* Same hash and displacement as countryalias.py */
+    lHash = hashName(sKey, tName.lLen) & 0xffffffffU;
+    lMix = ((lHash >> 9) ^ (aiAliasDisplace[lHash % ALIASBUCKETNUM] * 2654435761U)) & 0xffffffffU;
+    k = aiAliasSlot[((lMix * 2246822519U) & 0xffffffffU) >> (32 - ALIASSLOTBITS)];
+
+    return (k != 0 && strcmp(atAliases[k-1].sKey, sKey) == 0) ? atAliases[k-1].iCountry : -1;
+}
+
+/* Names mapped to numbers, in an open addressing table */
+typedef struct tNames {
+    char **psNames;         /* NULL for a free slot */
+    int *piValues;
+    size_t lNameNum;
+    size_t lSlotNum;        /* A power of 2 */
+} mg_names;
+
+static void initNames(mg_names *ptNames, size_t lSlotNum) {
+    ptNames->lSlotNum = lSlotNum;
+    ptNames->psNames = calloc(lSlotNum, sizeof(char *));
+    ptNames->piValues = malloc(lSlotNum * sizeof(int));
+    ptNames->lNameNum = 0;
+}
+
+/* The slot of a name, which is free when it is not in the table */
+static size_t findName(const mg_names *ptNames, const char *sName, size_t lLen) {
+    size_t lSlot = hashName(sName, lLen) & (ptNames->lSlotNum - 1);
+    for (;; lSlot = (lSlot + 1) & (ptNames->lSlotNum - 1)) {
+        if (ptNames->psNames[lSlot] == NULL) return lSlot;
+        if (strncmp(ptNames->psNames[lSlot], sName, lLen) == 0 && ptNames->psNames[lSlot][lLen] == '\0') return lSlot;
+    }
+}
+
+static void addName(mg_names *ptNames, const char *sName, size_t lLen, int iValue) {
+    char **psNames = ptNames->psNames;
+    int *piValues = ptNames->piValues;
+    size_t lSlotNum = ptNames->lSlotNum, k, lSlot;
+
+    /* Keep the table at most half full */
+    if (2 * (ptNames->lNameNum + 1) > lSlotNum) {
+        initNames(ptNames, lSlotNum * 2);
+        ptNames->lNameNum = 0;
+        for (k = 0; k < lSlotNum; k++) {
+            if (psNames[k] == NULL) continue;
+            lSlot = findName(ptNames, psNames[k], strlen(psNames[k]));
+            ptNames->psNames[lSlot] = psNames[k];
+            ptNames->piValues[lSlot] = piValues[k];
+            ptNames->lNameNum++;
+        }
+        free(psNames);
+        free(piValues);
+    }
+
+    lSlot = findName(ptNames, sName, lLen);
+    ptNames->psNames[lSlot] = malloc(lLen + 1);
+    memcpy(ptNames->psNames[lSlot], sName, lLen);
+    ptNames->psNames[lSlot][lLen] = '\0';
+    ptNames->piValues[lSlot] = iValue;
+    ptNames->lNameNum++;
+}
+
+static void freeNames(mg_names *ptNames) {
+    size_t k;
+    for (k = 0; k < ptNames->lSlotNum; k++) free(ptNames->psNames[k]);
+    free(ptNames->psNames);
+    free(ptNames->piValues);
+}
+
+/* A row of the gazetteer given with -a; sAdmin2 is NULL for a first level region */
+typedef struct tPlace {
+    int iCountry;           /* Index into country[] */
+    char *sAdmin1;
+    char *sAdmin2;
+} mg_place;
+
+/* Places by country and name, the key made by placeKey() */
+typedef struct tGazetteer {
+    mg_place *ptPlaces;
+    size_t lPlaceNum;
+    mg_names tIndex;
+} mg_gazetteer;
+
+/* Key of a name in a country: its ISO3 code, so that names of the same
+   country share places, a tab and the name in lower case without surrounding
+   blanks, in *psKey, which is grown as needed */
+static size_t placeKey(char **psKey, int iCountry, gb_span tName) {
+    size_t lLen;
+
+    tName = trimBlanks(tName);
+    *psKey = realloc(*psKey, tName.lLen + strlen(countrycode[iCountry]) + 2);
+    lLen = sprintf(*psKey, "%s\t", countrycode[iCountry]);
+    foldName(*psKey + lLen, tName.sStr, tName.lLen);
+    return lLen + tName.lLen;
+}
+
+/* Indexes a place under a name, unless the country already has a place of that name */
+static void addPlace(mg_gazetteer *ptGazetteer, char **psKey, int iCountry, gb_span tName, size_t lPlace) {
+    size_t lLen;
+
+    if (trimBlanks(tName).lLen == 0) return;
+    lLen = placeKey(psKey, iCountry, tName);
+    if (ptGazetteer->tIndex.psNames[findName(&ptGazetteer->tIndex, *psKey, lLen)] == NULL)
+        addName(&ptGazetteer->tIndex, *psKey, lLen, (int) lPlace);
+}
+
+static char *copyName(gb_span tSpan) {
+    char *sCopy;
+
+    tSpan = trimBlanks(tSpan);
+    sCopy = malloc(tSpan.lLen + 1);
+    memcpy(sCopy, tSpan.sStr, tSpan.lLen);
+    sCopy[tSpan.lLen] = '\0';
+    return sCopy;
+}
+
+/* Reads a whole line, however long, into *psLine, which grows as needed.
+   Returns its length, or -1 at the end of the file */
+static long readLine(FILE *fIn, char **psLine, size_t *plSize) {
+    size_t lLen = 0;
+
+    if (*psLine == NULL) {
+        *plSize = LINELEN;
+        *psLine = malloc(*plSize);
+    }
+    while (fgets(*psLine + lLen, *plSize - lLen, fIn) != NULL) {
+        lLen += strlen(*psLine + lLen);
+        /* Only a full buffer leaves more of the line to come */
+        if ((*psLine)[lLen - 1] == '\n' || lLen + 1 < *plSize) break;
+        *plSize *= 2;
+        *psLine = realloc(*psLine, *plSize);
+    }
+
+    return lLen == 0 ? -1 : (long) lLen;
+}
+
+/* Reads a gazetteer, a tab-separated file of country, admin1, admin2 and
+   aliases separated by '|'. The country can be anything countryalias.h
+   knows; a row without admin2 is a first level region. Where names repeat
+   within a country the first row wins. Returns 0 once read, 1 if it
+   cannot be opened */
+static int readGazetteer(mg_gazetteer *ptGazetteer, const char *sGazetteer) {
+    FILE *fGazetteer;
+    char *sLine = NULL;
+    char *sKey = NULL;
+    gb_span atFields[4], tAlias, tRest;
+    const char *sStop;
+    size_t lPlaceMem = 0, lLen, lSkipped = 0, lPlace, lLineSize = 0;
+    mg_place *ptPlace;
+    int iCountry, iField;
+
+    ptGazetteer->ptPlaces = NULL;
+    ptGazetteer->lPlaceNum = 0;
+    initNames(&ptGazetteer->tIndex, 1024);
+    if((fGazetteer = fopen(sGazetteer,"r")) == NULL) return 1;
+    while(readLine(fGazetteer,&sLine,&lLineSize) >= 0){
+        lLen = strcspn(sLine,"\r\n");
+        if(lLen == 0 || sLine[0] == '#' || strncmp(sLine,"country\t",8) == 0) continue;
+        tRest.sStr = sLine;
+        tRest.lLen = lLen;
+        for (iField = 0; iField < 4; iField++) {
+            sStop = memchr(tRest.sStr, '\t', tRest.lLen);
+            atFields[iField].sStr = tRest.sStr;
+            atFields[iField].lLen = (sStop == NULL ? tRest.sStr + tRest.lLen : sStop) - tRest.sStr;
+            tRest.lLen -= atFields[iField].lLen;
+            tRest.sStr += atFields[iField].lLen;
+            if (tRest.lLen > 0) { tRest.sStr++; tRest.lLen--; }
+        }
+        if((iCountry = aliasCountry(atFields[0].sStr, atFields[0].lLen)) < 0 || trimBlanks(atFields[1]).lLen == 0){
+            lSkipped++;
+            continue;
+        }
+
+        if (ptGazetteer->lPlaceNum + 2 > lPlaceMem) {
+            lPlaceMem = lPlaceMem == 0 ? 1024 : 2 * lPlaceMem;
+            ptGazetteer->ptPlaces = realloc(ptGazetteer->ptPlaces, lPlaceMem * sizeof(mg_place));
+        }
+        /* A second level region makes its first level one known too */
+        lLen = placeKey(&sKey, iCountry, atFields[1]);
+        if (trimBlanks(atFields[2]).lLen > 0 && ptGazetteer->tIndex.psNames[findName(&ptGazetteer->tIndex, sKey, lLen)] == NULL) {
+            ptPlace = ptGazetteer->ptPlaces + ptGazetteer->lPlaceNum;
+            ptPlace->iCountry = iCountry;
+            ptPlace->sAdmin1 = copyName(atFields[1]);
+            ptPlace->sAdmin2 = NULL;
+            addName(&ptGazetteer->tIndex, sKey, lLen, (int) ptGazetteer->lPlaceNum++);
+        }
+        lPlace = ptGazetteer->lPlaceNum;
+        ptPlace = ptGazetteer->ptPlaces + ptGazetteer->lPlaceNum++;
+        ptPlace->iCountry = iCountry;
+        ptPlace->sAdmin1 = copyName(atFields[1]);
+        ptPlace->sAdmin2 = trimBlanks(atFields[2]).lLen > 0 ? copyName(atFields[2]) : NULL;
+        addPlace(ptGazetteer, &sKey, iCountry, ptPlace->sAdmin2 != NULL ? atFields[2] : atFields[1], lPlace);
+        for (tRest = atFields[3]; tRest.lLen > 0; ) {
+            tAlias = tRest;
+            if ((sStop = memchr(tRest.sStr, '|', tRest.lLen)) != NULL) tAlias.lLen = sStop - tRest.sStr;
+            addPlace(ptGazetteer, &sKey, iCountry, tAlias, lPlace);
+            tRest.lLen -= tAlias.lLen + (sStop != NULL);
+            tRest.sStr += tAlias.lLen + (sStop != NULL);
+        }
+    }
+    fclose(fGazetteer);
+    free(sLine);
+    free(sKey);
+    if (lSkipped > 0) fprintf(stderr,"Warning: %lu rows of gazetteer %s without a known country or admin1 were left out.\n",(unsigned long) lSkipped,sGazetteer);
+    return 0;
+}
+
+static void freeGazetteer(mg_gazetteer *ptGazetteer) {
+    size_t k;
+    for (k = 0; k < ptGazetteer->lPlaceNum; k++) {
+        free(ptGazetteer->ptPlaces[k].sAdmin1);
+        free(ptGazetteer->ptPlaces[k].sAdmin2);
+    }
+    free(ptGazetteer->ptPlaces);
+    freeNames(&ptGazetteer->tIndex);
+}
+
+/* A country text resolved to country[iCountry]. The confidence is 1 for
+   texts in countryalias.h, and else the mean of the Dice coefficient and the
+   edit similarity of the text and the closest name */
+typedef struct tResolved {
+    int iCountry;
+    double dConfidence;
+} mg_resolved;
+
+/* Countries resolved so far, by the text before the colon of a /country,
+   and with -a places, by the whole text. Texts in countryalias.h never
+   reach the fuzzy matching; each thread has a table of its own */
+typedef struct tCountries {
+    mg_names tCountries;    /* Index into ptResolved */
+    mg_resolved *ptResolved;
+    size_t lResolvedNum;
+    size_t lResolvedMem;
+    mg_names tPlaces;       /* Index into the gazetteer's places, -1 for none */
+    const mg_gazetteer *ptGazetteer; /* NULL without -a */
+    char *sCountry2;        /* The text being resolved */
+    mg_matcher tMatcher;
+} mg_countries;
+
+static void initCountries(mg_countries *ptCountries, const mg_gazetteer *ptGazetteer) {
+    initNames(&ptCountries->tCountries, 1024);
+    initNames(&ptCountries->tPlaces, 1024);
+    ptCountries->ptGazetteer = ptGazetteer;
+    ptCountries->ptResolved = NULL;
+    ptCountries->lResolvedNum = ptCountries->lResolvedMem = 0;
+    ptCountries->sCountry2 = NULL;
+    memset(&ptCountries->tMatcher, 0, sizeof(ptCountries->tMatcher));
+}
+
+static void freeCountries(mg_countries *ptCountries) {
+    freeNames(&ptCountries->tCountries);
+    freeNames(&ptCountries->tPlaces);
+    free(ptCountries->ptResolved);
+    free(ptCountries->sCountry2);
+}
+
+/* The index into country[] of a name: its entry in countryalias.h, or else
+   the closest name, which is only looked for the first time the name is
+   seen. The confidence in it goes to *pdConfidence */
+static int resolveCountry(mg_countries *ptCountries, gb_span tName, double *pdConfidence) {
+    mg_resolved *ptResolved;
+    gb_span tTrimmed;
+    size_t lSlot;
+    int iKey, iDistance, iLong;
+
+    if (tName.sStr == NULL) tName.sStr = "";
+    lSlot = findName(&ptCountries->tCountries, tName.sStr, tName.lLen);
+    if (ptCountries->tCountries.psNames[lSlot] != NULL) {
+        ptResolved = ptCountries->ptResolved + ptCountries->tCountries.piValues[lSlot];
+        *pdConfidence = ptResolved->dConfidence;
+        return ptResolved->iCountry;
+    }
+
+    if (ptCountries->lResolvedNum == ptCountries->lResolvedMem) {
+        ptCountries->lResolvedMem = ptCountries->lResolvedMem == 0 ? 256 : 2 * ptCountries->lResolvedMem;
+        ptCountries->ptResolved = realloc(ptCountries->ptResolved, ptCountries->lResolvedMem * sizeof(mg_resolved));
+    }
+    ptResolved = ptCountries->ptResolved + ptCountries->lResolvedNum;
+    if ((ptResolved->iCountry = aliasCountry(tName.sStr, tName.lLen)) >= 0) ptResolved->dConfidence = 1;
+    else {
+        tTrimmed = trimBlanks(tName);
+        ptCountries->sCountry2 = realloc(ptCountries->sCountry2, 1+tTrimmed.lLen);
+        foldName(ptCountries->sCountry2, tTrimmed.sStr, tTrimmed.lLen);
+        iKey = nearestCountry(&ptCountries->tMatcher, ptCountries->sCountry2, &iDistance);
+        iLong = atAliases[iKey].iLen > (int) tTrimmed.lLen ? atAliases[iKey].iLen : (int) tTrimmed.lLen;
+        ptResolved->iCountry = atAliases[iKey].iCountry;
+        ptResolved->dConfidence = (diceMatch(ptCountries->sCountry2, atAliases[iKey].sKey) + 1.0 - (double) iDistance / iLong) / 2;
+    }
+    addName(&ptCountries->tCountries, tName.sStr, tName.lLen, (int) ptCountries->lResolvedNum++);
+
+    *pdConfidence = ptResolved->dConfidence;
+    return ptResolved->iCountry;
+}
+
+/* The gazetteer place of a /country resolved to iCountry, from the parts
+   after its first colon, split at commas and colons: a second level region
+   if one is named, else the first first level one; NULL if there is none.
+   Places are only looked for the first time a text is seen */
+static const mg_place *resolvePlace(mg_countries *ptCountries, gb_span tCountry, int iCountry) {
+    const mg_gazetteer *ptGazetteer = ptCountries->ptGazetteer;
+    const char *sPart, *sEnd = tCountry.sStr + tCountry.lLen;
+    gb_span tPart;
+    size_t lSlot, lLen;
+    int iPlace = -1, iFound;
+
+    lSlot = findName(&ptCountries->tPlaces, tCountry.sStr, tCountry.lLen);
+    if (ptCountries->tPlaces.psNames[lSlot] == NULL) {
+        sPart = memchr(tCountry.sStr, ':', tCountry.lLen);
+        while (sPart != NULL && sPart < sEnd) {
+            tPart.sStr = ++sPart;
+            while (sPart < sEnd && *sPart != ',' && *sPart != ':') sPart++;
+            tPart.lLen = sPart - tPart.sStr;
+            lLen = placeKey(&ptCountries->sCountry2, iCountry, tPart);
+            lSlot = findName(&ptGazetteer->tIndex, ptCountries->sCountry2, lLen);
+            if (ptGazetteer->tIndex.psNames[lSlot] == NULL) continue;
+            iFound = ptGazetteer->tIndex.piValues[lSlot];
+            if (iPlace < 0 || (ptGazetteer->ptPlaces[iPlace].sAdmin2 == NULL && ptGazetteer->ptPlaces[iFound].sAdmin2 != NULL)) iPlace = iFound;
+            if (ptGazetteer->ptPlaces[iPlace].sAdmin2 != NULL) break;
+        }
+        addName(&ptCountries->tPlaces, tCountry.sStr, tCountry.lLen, iPlace);
+    }
+    else iPlace = ptCountries->tPlaces.piValues[lSlot];
+
+    return iPlace < 0 ? NULL : ptGazetteer->ptPlaces + iPlace;
+}
+
+/* Bytes of the FASTA and table outputs gathered before a write */
+#define WRITELEN (1 * MEGA)
+/* Sequences at least this long are written from where they are */
+#define WRITEREFLEN 4096
+#define WRITEIOVNUM 64
+/* Text deflated into each BGZF block with -z, as much as bgzip puts in one */
+#define BGZFTEXTLEN 0xff00
+
+/* A batch of BGZF blocks is written with one writev(2) */
+#if BGZFBATCHNUM > WRITEIOVNUM
+#error "WRITEIOVNUM must hold a batch of BGZF blocks"
+#endif
+
+/* Output of the FASTA file and table. Rows are put together in a large
+   buffer which is written out when full, and long sequences are handed to
+   writev(2) where they lie instead of being copied. Without a file
+   descriptor the buffer grows to hold everything, as for the blocks of -j,
+   unless the rows are turned into an Arrow file as it fills */
+typedef struct tWriter {
+    int iFd;                /* -1 to keep the output in sBuf */
+    ar_file *ptArrow;       /* Where rows go instead, with -O arrow */
+    char *sBuf;
+    size_t lLen;
+    size_t lSize;
+    size_t lMark;           /* Bytes of sBuf before this are in atIov */
+    struct iovec atIov[WRITEIOVNUM];
+    int iIovNum;
+    int iError;
+    int iThreads;           /* Threads deflating BGZF blocks, 0 for plain output */
+    unsigned char *sBGZF;   /* The blocks of a batch, BGZFBLOCKLEN apart */
+    unsigned long long *alBlocks; /* Where each BGZF block starts, deflated and not */
+    size_t lBlockNum;
+    size_t lBlockMem;
+    unsigned long long lDeflated;
+    unsigned long long lInflated;
+    unsigned long long lOffset; /* Bytes put so far, before deflating */
+    unsigned int iWidth;    /* Bases a line of FASTA, 0 for the whole sequence */
+    FILE *fFai;             /* Index of the FASTA sequences, NULL for none */
+} mg_writer;
+
+/* A block of BGZF output and the text it holds */
+typedef struct tBGZFOut {
+    const char *sText;
+    unsigned int iTextLen;
+    unsigned char *sOut;
+    unsigned int iOutLen;
+} mg_bgzfout;
+
+/* BGZF blocks shared out among deflating threads */
+typedef struct tBGZFOutBatch {
+    mg_bgzfout *ptBlocks;
+    unsigned int iBlockNum;
+    unsigned int iStep;
+    unsigned int iFirst;
+} mg_bgzfoutbatch;
+
+/* The empty block which ends BGZF files */
+static const unsigned char sBGZFEnd[28] = {
+    0x1f, 0x8b, 0x08, 0x04, 0, 0, 0, 0, 0, 0xff, 0x06, 0, 0x42, 0x43, 0x02, 0, 0x1b, 0, 0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static void openWriter(mg_writer *ptWriter, int iFd) {
+    ptWriter->iFd = iFd;
+    ptWriter->ptArrow = NULL;
+    ptWriter->lSize = WRITELEN;
+    ptWriter->sBuf = malloc(ptWriter->lSize);
+    ptWriter->lLen = ptWriter->lMark = 0;
+    ptWriter->iIovNum = 0;
+    ptWriter->iError = 0;
+    ptWriter->iThreads = 0;
+    ptWriter->sBGZF = NULL;
+    ptWriter->alBlocks = NULL;
+    ptWriter->lBlockNum = ptWriter->lBlockMem = 0;
+    ptWriter->lDeflated = ptWriter->lInflated = 0;
+    ptWriter->lOffset = 0;
+    ptWriter->iWidth = 0;
+    ptWriter->fFai = NULL;
+}
+
+/* Makes the writer deflate its output into BGZF blocks, a batch of them at
+   a time on iThreads threads, which gzip, samtools and tabix can read */
+static void compressWriter(mg_writer *ptWriter, int iThreads) {
+    ptWriter->iThreads = (iThreads > BGZFBATCHNUM) ? BGZFBATCHNUM : iThreads;
+    ptWriter->lSize = BGZFBATCHNUM * BGZFTEXTLEN;
+    ptWriter->sBuf = realloc(ptWriter->sBuf, ptWriter->lSize);
+    ptWriter->sBGZF = malloc(BGZFBATCHNUM * BGZFBLOCKLEN);
+}
+
+static void storeLE(unsigned char *s, unsigned long long lValue, int iLen) {
+    for (; iLen > 0; iLen--, lValue >>= 8) *s++ = lValue & 0xff;
+}
+
+/* Deflates every iStep-th block of a batch, starting from iFirst. The text
+   of a block always fits, as deflate stored blocks only add a few bytes */
+static void *deflateBGZF(void *pBatch) {
+    mg_bgzfoutbatch *ptBatch = pBatch;
+    mg_bgzfout *ptBlock;
+    z_stream tStream;
+    unsigned int i;
+
+    memset(&tStream, 0, sizeof(z_stream));
+    if (deflateInit2(&tStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        for (i = ptBatch->iFirst; i < ptBatch->iBlockNum; i += ptBatch->iStep) (ptBatch->ptBlocks + i)->iOutLen = 0;
+        return NULL;
+    }
+
+    for (i = ptBatch->iFirst; i < ptBatch->iBlockNum; i += ptBatch->iStep) {
+        ptBlock = ptBatch->ptBlocks + i;
+        deflateReset(&tStream);
+        tStream.next_in = (unsigned char *) ptBlock->sText;
+        tStream.avail_in = ptBlock->iTextLen;
+        tStream.next_out = ptBlock->sOut + BGZFHEADLEN;
+        tStream.avail_out = BGZFBLOCKLEN - BGZFHEADLEN - 8;
+        if (deflate(&tStream, Z_FINISH) != Z_STREAM_END) {
+            ptBlock->iOutLen = 0;
+            continue;
+        }
+        ptBlock->iOutLen = BGZFHEADLEN + tStream.total_out + 8;
+        /* The header of the end block, with this block's size */
+        memcpy(ptBlock->sOut, sBGZFEnd, BGZFHEADLEN);
+        storeLE(ptBlock->sOut + 16, ptBlock->iOutLen - 1, 2);
+        storeLE(ptBlock->sOut + ptBlock->iOutLen - 8, crc32(0L, (unsigned char *) ptBlock->sText, ptBlock->iTextLen), 4);
+        storeLE(ptBlock->sOut + ptBlock->iOutLen - 4, ptBlock->iTextLen, 4);
+    }
+
+    deflateEnd(&tStream);
+
+    return NULL;
+}
+
+/* Deflates what the writer holds into a batch of blocks, in parallel when
+   there are threads to spare, and points atIov at them in order */
+static void deflateBatch(mg_writer *ptWriter) {
+    mg_bgzfout atBlocks[BGZFBATCHNUM];
+    mg_bgzfoutbatch atBatches[BGZFBATCHNUM];
+    unsigned int iBlockNum = 0, iThreads, i;
+    size_t lPos;
+#ifndef _WIN32
+    pthread_t atThreads[BGZFBATCHNUM];
+#endif
+
+    for (lPos = 0; lPos < ptWriter->lLen; lPos += BGZFTEXTLEN, iBlockNum++) {
+        (atBlocks + iBlockNum)->sText = ptWriter->sBuf + lPos;
+        (atBlocks + iBlockNum)->iTextLen = (ptWriter->lLen - lPos < BGZFTEXTLEN) ? ptWriter->lLen - lPos : BGZFTEXTLEN;
+        (atBlocks + iBlockNum)->sOut = ptWriter->sBGZF + (size_t) iBlockNum * BGZFBLOCKLEN;
+    }
+
+    iThreads = ((unsigned int) ptWriter->iThreads < iBlockNum) ? (unsigned int) ptWriter->iThreads : iBlockNum;
+    if (iThreads < 1) iThreads = 1;
+    for (i = 0; i < iThreads; i++) {
+        (atBatches + i)->ptBlocks = atBlocks;
+        (atBatches + i)->iBlockNum = iBlockNum;
+        (atBatches + i)->iStep = iThreads;
+        (atBatches + i)->iFirst = i;
+    }
+#ifndef _WIN32
+    for (i = 1; i < iThreads; i++) {
+        if (pthread_create(atThreads + i, NULL, deflateBGZF, atBatches + i) != 0) break;
+    }
+    deflateBGZF(atBatches);
+    iThreads = i;
+    for (i = 1; i < iThreads; i++) pthread_join(atThreads[i], NULL);
+    /* Blocks of threads which could not be started */
+    for (i = iThreads; i < ((unsigned int) ptWriter->iThreads < iBlockNum ? (unsigned int) ptWriter->iThreads : iBlockNum); i++) deflateBGZF(atBatches + i);
+#else
+    for (i = 0; i < iThreads; i++) deflateBGZF(atBatches + i);
+#endif
+
+    for (i = 0; i < iBlockNum; i++) {
+        if ((atBlocks + i)->iOutLen == 0) ptWriter->iError = 1;
+        ptWriter->atIov[i].iov_base = (atBlocks + i)->sOut;
+        ptWriter->atIov[i].iov_len = (atBlocks + i)->iOutLen;
+        /* Kept for the .gzi index of the FASTA file */
+        if (ptWriter->lBlockNum == ptWriter->lBlockMem) {
+            ptWriter->lBlockMem = ptWriter->lBlockMem ? 2 * ptWriter->lBlockMem : 1024;
+            ptWriter->alBlocks = realloc(ptWriter->alBlocks, 2 * ptWriter->lBlockMem * sizeof(unsigned long long));
+        }
+        ptWriter->alBlocks[2 * ptWriter->lBlockNum] = ptWriter->lDeflated;
+        ptWriter->alBlocks[2 * ptWriter->lBlockNum++ + 1] = ptWriter->lInflated;
+        ptWriter->lDeflated += (atBlocks + i)->iOutLen;
+        ptWriter->lInflated += (atBlocks + i)->iTextLen;
+    }
+    ptWriter->iIovNum = iBlockNum;
+    ptWriter->lLen = 0;
+}
+
+/* Days since 1970-01-01 of a YYYY-MM-DD date, or LONG_MIN */
+static long dayNumber(const char *sDate, size_t lLen) {
+    static const char sShape[] = "nnnn-nn-nn";
+    int iYear, iMonth, iDay, iEra, iYearOfEra;
+    size_t k;
+
+    if (lLen != sizeof(sShape) - 1) return LONG_MIN;
+    for (k = 0; k < lLen; k++) {
+        if (sShape[k] == 'n' ? ! isdigit((unsigned char) sDate[k]) : sDate[k] != sShape[k]) return LONG_MIN;
+    }
+    iYear = atoi(sDate);
+    iMonth = atoi(sDate + 5);
+    iDay = atoi(sDate + 8);
+    if (iMonth < 1 || iMonth > 12 || iDay < 1 || iDay > 31) return LONG_MIN;
+    /* Years are counted from March, so that leap days come at their end */
+    iYear -= iMonth <= 2;
+    iEra = iYear / 400;
+    iYearOfEra = iYear - iEra * 400;
+    return iEra * 146097L + iYearOfEra * 365L + iYearOfEra / 4 - iYearOfEra / 100 +
+           (153 * (iMonth + (iMonth > 2 ? -3 : 9)) + 2) / 5 + iDay - 1 - 719468L;
+}
+
+/* Adds the whole rows at the start of sRows to an Arrow file, reading their
+   fields back into the types of the columns, with NA as null; returns the
+   bytes they took. Rows are put together as text whichever thread munged
+   them, so they only become columns here, in order */
+static size_t putArrowRows(ar_file *ptArrow, const char *sRows, size_t lLen) {
+    const char *sRow = sRows, *sLine, *sField, *sTab;
+    size_t lField;
+    long lDays;
+    int i;
+
+    while ((sLine = memchr(sRow, '\n', sRows + lLen - sRow)) != NULL) {
+        for (i = 0, sField = sRow; i < ptArrow->iColumnNum; i++, sField = sTab + 1) {
+            /* Short rows end in nulls */
+            if (sField > sLine) {
+                putArrowNull(ptArrow, i);
+                sTab = sLine;
+                continue;
+            }
+            if ((sTab = memchr(sField, '\t', sLine - sField)) == NULL) sTab = sLine;
+            lField = sTab - sField;
+            if (lField == 2 && memcmp(sField, "NA", 2) == 0) {
+                putArrowNull(ptArrow, i);
+                continue;
+            }
+            switch (ptArrow->ptColumns[i].iType) {
+            case AR_UINT64:
+                putArrowUInt(ptArrow, i, strtoull(sField, NULL, 10));
+                break;
+            case AR_FLOAT64:
+                putArrowDouble(ptArrow, i, strtod(sField, NULL));
+                break;
+            case AR_DATE32:
+                if ((lDays = dayNumber(sField, lField)) == LONG_MIN) putArrowNull(ptArrow, i);
+                else putArrowDate(ptArrow, i, lDays);
+                break;
+            default:
+                putArrowString(ptArrow, i, sField, lField);
+            }
+        }
+        endArrowRow(ptArrow);
+        sRow = sLine + 1;
+    }
+
+    return sRow - sRows;
+}
+
+/* Writes out what the writer holds and points to */
+static void flushWriter(mg_writer *ptWriter) {
+    struct iovec *ptIov = ptWriter->atIov;
+    int iIovNum;
+    long lDone;
+
+    /* A row cut off by a full buffer waits for the rest of it */
+    if (ptWriter->ptArrow != NULL) {
+        lDone = putArrowRows(ptWriter->ptArrow, ptWriter->sBuf, ptWriter->lLen);
+        memmove(ptWriter->sBuf, ptWriter->sBuf + lDone, ptWriter->lLen - lDone);
+        ptWriter->lLen -= lDone;
+        return;
+    }
+    if (ptWriter->iFd < 0) return;
+    if (ptWriter->iThreads > 0) deflateBatch(ptWriter);
+    else if (ptWriter->lLen > ptWriter->lMark) {
+        ptWriter->atIov[ptWriter->iIovNum].iov_base = ptWriter->sBuf + ptWriter->lMark;
+        ptWriter->atIov[ptWriter->iIovNum++].iov_len = ptWriter->lLen - ptWriter->lMark;
+    }
+    for (iIovNum = ptWriter->iIovNum; iIovNum > 0 && ! ptWriter->iError; ) {
+        if ((lDone = writev(ptWriter->iFd, ptIov, iIovNum)) < 0) {
+            if (errno != EINTR) ptWriter->iError = 1;
+            continue;
+        }
+        /* Carry on after a short write */
+        for (; iIovNum > 0 && (size_t) lDone >= ptIov->iov_len; ptIov++, iIovNum--) lDone -= ptIov->iov_len;
+        if (iIovNum > 0) {
+            ptIov->iov_base = (char *) ptIov->iov_base + lDone;
+            ptIov->iov_len -= lDone;
+        }
+    }
+    ptWriter->lLen = ptWriter->lMark = 0;
+    ptWriter->iIovNum = 0;
+}
+
+/* Writes out what the writer points to, before it goes away */
+static void settleWriter(mg_writer *ptWriter) {
+    if (ptWriter->iIovNum > 0) flushWriter(ptWriter);
+}
+
+/* Flushes the writer; returns whether anything could not be written */
+static int closeWriter(mg_writer *ptWriter) {
+    flushWriter(ptWriter);
+    if (ptWriter->iThreads > 0) {
+        ptWriter->iThreads = 0;
+        ptWriter->atIov[0].iov_base = (void *) sBGZFEnd;
+        ptWriter->atIov[0].iov_len = sizeof(sBGZFEnd);
+        ptWriter->iIovNum = 1;
+        flushWriter(ptWriter);
+    }
+    free(ptWriter->sBuf);
+    free(ptWriter->sBGZF);
+    free(ptWriter->alBlocks);
+    if (ptWriter->ptArrow != NULL && closeArrow(ptWriter->ptArrow) != 0) ptWriter->iError = 1;
+    return ptWriter->iError;
+}
+
+static void putBytes(mg_writer *ptWriter, const char *sBytes, size_t lLen) {
+    size_t lPart;
+
+    /* A record without a sequence has nothing to copy, not even from NULL */
+    if (lLen == 0) return;
+    ptWriter->lOffset += lLen;
+    /* Text to deflate goes through the buffer, a batch of blocks at a time */
+    while (ptWriter->iThreads > 0 && ptWriter->lLen + lLen > ptWriter->lSize) {
+        lPart = ptWriter->lSize - ptWriter->lLen;
+        memcpy(ptWriter->sBuf + ptWriter->lLen, sBytes, lPart);
+        ptWriter->lLen += lPart;
+        sBytes += lPart;
+        lLen -= lPart;
+        flushWriter(ptWriter);
+    }
+    if (ptWriter->iFd >= 0 && ptWriter->iThreads == 0 && lLen >= WRITEREFLEN) {
+        if (ptWriter->iIovNum + 2 >= WRITEIOVNUM) flushWriter(ptWriter);
+        if (ptWriter->lLen > ptWriter->lMark) {
+            ptWriter->atIov[ptWriter->iIovNum].iov_base = ptWriter->sBuf + ptWriter->lMark;
+            ptWriter->atIov[ptWriter->iIovNum++].iov_len = ptWriter->lLen - ptWriter->lMark;
+            ptWriter->lMark = ptWriter->lLen;
+        }
+        ptWriter->atIov[ptWriter->iIovNum].iov_base = (char *) sBytes;
+        ptWriter->atIov[ptWriter->iIovNum++].iov_len = lLen;
+        return;
+    }
+    if (ptWriter->lLen + lLen > ptWriter->lSize) {
+        flushWriter(ptWriter);
+        while (ptWriter->lLen + lLen > ptWriter->lSize) {
+            ptWriter->lSize *= 2;
+            ptWriter->sBuf = realloc(ptWriter->sBuf, ptWriter->lSize);
+        }
+    }
+    memcpy(ptWriter->sBuf + ptWriter->lLen, sBytes, lLen);
+    ptWriter->lLen += lLen;
+}
+
+static void putChar(mg_writer *ptWriter, char c) {
+    if (ptWriter->lLen == ptWriter->lSize) putBytes(ptWriter, &c, 1);
+    else {
+        ptWriter->sBuf[ptWriter->lLen++] = c;
+        ptWriter->lOffset++;
+    }
+}
+
+static void putString(mg_writer *ptWriter, const char *sStr) {
+    putBytes(ptWriter, sStr, strlen(sStr));
+}
+
+/* A span, or NA when it is missing */
+static void putSpan(mg_writer *ptWriter, gb_span tSpan) {
+    if (tSpan.sStr == NULL) putBytes(ptWriter, "NA", 2);
+    else putBytes(ptWriter, tSpan.sStr, tSpan.lLen);
+}
+
+static void putULong(mg_writer *ptWriter, unsigned long lValue) {
+    char sDigits[24];
+    int i = sizeof(sDigits);
+
+    do sDigits[--i] = '0' + lValue % 10; while ((lValue /= 10) > 0);
+    putBytes(ptWriter, sDigits + i, sizeof(sDigits) - i);
+}
+
+/* A field after the first of a row */
+static void putField(mg_writer *ptWriter, const char *sStr) {
+    putChar(ptWriter, '\t');
+    putString(ptWriter, sStr);
+}
+
+/* A FASTA sequence, in lines of the writer's width when it has one */
+static void putSequence(mg_writer *ptWriter, const char *sSequence, size_t lLen) {
+    size_t lPos;
+
+    if (ptWriter->iWidth == 0 || lLen == 0) {
+        putBytes(ptWriter, sSequence, lLen);
+        putChar(ptWriter, '\n');
+        return;
+    }
+    for (lPos = 0; lPos < lLen; lPos += ptWriter->iWidth) {
+        putBytes(ptWriter, sSequence + lPos, (lLen - lPos < ptWriter->iWidth) ? lLen - lPos : ptWriter->iWidth);
+        putChar(ptWriter, '\n');
+    }
+}
+
+/* Copies the FASTA index lines of a block munged by a worker, whose offsets
+   count from the start of its output, moved to where that is in the file */
+static void shiftFai(FILE *fFai, const char *sLines, size_t lLen, unsigned long long lBase) {
+    const char *sLine, *sField, *sEnd = sLines + lLen;
+    char *sRest;
+
+    for (sLine = sLines; sLine < sEnd; sLine = strchr(sRest, '\n') + 1) {
+        sField = strchr(strchr(sLine, '\t') + 1, '\t') + 1;
+        fwrite(sLine, 1, sField - sLine, fFai);
+        fprintf(fFai, "%llu", lBase + strtoull(sField, &sRest, 10));
+        fwrite(sRest, 1, strchr(sRest, '\n') + 1 - sRest, fFai);
+    }
+}
+
+/* Writes where the BGZF blocks written so far start, as the .gzi index of
+   bgzip and samtools, which leaves out the first; returns whether it could
+   not be written */
+static int writeGzi(const mg_writer *ptWriter, const char *sGzi) {
+    unsigned char sValue[8];
+    FILE *fGzi;
+    size_t k;
+    int iError;
+
+    if ((fGzi = fopen(sGzi, "wb")) == NULL) return 1;
+    storeLE(sValue, ptWriter->lBlockNum > 0 ? ptWriter->lBlockNum - 1 : 0, 8);
+    fwrite(sValue, 1, 8, fGzi);
+    for (k = 2; k < 2 * ptWriter->lBlockNum; k++) {
+        storeLE(sValue, ptWriter->alBlocks[k], 8);
+        fwrite(sValue, 1, 8, fGzi);
+    }
+    iError = ferror(fGzi);
+    return fclose(fGzi) != 0 || iError;
+}
+
+/* How much a date says, as in the collection_precision column */
+#define DATE_NONE   0       /* Not a date */
+#define DATE_DAY    1
+#define DATE_MONTH  2
+#define DATE_YEAR   3
+#define DATE_RANGE  4       /* Two dates separated by '/' */
+
+static const char *asPrecisions[] = {"NA", "day", "month", "year", "range"};
+
+/* A date read by parseDate(). Bounds are year, month and day of the first
+   and last day it can be */
+typedef struct tDate {
+    int iPrecision;
+    int aiLower[3];
+    int aiUpper[3];
+    char sDate[32];         /* 2012-03-05, 2012-03, 2012, or two of these with a '/' */
+} mg_date;
+
+/* Forms of INSDC dates, and of the odd ones which turn up in GenBank. A
+   shape has a '4' for a number of four digits, an 'n' for one of one or
+   two digits, an 'a' for a month name, and the separators; 'T' ends a
+   date with a time after it. Fields say what each number or name is */
+static const struct tDateForm {
+    const char *sShape;
+    const char *sFields;
+} atDateForms[] = {
+    {"n-a-4", "DMY"},       /* 05-Mar-2012 */
+    {"a-4", "MY"},          /* Mar-2012 */
+    {"4", "Y"},             /* 2012 */
+    {"4-n-n", "YMD"},       /* 2012-03-05 */
+    {"4-n", "YM"},          /* 2012-03 */
+    {"4-n-nT", "YMD"},      /* 2012-03-05T10:20:30Z */
+    {"4-a", "YM"},          /* 2012-Mar */
+    {"n-n-4", "DMY"},       /* 05-03-2012 */
+    {"n-4", "MY"},          /* 03-2012 */
+    {NULL, NULL}
+};
+
+static const char *asMonths[] = {"january", "february", "march", "april", "may", "june", "july",
+    "august", "september", "october", "november", "december"};
+
+static int daysInMonth(int iYear, int iMonth) {
+    static const int aiDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int iLeap = (iYear % 4 == 0 && iYear % 100 != 0) || iYear % 400 == 0;
+    return aiDays[iMonth - 1] + (iMonth == 2 && iLeap);
+}
+
+/* The month (1 to 12) of a month name or its first three letters, in any case; 0 for none */
+static int monthNumber(const char *sName, size_t lLen) {
+    char sKey[10];
+    int iMonth;
+
+    if (lLen < 3 || lLen >= sizeof(sKey)) return 0;
+    foldName(sKey, sName, lLen);
+    for (iMonth = 0; iMonth < 12; iMonth++) {
+        if (strncmp(asMonths[iMonth], sKey, lLen) == 0 && (lLen == 3 || asMonths[iMonth][lLen] == '\0')) return iMonth + 1;
+    }
+    return 0;
+}
+
+/* Reads a date without a '/' in one pass into its shape and fields, then
+   looks the shape up in atDateForms[]. Returns its precision, DATE_NONE if
+   it is not a valid date */
+static int parseDatePart(const char *sText, size_t lLen, int *aiLower, int *aiUpper) {
+    const char *sEnd = sText + lLen, *sStart;
+    const struct tDateForm *ptForm;
+    char sShape[8];
+    int aiValues[3], aiDate[3] = {0, 0, 0};
+    int iValueNum = 0, iShapeLen = 0, iValue, k;
+
+    while (sText < sEnd && iShapeLen < (int) sizeof(sShape) - 1) {
+        sStart = sText;
+        if (*sText >= '0' && *sText <= '9') {
+            for (iValue = 0; sText < sEnd && *sText >= '0' && *sText <= '9' && sText - sStart < 4; sText++) iValue = iValue * 10 + (*sText - '0');
+            if (sText < sEnd && *sText >= '0' && *sText <= '9') return DATE_NONE;
+            if (sText - sStart == 3 || iValueNum == 3) return DATE_NONE;
+            sShape[iShapeLen++] = (sText - sStart == 4) ? '4' : 'n';
+            aiValues[iValueNum++] = iValue;
+        } else if ((*sText | 0x20) >= 'a' && (*sText | 0x20) <= 'z') {
+            while (sText < sEnd && (*sText | 0x20) >= 'a' && (*sText | 0x20) <= 'z') sText++;
+            if (sText - sStart == 1 && (*sStart | 0x20) == 't') {
+                sShape[iShapeLen++] = 'T';
+                break;
+            }
+            if ((iValue = monthNumber(sStart, sText - sStart)) == 0 || iValueNum == 3) return DATE_NONE;
+            sShape[iShapeLen++] = 'a';
+            aiValues[iValueNum++] = iValue;
+        } else if (*sText == '-') {
+            sShape[iShapeLen++] = *sText++;
+        } else return DATE_NONE;
+    }
+    if (sText < sEnd && sShape[iShapeLen - 1] != 'T') return DATE_NONE;
+    sShape[iShapeLen] = '\0';
+
+    for (ptForm = atDateForms; ptForm->sShape != NULL && strcmp(ptForm->sShape, sShape) != 0; ptForm++);
+    if (ptForm->sShape == NULL) return DATE_NONE;
+    for (k = 0; ptForm->sFields[k] != '\0'; k++) aiDate[ptForm->sFields[k] == 'Y' ? 0 : ptForm->sFields[k] == 'M' ? 1 : 2] = aiValues[k];
+    /* Forms with two fields have a month, those with three a day too */
+    if (k >= 2 && (aiDate[1] < 1 || aiDate[1] > 12)) return DATE_NONE;
+    if (k == 3 && (aiDate[2] < 1 || aiDate[2] > daysInMonth(aiDate[0], aiDate[1]))) return DATE_NONE;
+
+    aiLower[0] = aiUpper[0] = aiDate[0];
+    aiLower[1] = aiDate[1] == 0 ? 1 : aiDate[1];
+    aiUpper[1] = aiDate[1] == 0 ? 12 : aiDate[1];
+    aiLower[2] = aiDate[2] == 0 ? 1 : aiDate[2];
+    aiUpper[2] = aiDate[2] == 0 ? daysInMonth(aiUpper[0], aiUpper[1]) : aiDate[2];
+    return aiDate[1] == 0 ? DATE_YEAR : aiDate[2] == 0 ? DATE_MONTH : DATE_DAY;
+}
+
+/* Writes a date of some precision as 2012-03-05, 2012-03 or 2012 */
+static int formatDate(char *sOut, int iPrecision, const int *aiDate) {
+    if (iPrecision == DATE_YEAR) return sprintf(sOut, "%04d", aiDate[0]);
+    if (iPrecision == DATE_MONTH) return sprintf(sOut, "%04d-%02d", aiDate[0], aiDate[1]);
+    return sprintf(sOut, "%04d-%02d-%02d", aiDate[0], aiDate[1], aiDate[2]);
+}
+
+/* Reads any INSDC date, a range of two of them included, without strptime(3)
+   or the locale; sText can be NULL */
+static void parseDate(mg_date *ptDate, const char *sText, size_t lLen) {
+    const char *sSlash = sText == NULL ? NULL : memchr(sText, '/', lLen);
+    int aiLower[3], aiUpper[3], iFirst, iSecond, iLen;
+
+    ptDate->iPrecision = DATE_NONE;
+    strcpy(ptDate->sDate, "NA");
+    if (sText == NULL) return;
+    if (sSlash == NULL) {
+        if ((ptDate->iPrecision = parseDatePart(sText, lLen, ptDate->aiLower, ptDate->aiUpper)) != DATE_NONE)
+            formatDate(ptDate->sDate, ptDate->iPrecision, ptDate->aiLower);
+        return;
+    }
+    if ((iFirst = parseDatePart(sText, sSlash - sText, ptDate->aiLower, aiUpper)) == DATE_NONE) return;
+    if ((iSecond = parseDatePart(sSlash + 1, sText + lLen - sSlash - 1, aiLower, ptDate->aiUpper)) == DATE_NONE) return;
+    /* The range must not run backwards */
+    if (ptDate->aiLower[0] * 10000 + ptDate->aiLower[1] * 100 + ptDate->aiLower[2] >
+        ptDate->aiUpper[0] * 10000 + ptDate->aiUpper[1] * 100 + ptDate->aiUpper[2]) return;
+    ptDate->iPrecision = DATE_RANGE;
+    iLen = formatDate(ptDate->sDate, iFirst, ptDate->aiLower);
+    ptDate->sDate[iLen++] = '/';
+    formatDate(ptDate->sDate + iLen, iSecond, aiLower);
+}
+
+/* The year and fraction of it at the start of a day */
+static double yearFraction(const int *aiDate) {
+    int iDay = aiDate[2] - 1, iMonth;
+    int iYearDays = 365 + (daysInMonth(aiDate[0], 2) == 29);
+    for (iMonth = 1; iMonth < aiDate[1]; iMonth++) iDay += daysInMonth(aiDate[0], iMonth);
+    return aiDate[0] + (double) iDay / iYearDays;
+}
+
+/* Decimal year of the middle of a date, from the start of its first day to
+   the end of its last, as BEAST takes dates */
+static double decimalYear(const mg_date *ptDate) {
+    int iYearDays = 365 + (daysInMonth(ptDate->aiUpper[0], 2) == 29);
+    return (yearFraction(ptDate->aiLower) + yearFraction(ptDate->aiUpper) + 1.0 / iYearDays) / 2;
+}
+
+/* Writes the FASTA entry and table row of one record. Nothing carries over
+   from earlier records, so records can be munged in any order */
+static void mungeRecord(gb_data *ptSeqData, mg_writer *ptFasta, mg_writer *ptTable, int sNoMissingDates, int sIncludeSequence, mg_countries *ptCountries) {
+    gb_span tDate, tHost, tCountry, tToken, tAccession;
+    const mg_place *ptPlace = NULL;
+    size_t lSequence = ptSeqData->sSequence == NULL ? 0 : strlen(ptSeqData->sSequence);
+    size_t lLine;
+    char sConfidence[8] = "NA";
+    double dConfidence;
+    gb_span tNone = {NULL, 0};
+    mg_date tCollection, tSubmission;
+    char sBounds[48] = "NA\tNA\tNA";
+    gb_feature *ptFeature;
+    size_t j,idx = 0;
+
+    tDate = tHost = tCountry = tNone;
+    for (j = 0; j < ptSeqData->iFeatureNum; j++) {
+          ptFeature = (ptSeqData->ptFeatures + j);
+          if (strcmp("source", ptFeature->sFeature) == 0) {
+              tDate = getQualValue(GB_QUAL_COLLECTION_DATE,ptFeature);
+              tHost = getQualValue(GB_QUAL_HOST,ptFeature);
+              if(tHost.sStr!=NULL){
+                  tHost = firstToken(tHost,';');
+              }
+              tCountry = getQualValue(GB_QUAL_COUNTRY,ptFeature);
+              if(tCountry.sStr==NULL){
+                  tCountry = getQualValue(GB_QUAL_GEO_LOC_NAME,ptFeature);
+              }
+              if(tCountry.sStr!=NULL){
+                  tToken = firstToken(tCountry,':');
+                  idx = resolveCountry(ptCountries, tToken, &dConfidence);
+                  snprintf(sConfidence, sizeof(sConfidence), "%.2f", dConfidence);
+                  if(ptCountries->ptGazetteer != NULL) ptPlace = resolvePlace(ptCountries, tCountry, idx);
+              }
+              }
+          }
+    parseDate(&tCollection, tDate.sStr, tDate.lLen);
+    parseDate(&tSubmission, ptSeqData->sDate, strlen(ptSeqData->sDate));
+    if(tCollection.iPrecision != DATE_NONE){
+      snprintf(sBounds, sizeof(sBounds), "%04d-%02d-%02d\t%04d-%02d-%02d\t%.4f",
+      tCollection.aiLower[0], tCollection.aiLower[1], tCollection.aiLower[2],
+      tCollection.aiUpper[0], tCollection.aiUpper[1], tCollection.aiUpper[2],
+      decimalYear(&tCollection));
+    }
+    tAccession = ptSeqData->tAccession;
+    /* With -t, records without a collection date that can be read are left out */
+    if(sNoMissingDates==1 && tCollection.iPrecision == DATE_NONE) return;
+    putChar(ptFasta,'>');
+    putSpan(ptFasta,tAccession);
+    putSpan(ptTable,tAccession);
+    if(sNoMissingDates==1){
+      putChar(ptFasta,'_');
+      putString(ptFasta,tCollection.sDate);
+      putChar(ptTable,'_');
+      putString(ptTable,tCollection.sDate);
+    }
+    putChar(ptFasta,'\n');
+    /* The index line gives where the sequence starts and how it is wrapped */
+    if(ptFasta->fFai != NULL){
+      lLine = (ptFasta->iWidth == 0 || lSequence < ptFasta->iWidth) ? lSequence : ptFasta->iWidth;
+      fprintf(ptFasta->fFai,"%.*s%s%s\t%lu\t%llu\t%lu\t%lu\n",SPANARG(tAccession),sNoMissingDates==1 ? "_" : "",
+        sNoMissingDates==1 ? tCollection.sDate : "",(unsigned long) lSequence,ptFasta->lOffset,(unsigned long) lLine,(unsigned long) lLine + 1);
+    }
+    putSequence(ptFasta,ptSeqData->sSequence,lSequence);
+
+    putChar(ptTable,'\t');
+    putSpan(ptTable,tAccession);
+    putChar(ptTable,'\t');
+    putULong(ptTable,ptSeqData->lLength);
+    putField(ptTable,tSubmission.sDate);
+    putChar(ptTable,'\t');
+    putSpan(ptTable,tHost);
+    putChar(ptTable,'\t');
+    putSpan(ptTable,tCountry);
+    putField(ptTable,tCountry.sStr == NULL ? "NA" : country[idx]);
+    putField(ptTable,tCountry.sStr == NULL ? "NA" : countrycode[idx]);
+    putChar(ptTable,'\t');
+    putSpan(ptTable,tDate);
+    putField(ptTable,tCollection.sDate);
+    putField(ptTable,sConfidence);
+    putField(ptTable,asPrecisions[tCollection.iPrecision]);
+    putField(ptTable,sBounds);
+    /* The admin1 and admin2 columns are only there with -a */
+    if(ptCountries->ptGazetteer != NULL){
+      putField(ptTable,ptPlace == NULL ? "NA" : ptPlace->sAdmin1);
+      putField(ptTable,ptPlace == NULL || ptPlace->sAdmin2 == NULL ? "NA" : ptPlace->sAdmin2);
+    }
+    if(sIncludeSequence==1){
+      putChar(ptTable,'\t');
+      putBytes(ptTable,ptSeqData->sSequence,lSequence);
+    }
+    putChar(ptTable,'\n');
+    /* Long sequences are only pointed to until here */
+    settleWriter(ptFasta);
+    settleWriter(ptTable);
+}
+
+/* Writes a row for each feature with a location overlapping lRegion[0]..lRegion[1] */
+static void mungeFeatures(gb_data *ptSeqData, FILE *fFeatures, unsigned long *lRegion, int sIncludeSequence) {
+    gb_feature **pptFound, **pptFeature;
+    gb_location *ptLocation;
+    gb_string sSequence;
+    int iInside;
+
+    pptFound = findFeatures(ptSeqData, lRegion[0], lRegion[1]);
+    for (pptFeature = pptFound; *pptFeature != NULL; pptFeature++) {
+      fprintf(fFeatures,"%.*s\t%s\t%lu\t%lu\t%c",
+      SPANARG(ptSeqData->tAccession),
+      (*pptFeature)->sFeature,
+      (*pptFeature)->lStart,
+      (*pptFeature)->lEnd,
+      (*pptFeature)->cDirection == REVCOM ? '-' : '+'
+      );
+      if(sIncludeSequence==1){
+        /* Locations outside the sequence (or remote ones) have no bases here */
+        iInside = ptSeqData->sSequence != NULL;
+        for (ptLocation = (*pptFeature)->ptLocation; iInside && ptLocation < (*pptFeature)->ptLocation + (*pptFeature)->iLocationNum; ptLocation++)
+          iInside = ptLocation->lStart >= 1 && ptLocation->lStart <= ptLocation->lEnd && ptLocation->lEnd <= ptSeqData->lLength;
+        if(iInside){
+          sSequence = getSequence(ptSeqData->sSequence, *pptFeature);
+          fprintf(fFeatures,"\t%s",sSequence);
+          free(sSequence);
+        }
+        else fprintf(fFeatures,"\tNA");
+      }
+      fprintf(fFeatures,"\n");
+    }
+    free(pptFound);
+}
+
+/* Writes the index row of a record: its accession.version (or accession),
+   and the offset and length of its text, with lBase added to the offset */
+static void mungeIndex(gb_data *ptSeqData, FILE *fIndex, unsigned long long lBase) {
+    gb_span tKey = ptSeqData->tVersion.lLen > 0 ? ptSeqData->tVersion : ptSeqData->tAccession;
+
+    fprintf(fIndex,"%.*s\t%llu\t%lu\n",SPANARG(tKey),lBase + ptSeqData->lOffset,ptSeqData->lTextLen);
+}
+
+static int compareNames(const void *pA, const void *pB) {
+    return strcmp(*(char *const *) pA, *(char *const *) pB);
+}
+
+/* A record to fetch, as found in the index */
+typedef struct tFetch {
+    unsigned long long lOffset;
+    unsigned long lLen;
+} mg_fetch;
+
+static int compareFetches(const void *pA, const void *pB) {
+    const mg_fetch *ptA = pA;
+    const mg_fetch *ptB = pB;
+    return (ptA->lOffset > ptB->lOffset) - (ptA->lOffset < ptB->lOffset);
+}
+
+/* Munges the records of the accessions listed in sAccessions, one a line
+   with or without a version, which the index written by -x places in the
+   input. Records are munged in the order of the input; returns whether one
+   could not be read */
+static int mungeFetch(gb_reader *ptReader, const char *sIndex, const char *sAccessions, mg_writer *ptFasta, mg_writer *ptTable, FILE *fFeatures, int sNoMissingDates, int sIncludeSequence, unsigned long *lRegion, mg_countries *ptCountries) {
+    FILE *fList;
+    char sLine[LINELEN];
+    char *sKey, *sDot, *sField, **psFound;
+    char **psNames = NULL;
+    char *acFound;
+    size_t lNameNum = 0, lNameMem = 0, lFetchNum = 0, lFetchMem = 0, k;
+    mg_fetch *ptFetches = NULL;
+    gb_data *ptSeqData;
+    int iError = 0;
+
+    if((fList = fopen(sAccessions,"r")) == NULL){
+        fprintf(stderr,"Error: Cannot open accession list %s.\n",sAccessions);
+        return 1;
+    }
+    while(fgets(sLine,sizeof(sLine),fList) != NULL){
+        sLine[strcspn(sLine,"\r\n \t")] = '\0';
+        if(sLine[0] == '\0') continue;
+        if(lNameNum == lNameMem){
+            lNameMem = lNameMem ? lNameMem * 2 : 1024;
+            psNames = realloc(psNames, lNameMem * sizeof(char *));
+        }
+        psNames[lNameNum++] = strdup(sLine);
+    }
+    fclose(fList);
+    qsort(psNames, lNameNum, sizeof(char *), compareNames);
+    acFound = calloc(lNameNum + 1, 1);
+
+    if((fList = fopen(sIndex,"r")) == NULL){
+        fprintf(stderr,"Error: Cannot open index %s.\n",sIndex);
+        iError = 1;
+    }
+    /* A listed accession without a version matches any version of it */
+    while(fList != NULL && lNameNum > 0 && fgets(sLine,sizeof(sLine),fList) != NULL){
+        sKey = sLine;
+        if((sField = strchr(sLine,'\t')) == NULL) continue;
+        *sField++ = '\0';
+        psFound = bsearch(&sKey, psNames, lNameNum, sizeof(char *), compareNames);
+        if(psFound == NULL && (sDot = strrchr(sKey,'.')) != NULL){
+            *sDot = '\0';
+            psFound = bsearch(&sKey, psNames, lNameNum, sizeof(char *), compareNames);
+        }
+        if(psFound == NULL) continue;
+        acFound[psFound - psNames] = 1;
+        if(lFetchNum == lFetchMem){
+            lFetchMem = lFetchMem ? lFetchMem * 2 : 1024;
+            ptFetches = realloc(ptFetches, lFetchMem * sizeof(mg_fetch));
+        }
+        ptFetches[lFetchNum].lOffset = strtoull(sField, &sField, 10);
+        ptFetches[lFetchNum++].lLen = strtoul(sField, NULL, 10);
+    }
+    if(fList != NULL) fclose(fList);
+
+    for (k = 0; k < lNameNum && ! iError; k++) {
+        if(! acFound[k]) fprintf(stderr,"Warning: %s is not in the index.\n",psNames[k]);
+    }
+
+    /* Going through the input in order keeps reads sequential */
+    if(lFetchNum > 0) qsort(ptFetches, lFetchNum, sizeof(mg_fetch), compareFetches);
+    for (k = 0; k < lFetchNum; k++) {
+        if((ptSeqData = fetchGBFF(ptReader, ptFetches[k].lOffset, ptFetches[k].lLen)) == NULL){
+            fprintf(stderr,"Error: No record at offset %llu; the input must be the uncompressed file the index was written for.\n",ptFetches[k].lOffset);
+            iError = 1;
+            break;
+        }
+        mungeRecord(ptSeqData, ptFasta, ptTable, sNoMissingDates, sIncludeSequence, ptCountries);
+        if(fFeatures != NULL) mungeFeatures(ptSeqData, fFeatures, lRegion, sIncludeSequence);
+        freeGBRecord(ptSeqData);
+    }
+
+    for (k = 0; k < lNameNum; k++) free(psNames[k]);
+    free(psNames);
+    free(acFound);
+    free(ptFetches);
+
+    return iError;
+}
+
+/* A record as it was last munged, see -u */
+typedef struct tState {
+    char *sAccession;
+    unsigned long lVersion;
+    char sDate[DATESTRLEN + 1];
+} mg_state;
+
+/* States by accession, in an open addressed hash table over the order they
+   were read in. It is only read while records are munged, which may happen
+   on several threads */
+typedef struct tStates {
+    mg_state *ptStates;
+    size_t lStateNum;
+    size_t lStateMem;
+    size_t *plSlots;        /* 1 + the index of a state, 0 when free */
+    size_t lSlotNum;        /* A power of 2 */
+} mg_states;
+
+/* The slot of an accession, which is free when it has no state */
+static size_t *findSlot(mg_states *ptStates, const char *sAccession, size_t lLen) {
+    size_t lSlot = hashName(sAccession, lLen) & (ptStates->lSlotNum - 1);
+    mg_state *ptState;
+    for (;; lSlot = (lSlot + 1) & (ptStates->lSlotNum - 1)) {
+        if (ptStates->plSlots[lSlot] == 0) return ptStates->plSlots + lSlot;
+        ptState = ptStates->ptStates + ptStates->plSlots[lSlot] - 1;
+        if (strncmp(ptState->sAccession, sAccession, lLen) == 0 && ptState->sAccession[lLen] == '\0')
+            return ptStates->plSlots + lSlot;
+    }
+}
+
+/* Sets the state of an accession, keeping its place if it had one */
+static void putState(mg_states *ptStates, const char *sAccession, size_t lLen, unsigned long lVersion, const char *sDate) {
+    size_t *plSlot, k;
+    mg_state *ptState;
+
+    /* Keep the table at most half full */
+    if (2 * (ptStates->lStateNum + 1) > ptStates->lSlotNum) {
+        ptStates->lSlotNum = ptStates->lSlotNum ? ptStates->lSlotNum * 2 : 1024;
+        free(ptStates->plSlots);
+        ptStates->plSlots = calloc(ptStates->lSlotNum, sizeof(size_t));
+        for (k = 0; k < ptStates->lStateNum; k++) {
+            ptState = ptStates->ptStates + k;
+            *findSlot(ptStates, ptState->sAccession, strlen(ptState->sAccession)) = k + 1;
+        }
+    }
+
+    plSlot = findSlot(ptStates, sAccession, lLen);
+    if (*plSlot == 0) {
+        if (ptStates->lStateNum == ptStates->lStateMem) {
+            ptStates->lStateMem = ptStates->lStateMem ? ptStates->lStateMem * 2 : 1024;
+            ptStates->ptStates = realloc(ptStates->ptStates, ptStates->lStateMem * sizeof(mg_state));
+        }
+        ptState = ptStates->ptStates + ptStates->lStateNum++;
+        ptState->sAccession = malloc(lLen + 1);
+        memcpy(ptState->sAccession, sAccession, lLen);
+        ptState->sAccession[lLen] = '\0';
+        *plSlot = ptStates->lStateNum;
+    }
+    ptState = ptStates->ptStates + *plSlot - 1;
+    ptState->lVersion = lVersion;
+    snprintf(ptState->sDate, sizeof(ptState->sDate), "%s", sDate);
+}
+
+/* Reads state lines of accession, version and LOCUS date; later lines win */
+static void readStates(mg_states *ptStates, FILE *fState) {
+    char sLine[LINELEN];
+    char sDate[DATESTRLEN + 1];
+    char *sField;
+    unsigned long lVersion;
+
+    while(fgets(sLine,sizeof(sLine),fState) != NULL){
+        if((sField = strchr(sLine,'\t')) == NULL) continue;
+        *sField++ = '\0';
+        if(sscanf(sField,"%lu\t%11s",&lVersion,sDate) != 2) continue;
+        putState(ptStates, sLine, strlen(sLine), lVersion, sDate);
+    }
+}
+
+/* Replaces the state file with the states, through a temporary file */
+static int writeStates(mg_states *ptStates, const char *sState) {
+    FILE *fState;
+    char *sTemp = malloc(strlen(sState) + 5);
+    size_t k;
+    int iError;
+
+    sprintf(sTemp,"%s.tmp",sState);
+    if((fState = fopen(sTemp,"w")) == NULL){
+        free(sTemp);
+        return 1;
+    }
+    for (k = 0; k < ptStates->lStateNum; k++)
+        fprintf(fState,"%s\t%lu\t%s\n",ptStates->ptStates[k].sAccession,ptStates->ptStates[k].lVersion,ptStates->ptStates[k].sDate);
+    iError = (fclose(fState) != 0);
+#ifdef _WIN32
+    remove(sState);
+#endif
+    if(! iError) iError = (rename(sTemp,sState) != 0);
+    free(sTemp);
+    return iError;
+}
+
+static void freeStates(mg_states *ptStates) {
+    size_t k;
+    for (k = 0; k < ptStates->lStateNum; k++) free(ptStates->ptStates[k].sAccession);
+    free(ptStates->ptStates);
+    free(ptStates->plSlots);
+}
+
+/* The number after the last '.' of a VERSION, 0 without one */
+static unsigned long versionNumber(gb_span tVersion) {
+    const char *sDot = tVersion.sStr + tVersion.lLen;
+    unsigned long lVersion = 0;
+    while (sDot > tVersion.sStr && *(sDot - 1) != '.') sDot--;
+    if (sDot == tVersion.sStr) return 0;
+    for (; sDot < tVersion.sStr + tVersion.lLen && isdigit((unsigned char) *sDot); sDot++)
+        lVersion = lVersion * 10 + (*sDot - '0');
+    return lVersion;
+}
+
+/* Record filter of -u: whether the record is new, or has another version
+   or LOCUS date than when it was last munged */
+static int isChanged(const gb_data *ptSeqData, void *pArg) {
+    mg_states *ptStates = pArg;
+    mg_state *ptState;
+    size_t *plSlot;
+
+    if (ptSeqData->tAccession.lLen == 0 || ptStates->lSlotNum == 0) return 1;
+    plSlot = findSlot(ptStates, ptSeqData->tAccession.sStr, ptSeqData->tAccession.lLen);
+    if (*plSlot == 0) return 1;
+    ptState = ptStates->ptStates + *plSlot - 1;
+    return ptState->lVersion != versionNumber(ptSeqData->tVersion) || strcmp(ptState->sDate, ptSeqData->sDate) != 0;
+}
+
+/* Writes the state line of a munged record */
+static void mungeState(gb_data *ptSeqData, FILE *fState) {
+    if (ptSeqData->tAccession.lLen == 0) return;
+    fprintf(fState,"%.*s\t%lu\t%s\n",(int) ptSeqData->tAccession.lLen,ptSeqData->tAccession.sStr,versionNumber(ptSeqData->tVersion),ptSeqData->sDate);
+}
+
+#ifndef _WIN32
+/* A block of records and its output, munged by a worker thread */
+typedef struct tSlot {
+    gb_block tBlock;
+    char *sFasta;
+    char *sTable;
+    char *sFeatures;
+    char *sIndex;
+    char *sState;
+    char *sFai;
+    size_t lFasta;
+    size_t lTable;
+    size_t lFeatures;
+    size_t lIndex;
+    size_t lState;
+    size_t lFai;
+    int iError;
+    int iDone;
+} mg_slot;
+
+/* Blocks are read in order into a ring of slots, munged by whichever worker
+   is free and written out in order again */
+typedef struct tPool {
+    pthread_mutex_t tLock;
+    pthread_cond_t tRead;   /* Signalled when a block is read, or at the end */
+    pthread_cond_t tDone;   /* Signalled when a block is munged */
+    mg_slot *ptSlots;
+    size_t lSlotNum;
+    size_t lRead;           /* Blocks read so far */
+    size_t lTaken;          /* Blocks taken by workers so far */
+    int iQuit;
+    int sNoMissingDates;
+    int sIncludeSequence;
+    unsigned int iFields;
+    unsigned long *lRegion; /* NULL without -r */
+    int iIndex;             /* Whether to write index rows */
+    mg_states *ptStates;    /* NULL without -u */
+    const mg_gazetteer *ptGazetteer; /* NULL without -a */
+    unsigned int iWidth;    /* Of FASTA lines, see mg_writer */
+    int iFai;               /* Whether to write FASTA index lines */
+} mg_pool;
+
+static void *mungeWorker(void *pArg) {
+    mg_pool *ptPool = pArg;
+    mg_slot *ptSlot;
+    gb_reader *ptReader;
+    gb_data *ptSeqData;
+    mg_writer tFasta;
+    mg_writer tTable;
+    FILE *fFeatures = NULL;
+    FILE *fIndex = NULL;
+    FILE *fState = NULL;
+    mg_countries tCountries;
+
+    initCountries(&tCountries, ptPool->ptGazetteer);
+    pthread_mutex_lock(&ptPool->tLock);
+    for (;;) {
+        while (ptPool->lTaken == ptPool->lRead && ! ptPool->iQuit)
+            pthread_cond_wait(&ptPool->tRead, &ptPool->tLock);
+        if (ptPool->lTaken == ptPool->lRead) break;
+        ptSlot = ptPool->ptSlots + ptPool->lTaken++ % ptPool->lSlotNum;
+        pthread_mutex_unlock(&ptPool->tLock);
+
+        openWriter(&tFasta, -1);
+        openWriter(&tTable, -1);
+        tFasta.iWidth = ptPool->iWidth;
+        if (ptPool->iFai) tFasta.fFai = open_memstream(&ptSlot->sFai, &ptSlot->lFai);
+        if (ptPool->lRegion != NULL) fFeatures = open_memstream(&ptSlot->sFeatures, &ptSlot->lFeatures);
+        if (ptPool->iIndex) fIndex = open_memstream(&ptSlot->sIndex, &ptSlot->lIndex);
+        if (ptPool->ptStates != NULL) fState = open_memstream(&ptSlot->sState, &ptSlot->lState);
+        ptReader = openGBMemory(ptSlot->tBlock.sData, ptSlot->tBlock.lLen, GB_ZEROCOPY);
+        selectGBFF(ptReader, ptPool->iFields, ptPool->lRegion == NULL ? asFeatures : NULL);
+        if (ptPool->ptStates != NULL) filterGBFF(ptReader, isChanged, ptPool->ptStates);
+        while ((ptSeqData = readGBFF(ptReader)) != NULL) {
+            mungeRecord(ptSeqData, &tFasta, &tTable, ptPool->sNoMissingDates, ptPool->sIncludeSequence, &tCountries);
+            if (fFeatures != NULL) mungeFeatures(ptSeqData, fFeatures, ptPool->lRegion, ptPool->sIncludeSequence);
+            if (fIndex != NULL) mungeIndex(ptSeqData, fIndex, ptSlot->tBlock.lOffset);
+            if (fState != NULL) mungeState(ptSeqData, fState);
+            freeGBRecord(ptSeqData);
+        }
+        ptSlot->iError = errorGBFF(ptReader);
+        closeGBFF(ptReader);
+        /* The slot takes over the buffers */
+        ptSlot->sFasta = tFasta.sBuf;
+        ptSlot->lFasta = tFasta.lLen;
+        ptSlot->sTable = tTable.sBuf;
+        ptSlot->lTable = tTable.lLen;
+        if (fFeatures != NULL) fclose(fFeatures);
+        if (fIndex != NULL) fclose(fIndex);
+        if (fState != NULL) fclose(fState);
+        if (tFasta.fFai != NULL) fclose(tFasta.fFai);
+        freeGBBlock(&ptSlot->tBlock);
+
+        pthread_mutex_lock(&ptPool->tLock);
+        ptSlot->iDone = 1;
+        pthread_cond_signal(&ptPool->tDone);
+    }
+    pthread_mutex_unlock(&ptPool->tLock);
+
+    freeCountries(&tCountries);
+    return NULL;
+}
+
+/* Munges the input with iThreads workers, writing records in input order.
+   Like the serial loop, output stops at the first record which cannot be
+   parsed; returns whether it did */
+static int mungeParallel(gb_reader *ptReader, mg_writer *ptFasta, mg_writer *ptTable, FILE *fFeatures, FILE *fIndex, FILE *fState, int sNoMissingDates, int sIncludeSequence, unsigned int iFields, unsigned long *lRegion, mg_states *ptStates, const mg_gazetteer *ptGazetteer, int iThreads) {
+    mg_pool tPool;
+    mg_slot *ptSlot;
+    pthread_t *ptThreads;
+    size_t lWritten = 0;
+    int iEnd = 0;
+    int iStop = 0;
+    int i;
+
+    pthread_mutex_init(&tPool.tLock, NULL);
+    pthread_cond_init(&tPool.tRead, NULL);
+    pthread_cond_init(&tPool.tDone, NULL);
+    tPool.lSlotNum = 2 * iThreads; /* Keeps workers busy while the oldest block is written */
+    tPool.ptSlots = calloc(tPool.lSlotNum, sizeof(mg_slot));
+    tPool.lRead = tPool.lTaken = 0;
+    tPool.iQuit = 0;
+    tPool.sNoMissingDates = sNoMissingDates;
+    tPool.sIncludeSequence = sIncludeSequence;
+    tPool.iFields = iFields;
+    tPool.lRegion = lRegion;
+    tPool.iIndex = fIndex != NULL;
+    tPool.ptStates = ptStates;
+    tPool.ptGazetteer = ptGazetteer;
+    tPool.iWidth = ptFasta->iWidth;
+    tPool.iFai = ptFasta->fFai != NULL;
+
+    ptThreads = malloc(iThreads * sizeof(pthread_t));
+    for (i = 0; i < iThreads; i++) pthread_create(ptThreads + i, NULL, mungeWorker, &tPool);
+
+    pthread_mutex_lock(&tPool.tLock);
+    for (;;) {
+        /* Write out finished blocks in the order they were read */
+        while (lWritten < tPool.lRead && (ptSlot = tPool.ptSlots + lWritten % tPool.lSlotNum)->iDone) {
+            pthread_mutex_unlock(&tPool.tLock);
+            if (! iStop) {
+                if (ptFasta->fFai != NULL) shiftFai(ptFasta->fFai, ptSlot->sFai, ptSlot->lFai, ptFasta->lOffset);
+                putBytes(ptFasta, ptSlot->sFasta, ptSlot->lFasta);
+                putBytes(ptTable, ptSlot->sTable, ptSlot->lTable);
+                settleWriter(ptFasta);
+                settleWriter(ptTable);
+                if (fFeatures != NULL) fwrite(ptSlot->sFeatures, 1, ptSlot->lFeatures, fFeatures);
+                if (fIndex != NULL) fwrite(ptSlot->sIndex, 1, ptSlot->lIndex, fIndex);
+                if (fState != NULL) fwrite(ptSlot->sState, 1, ptSlot->lState, fState);
+                iStop = ptSlot->iError;
+            }
+            free(ptSlot->sFasta);
+            free(ptSlot->sTable);
+            free(ptSlot->sFeatures);
+            free(ptSlot->sIndex);
+            free(ptSlot->sState);
+            free(ptSlot->sFai);
+            ptSlot->sFeatures = ptSlot->sIndex = ptSlot->sState = ptSlot->sFai = NULL;
+            pthread_mutex_lock(&tPool.tLock);
+            ptSlot->iDone = 0;
+            lWritten++;
+        }
+
+        /* Read ahead while there is a free slot */
+        if (! iEnd && ! iStop && tPool.lRead - lWritten < tPool.lSlotNum) {
+            ptSlot = tPool.ptSlots + tPool.lRead % tPool.lSlotNum;
+            pthread_mutex_unlock(&tPool.tLock);
+            iEnd = ! readGBBlock(ptReader, BLOCKLEN, &ptSlot->tBlock);
+            pthread_mutex_lock(&tPool.tLock);
+            if (! iEnd) {
+                tPool.lRead++;
+                pthread_cond_signal(&tPool.tRead);
+            }
+            continue;
+        }
+
+        if (lWritten == tPool.lRead) break;
+        pthread_cond_wait(&tPool.tDone, &tPool.tLock);
+    }
+    tPool.iQuit = 1;
+    pthread_cond_broadcast(&tPool.tRead);
+    pthread_mutex_unlock(&tPool.tLock);
+
+    for (i = 0; i < iThreads; i++) pthread_join(ptThreads[i], NULL);
+
+    free(ptThreads);
+    free(tPool.ptSlots);
+    pthread_cond_destroy(&tPool.tDone);
+    pthread_cond_destroy(&tPool.tRead);
+    pthread_mutex_destroy(&tPool.tLock);
+
+    return iStop;
+}
+#endif
+
 int main(int argc, char *argv[]) {
     char *sFileName = NULL;
     char *sFasta = NULL;
     char *sTable = NULL;
-    char *sDate = NULL;
-    char *sCountry = NULL;
-    char *sCountry2 = NULL;
-    char *sHost = NULL;
+    char *sFeatures = NULL;
+    char *sRegion = NULL;
+    char *sIndex = NULL;
+    char *sFetch = NULL;
+    char *sState = NULL;
+    char *sGazetteer = NULL;
+    char *sFormat = "tsv";
+    char *sFai = NULL;
+    char *sWidth = NULL;
+    mg_countries tCountries;
+    mg_gazetteer tGazetteer;
+    char *sEnd;
+    unsigned long lRegion[2];
     int sNoMissingDates = 0;
     int sIncludeSequence = 0;
-    struct tm ltm = {0};
-    struct tm cltm = {0};
-    char sDate2[] = "0001-01-01";
-    char sCollectionDate[] = "0001-01-01";
-    int ld[NUM_COUNTRY];
+    int sCompress = 0;
+    long lWidth = 0;
+    int iThreads = 1;
+    int iError = 0;
+    int iHeader;
+    int iArrow;
+    ar_field atFields[sizeof(atColumns) / sizeof(atColumns[0])];
+    int iFieldNum = 0;
+    unsigned int iFields;
+    size_t k;
 
-    gb_data **pptSeqData, *ptSeqData;
-    gb_feature *ptFeature;
-    size_t i,j,k,idx;
+    gb_reader *ptReader;
+    gb_data *ptSeqData;
 
     FILE *fFasta;
     FILE *fTable;
+    mg_writer tFasta;
+    mg_writer tTable;
+    FILE *fFeatures = NULL;
+    FILE *fIndex = NULL;
+    FILE *fState = NULL;
+    FILE *fFai = NULL;
+    mg_states tStates = {NULL, 0, 0, NULL, 0};
 
     int iOpt;
-    while((iOpt = getopt(argc, argv, "h:i:f:o:ts")) != -1) {
+    while((iOpt = getopt(argc, argv, "h:i:f:o:tsj:r:g:x:F:u:a:O:zw:")) != -1) {
      switch(iOpt) {
      case 'h':
          help();
@@ -321,6 +1950,36 @@ int main(int argc, char *argv[]) {
      case 's':
          sIncludeSequence = 1;
          break;
+     case 'j':
+         iThreads = atoi(optarg);
+         break;
+     case 'r':
+         sRegion = optarg;
+         break;
+     case 'g':
+         sFeatures = optarg;
+         break;
+     case 'x':
+         sIndex = optarg;
+         break;
+     case 'F':
+         sFetch = optarg;
+         break;
+     case 'u':
+         sState = optarg;
+         break;
+     case 'a':
+         sGazetteer = optarg;
+         break;
+     case 'O':
+         sFormat = optarg;
+         break;
+     case 'z':
+         sCompress = 1;
+         break;
+     case 'w':
+         sWidth = optarg;
+         break;
      default:
          help();
          exit(0);
@@ -345,134 +2004,241 @@ int main(int argc, char *argv[]) {
         exit(0);
     }
 
-    pptSeqData = parseGBFF(sFileName); /* parse a GBF file which contains more than one GBF sequence data */
-    fFasta = fopen(sFasta,"w");
-    fTable = fopen(sTable,"w");
-    fprintf(fTable,"%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s",
-    "name",
-    "accession",
-    "length",
-    "submission_date",
-    "host",
-    "country_original",
-    "country",
-    "countrycode",
-    "collection_original",
-    "collection_date");
-    if(sIncludeSequence==1){
-     fprintf(fTable,"\t%s","sequence");
-    }
-    fprintf(fTable,"\n");
-    for (i = 0; (ptSeqData = *(pptSeqData + i)) != NULL; i++) { /* ptSeqData points a parsed data of a GBF sequence data */
-      sCountry2 = NULL;  /* Reset for each sequence */
-      for (j = 0; j < ptSeqData->iFeatureNum; j++) {
-            ptFeature = (ptSeqData->ptFeatures + j);
-            if (strcmp("source", ptFeature->sFeature) == 0) {
-                sDate = getQualValue("collection_date",ptFeature);
-                if(sDate!=NULL){
-                    if(strlen(sDate)==11){
-                        strptime(sDate, "%d-%b-%Y", &ltm);
-                        strftime(sDate2, sizeof(sDate2), "%Y-%m-%d", &ltm);
-                    }
-                    if(strlen(sDate)==10){
-                        if(strncmp(&sDate[4],"-",1)==0){
-                          strptime(sDate, "%Y-%m-%d", &ltm);
-                        }else{
-                          strptime(sDate, "%d-%m-%Y", &ltm);
-                        }
-                        strftime(sDate2, sizeof(sDate2), "%Y-%m-%d", &ltm);
-                    }
-                    if(strlen(sDate)==8){
-                        if(strncmp(&sDate[4],"-",1)==0){
-                          strptime(sDate, "%Y-%b", &ltm);
-                        }
-                        else{
-                          strptime(sDate, "%b-%Y", &ltm);
-                        }
-                        strftime(sDate2, sizeof(sDate2), "%Y-%m", &ltm);
-                    }
-                    if(strlen(sDate)==7){
-                        if(strncmp(&sDate[4],"-",1)==0){
-                          strptime(sDate, "%Y-%m", &ltm);
-                        }else{
-                          strptime(sDate, "%m-%Y", &ltm);
-                        }
-                        strftime(sDate2, sizeof(sDate2), "%Y-%m", &ltm);
-                    }
-                    if(strlen(sDate)==4){
-                        strptime(sDate, "%Y", &ltm);
-                        strftime(sDate2, sizeof(sDate2), "%Y", &ltm);
-                    }
-                }
-                sHost = getQualValue("host",ptFeature);
-                if(sHost!=NULL){
-                    sHost = strtok(sHost,";");
-                }
-                sCountry = getQualValue("country",ptFeature);
-                if(sCountry==NULL){
-                    sCountry = getQualValue("geo_loc_name",ptFeature);
-                }
-                if(sCountry!=NULL){
-                    if(sCountry2 != NULL) {
-                        free(sCountry2);  /* Free previous allocation */
-                    }
-                    sCountry2 = malloc(1+strlen(sCountry));
-	                strcpy(sCountry2,sCountry);
-                    sCountry2 = strtok(sCountry2,":");
-                    for (k=0;k < NUM_COUNTRY;k++){
-                        ld[k] = levenshteinDistance(sCountry2,country[k]);
-                    }
-                    idx = minIndex(ld,NUM_COUNTRY);
-                }
-                }
-            }
-      strptime(ptSeqData->sDate,"%d-%b-%Y",&cltm);
-      strftime(sCollectionDate, sizeof(sCollectionDate),"%Y-%m-%d", &cltm);
-      if(sNoMissingDates==1){
-        if(sDate != NULL){
-        fprintf(fFasta,">%s_%s\n%s\n",ptSeqData->sAccession,sDate2,ptSeqData->sSequence);
-        fprintf(fTable,"%s_%s\t%s\t%lu\t%s\t%s\t%s\t%s\t%s\t%s\t%s%s%s\n",
-        ptSeqData->sAccession,
-        sDate2,
-        ptSeqData->sAccession,
-        ptSeqData->lLength,
-        sCollectionDate,
-        sHost == NULL ? "NA" : sHost,
-        sCountry == NULL ? "NA" : sCountry,
-        sCountry == NULL ? "NA" : country[idx],
-        sCountry == NULL ? "NA" : countrycode[idx],
-        sDate,
-        sDate2,
-        sIncludeSequence == 0 ? "" : "\t",
-        sIncludeSequence == 0 ? "" : ptSeqData->sSequence
-        );
+    if(iThreads < 1){
+        printf("%s","Error: The number of threads must be at least 1.\n\n");
+        help();
+        exit(0);
+    }
+
+    if((sRegion == NULL) != (sFeatures == NULL)){
+        printf("%s","Error: -r and -g go together.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(sFetch != NULL && (sIndex == NULL || strcmp(sFileName,"-")==0)){
+        printf("%s","Error: -F needs the index given with -x, and an input file.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(sFetch != NULL && sState != NULL){
+        printf("%s","Error: -F and -u cannot be used together.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(strcmp(sFormat,"tsv") != 0 && strcmp(sFormat,"arrow") != 0){
+        printf("Error: Unknown output format %s.\n\n",sFormat);
+        help();
+        exit(0);
+    }
+    iArrow = strcmp(sFormat,"arrow")==0;
+
+    if(iArrow && sState != NULL){
+        printf("%s","Error: -u cannot append to an Arrow file.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(sWidth != NULL){
+        lWidth = strtol(sWidth, &sEnd, 10);
+        if(sEnd == sWidth || *sEnd != '\0' || lWidth < 0 || lWidth > UINT_MAX){
+            printf("Error: Cannot read the line width %s.\n\n",sWidth);
+            help();
+            exit(0);
         }
-      }
-      else{
-        fprintf(fFasta,">%s\n%s\n",ptSeqData->sAccession,ptSeqData->sSequence);
-        fprintf(fTable,"%s\t%s\t%lu\t%s\t%s\t%s\t%s\t%s\t%s\t%s%s%s\n",
-        ptSeqData->sAccession,
-        ptSeqData->sAccession,
-        ptSeqData->lLength,
-        sCollectionDate,
-        sHost == NULL ? "NA" : sHost,
-        sCountry == NULL ? "NA" : sCountry,
-        sCountry == NULL ? "NA" : country[idx],
-        sCountry == NULL ? "NA" : countrycode[idx],
-        sDate == NULL ? "NA" : sDate,
-        sDate == NULL ? "NA" : sDate2,
-        sIncludeSequence == 0 ? "" : "\t",
-        sIncludeSequence == 0 ? "" : ptSeqData->sSequence
-        );
+    }
+
+    /* The blocks already in a compressed FASTA file are not known, so neither is its .gzi */
+    if(sWidth != NULL && sCompress && sState != NULL){
+        printf("%s","Error: -w and -z cannot be used with -u.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(sRegion != NULL){
+        /* A range from..to, or a single position */
+        lRegion[0] = lRegion[1] = strtoul(sRegion, &sEnd, 10);
+        if(sEnd != sRegion && strncmp(sEnd,"..",2)==0) lRegion[1] = strtoul(sEnd + 2, &sEnd, 10);
+        if(sEnd == sRegion || *sEnd != '\0' || lRegion[0] > lRegion[1]){
+            printf("Error: Cannot read the range %s.\n\n",sRegion);
+            help();
+            exit(0);
         }
-      /* Free allocated memory for this sequence */
-      if(sCountry2 != NULL) {
-          free(sCountry2);
-          sCountry2 = NULL;
+    }
+
+    if((strcmp(sFasta,"-")==0) + (strcmp(sTable,"-")==0) + (sFeatures != NULL && strcmp(sFeatures,"-")==0) +
+       (sIndex != NULL && sFetch == NULL && strcmp(sIndex,"-")==0) > 1){
+        printf("%s","Error: Only one output can be written to stdout.\n\n");
+        help();
+        exit(0);
+    }
+
+    if(sGazetteer != NULL && readGazetteer(&tGazetteer, sGazetteer) != 0){
+        fprintf(stderr,"Error: Cannot open gazetteer %s.\n",sGazetteer);
+        exit(1);
+    }
+
+    /* Records are parsed one at a time, so memory use does not grow with the input */
+    ptReader = openGBFF(strcmp(sFileName,"-")==0 ? NULL : sFileName, GB_MMAP | GB_ZEROCOPY);
+    if(ptReader == NULL){
+        fprintf(stderr,"Error: Cannot open input file %s.\n",sFileName);
+        exit(1);
+    }
+    setThreadsGBFF(ptReader, iThreads);
+    /* Records from earlier runs with the state file stay in the outputs */
+    if(sState != NULL){
+      if((fState = fopen(sState,"r")) != NULL){
+        readStates(&tStates, fState);
+        fclose(fState);
       }
+      if((fState = tmpfile()) == NULL){
+        fprintf(stderr,"Error: Cannot open a temporary file for %s.\n",sState);
+        exit(1);
+      }
+    }
+    fFasta = strcmp(sFasta,"-")==0 ? stdout : fopen(sFasta,sState == NULL ? "w" : "a");
+    if(fFasta == NULL){
+        fprintf(stderr,"Error: Cannot open FASTA file %s.\n",sFasta);
+        exit(1);
+    }
+    /* There is nothing to index on stdout */
+    if(sWidth != NULL && fFasta != stdout){
+      sFai = malloc(strlen(sFasta) + 5);
+      sprintf(sFai,"%s.fai",sFasta);
+      fFai = fopen(sFai,sState == NULL ? "w" : "a");
+      if(fFai == NULL){
+          fprintf(stderr,"Error: Cannot open FASTA index %s.\n",sFai);
+          exit(1);
+      }
+    }
+    fTable = strcmp(sTable,"-")==0 ? stdout : fopen(sTable,sState != NULL ? "a" : iArrow ? "wb" : "w");
+    if(fTable == NULL){
+        fprintf(stderr,"Error: Cannot open output file %s.\n",sTable);
+        exit(1);
+    }
+    if(sFeatures != NULL){
+      fFeatures = strcmp(sFeatures,"-")==0 ? stdout : fopen(sFeatures,"w");
+      if(fFeatures == NULL){
+          fprintf(stderr,"Error: Cannot open feature file %s.\n",sFeatures);
+          exit(1);
+      }
+      for (k = 0; asFeatureColumns[k] != NULL; k++) {
+        if(strcmp(asFeatureColumns[k],"sequence")==0 && sIncludeSequence==0) continue;
+        fprintf(fFeatures,"%s%s",k == 0 ? "" : "\t",asFeatureColumns[k]);
+      }
+      fprintf(fFeatures,"\n");
+    }
+    if(sIndex != NULL && sFetch == NULL){
+      fIndex = strcmp(sIndex,"-")==0 ? stdout : fopen(sIndex,"w");
+      if(fIndex == NULL){
+          fprintf(stderr,"Error: Cannot open index file %s.\n",sIndex);
+          exit(1);
+      }
+    }
+    /* Only the fields which end up in the output are parsed; the FASTA file needs ORIGIN */
+    iFields = GB_ORIGIN;
+    /* A table appended to already has its header; an Arrow file has a schema instead */
+    iHeader = ! iArrow && (sState == NULL || fseek(fTable,0,SEEK_END) != 0 || ftell(fTable) == 0);
+    for (k = 0; atColumns[k].sName != NULL; k++) {
+      if(strcmp(atColumns[k].sName,"sequence")==0 && sIncludeSequence==0) continue;
+      if(strncmp(atColumns[k].sName,"admin",5)==0 && sGazetteer==NULL) continue;
+      atFields[iFieldNum].sName = atColumns[k].sName;
+      atFields[iFieldNum++].iType = atColumns[k].iType;
+      iFields |= atColumns[k].iFields;
+    }
+    /* Rows go straight to the file descriptors from here on */
+    fflush(fFasta);
+    fflush(fTable);
+    openWriter(&tFasta, fileno(fFasta));
+    tFasta.iWidth = lWidth;
+    tFasta.fFai = fFai;
+    /* Index lines of appended records carry on from the end of the file */
+    if(fFai != NULL && sState != NULL && fseek(fFasta,0,SEEK_END) == 0) tFasta.lOffset = ftell(fFasta);
+    if(iArrow){
+      openWriter(&tTable, -1);
+      tTable.ptArrow = openArrow(fTable, atFields, iFieldNum);
+    }
+    else openWriter(&tTable, fileno(fTable));
+    /* An Arrow file is read as it is, so it is left uncompressed */
+    if(sCompress){
+      compressWriter(&tFasta, iThreads);
+      if(! iArrow) compressWriter(&tTable, iThreads);
+    }
+    for (k = 0; iHeader && k < (size_t) iFieldNum; k++) {
+      if(k > 0) putChar(&tTable,'\t');
+      putString(&tTable,atFields[k].sName);
     }
-    freeGBData(pptSeqData); /* release memory space */
+    if(iHeader) putChar(&tTable,'\n');
+    /* Listing overlapping features needs all of them */
+    if(fFeatures != NULL) iFields |= GB_ACCESSION | GB_FEATURES;
+    if(fIndex != NULL || fState != NULL) iFields |= GB_ACCESSION | GB_VERSION;
+    selectGBFF(ptReader, iFields, fFeatures == NULL ? asFeatures : NULL);
+    initCountries(&tCountries, sGazetteer == NULL ? NULL : &tGazetteer);
+    /* Unchanged records are passed over once their VERSION is read */
+    if(fState != NULL) filterGBFF(ptReader, isChanged, &tStates);
+    if(sFetch != NULL){
+      iError = mungeFetch(ptReader, sIndex, sFetch, &tFasta, &tTable, fFeatures, sNoMissingDates, sIncludeSequence, lRegion, &tCountries);
+    }
+    else
+#ifndef _WIN32
+    if(iThreads > 1){
+      iError = mungeParallel(ptReader, &tFasta, &tTable, fFeatures, fIndex, fState, sNoMissingDates, sIncludeSequence, iFields, fFeatures == NULL ? NULL : lRegion, fState == NULL ? NULL : &tStates, sGazetteer == NULL ? NULL : &tGazetteer, iThreads);
+    }
+    else
+#endif
+    while ((ptSeqData = readGBFF(ptReader)) != NULL) { /* ptSeqData points a parsed data of a GBF sequence data */
+      mungeRecord(ptSeqData, &tFasta, &tTable, sNoMissingDates, sIncludeSequence, &tCountries);
+      if(fFeatures != NULL) mungeFeatures(ptSeqData, fFeatures, lRegion, sIncludeSequence);
+      if(fIndex != NULL) mungeIndex(ptSeqData, fIndex, 0);
+      if(fState != NULL) mungeState(ptSeqData, fState);
+      freeGBRecord(ptSeqData); /* release memory space */
+    }
+    if(sFetch == NULL && (iError || errorGBFF(ptReader))){
+        fprintf(stderr,"Error: Stopped early, %s is damaged or truncated.\n",sFileName);
+        iError = 1;
+    }
+    /* The .gzi lists the blocks, so they must all have been written */
+    if(fFai != NULL && sCompress){
+      flushWriter(&tFasta);
+      strcpy(sFai + strlen(sFai) - 3,"gzi");
+      if(writeGzi(&tFasta, sFai) != 0){
+          fprintf(stderr,"Error: Cannot write FASTA index %s.\n",sFai);
+          iError = 1;
+      }
+      strcpy(sFai + strlen(sFai) - 3,"fai");
+    }
+    if(closeWriter(&tFasta) != 0){
+        fprintf(stderr,"Error: Cannot write FASTA file %s.\n",sFasta);
+        iError = 1;
+    }
+    if(fFai != NULL && fclose(fFai) != 0){
+        fprintf(stderr,"Error: Cannot write FASTA index %s.\n",sFai);
+        iError = 1;
+    }
+    free(sFai);
+    if(closeWriter(&tTable) != 0){
+        fprintf(stderr,"Error: Cannot write output file %s.\n",sTable);
+        iError = 1;
+    }
+    /* Records which made it to the outputs are remembered, even after an error */
+    if(fState != NULL){
+      rewind(fState);
+      readStates(&tStates, fState);
+      fclose(fState);
+      if(writeStates(&tStates, sState) != 0){
+          fprintf(stderr,"Error: Cannot write state file %s.\n",sState);
+          iError = 1;
+      }
+      freeStates(&tStates);
+    }
+    freeCountries(&tCountries);
+    if(sGazetteer != NULL) freeGazetteer(&tGazetteer);
+    closeGBFF(ptReader);
+    if(fFeatures != NULL) fclose(fFeatures);
+    if(fIndex != NULL) fclose(fIndex);
     fclose(fTable);
     fclose(fFasta);
-    return 0;
+    return iError;
 }
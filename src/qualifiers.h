@@ -0,0 +1,55 @@
+/* Generated by qualifiers.py from the GB_QUAL_* keys of gbfp.h, do not edit */
+
+#define QUALHASHLEN         256     /* Slots of the qualifier name hash */
+#define QUALBUCKETNUM       64      /* Displacements of the qualifier name hash */
+
+/* Names of the GB_QUAL_* keys, from 1 on */
+static const char *asQualifiers[GB_QUALNUM - 1] = {
+"allele", "altitude", "anticodon", "artificial_location", "bio_material", "bound_moiety",
+"cell_line", "cell_type", "chromosome", "circular_RNA", "citation", "clone",
+"clone_lib", "codon_start", "collected_by", "collection_date", "compare", "country",
+"cultivar", "culture_collection", "db_xref", "dev_stage", "direction", "EC_number",
+"ecotype", "environmental_sample", "estimated_length", "exception", "experiment", "focus",
+"frequency", "function", "gap_type", "gene", "gene_synonym", "geo_loc_name",
+"germline", "haplogroup", "haplotype", "host", "identified_by", "inference",
+"isolate", "isolation_source", "lab_host", "lat_lon", "linkage_evidence", "locus_tag",
+"macronuclear", "map", "mating_type", "metagenome_source", "mobile_element_type", "mod_base",
+"mol_type", "ncRNA_class", "note", "number", "old_locus_tag", "operon",
+"organelle", "organism", "partial", "PCR_conditions", "PCR_primers", "phenotype",
+"plasmid", "pop_variant", "product", "protein_id", "proviral", "pseudo",
+"pseudogene", "rearranged", "recombination_class", "regulatory_class", "replace", "ribosomal_slippage",
+"rpt_family", "rpt_type", "rpt_unit_range", "rpt_unit_seq", "satellite", "segment",
+"serotype", "serovar", "sex", "specimen_voucher", "standard_name", "strain",
+"sub_clone", "sub_species", "sub_strain", "submitter_seqid", "tag_peptide", "tissue_lib",
+"tissue_type", "trans_splicing", "transgenic", "translation", "transl_except", "transl_table",
+"type_material", "variety",
+};
+
+/* A perfect hash of the names above: the FNV-1a hash of a name picks a
+   displacement by its low bits, which moves the rest of the hash onto the
+   slot holding its key. Names of other slots, or of empty ones, are unknown */
+static const unsigned char acQualDisplace[QUALBUCKETNUM] = {
+      3,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   8,   4,   1,   0,   0,   0,   0,   0,
+      1,   0,   0,   0,   0,   6,   3,   0,   0,   1,   0,   0,   0,   0,   0,   1,
+      2,   0,   3,   2,   0,   0,   1,   0,   0,   1,   0,   2,   0,   1,   0,   0
+};
+
+static const unsigned char acQualSlot[QUALHASHLEN] = {
+     42,   0,   0,   0,   0,  65,   0,   0,  24,   0,   0,   0,   0,  57,   3,  85,
+      0,   0,   0,   0,   0,  18,  41,  45,  86,  87,   0,   0,  31,   0,  61,   0,
+      0,   0,   0,   0,   0,   0,  54,   0,  95,   0,   2,   0,   0,   0,   0,   0,
+      0,   0,   0,  35,   0,   0,   0,  20,  44,  72,  75,   0,   0,   7,   0,   0,
+      0,  69,  32,  52,  30,  84,   0,  73,  80,   0,   0,   0,   9,   0,  13,   0,
+      0,   0,   0,   0,   0,  29,   1,   0,  68,   0,  60,  12,  37,   0, 101,  36,
+      0,   0,   0,  11,   0,  38,   0,   0,   0,  66,   0,   0,   0,   0,   0,   0,
+     71,  58,   0,   0,   0,   0,   8,  63,  14,   0,  33,  92,   0,   0,   0,   0,
+     51,   0,   0,   0,  77,   0,   0,   0,   0,   0,   0,   0,  79,   0,   0,  21,
+      0,   0,  88,  81,  90,   0,  98,   0,   0,   0,  39,   0,   0,   0,   0,   0,
+      0,   0,  97,   0,   0,  55,  40,   0,  89,  56,   0,  62,  83,  26,  96,   0,
+      0,   0,   0,   0, 102,  64, 103,   0,   0,  28,   0,   0,   0,   0,   0,   0,
+     76,  15,  91,  43,   5,  34,   4,  23, 104,  49,  94,  53,   0,   0,  59,  10,
+     70,   0,  47,   0,   0,   0, 100,   0,   0,  22,  19,  99,   0,  25,  46,   0,
+      0,   0,   0,  17,   0,   0,   0,   0,   0,  82,  48,  93,   0,   6,   0,  50,
+     78,   0,   0,   0,   0,   0,  74,   0,   0,  27,  67,   0,  16,   0,   0,   0
+};
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Writes qualifiers.h, the names of the GB_QUAL_* keys of gbfp.h and the
+perfect hash qualifierKey() looks them up in. A qualifier is added or renamed
+here and in the enum of gbfp.h, in the same place; the two are checked
+against each other before anything is written.
+
+usage: python3 qualifiers.py > qualifiers.h   (or make qualifiers)"""
+
+import os
+import re
+import sys
+
+# INSDC feature table qualifiers, in the order of their GB_QUAL_* keys from 1 on
+NAMES = """
+allele altitude anticodon artificial_location bio_material bound_moiety
+cell_line cell_type chromosome circular_RNA citation clone
+clone_lib codon_start collected_by collection_date compare country
+cultivar culture_collection db_xref dev_stage direction EC_number
+ecotype environmental_sample estimated_length exception experiment focus
+frequency function gap_type gene gene_synonym geo_loc_name
+germline haplogroup haplotype host identified_by inference
+isolate isolation_source lab_host lat_lon linkage_evidence locus_tag
+macronuclear map mating_type metagenome_source mobile_element_type mod_base
+mol_type ncRNA_class note number old_locus_tag operon
+organelle organism partial PCR_conditions PCR_primers phenotype
+plasmid pop_variant product protein_id proviral pseudo
+pseudogene rearranged recombination_class regulatory_class replace ribosomal_slippage
+rpt_family rpt_type rpt_unit_range rpt_unit_seq satellite segment
+serotype serovar sex specimen_voucher standard_name strain
+sub_clone sub_species sub_strain submitter_seqid tag_peptide tissue_lib
+tissue_type trans_splicing transgenic translation transl_except transl_table
+type_material variety
+""".split()
+
+HASHLEN = 256       # Slots, a power of two; keys are stored in a byte
+BUCKETNUM = 64
+
+
+def fnv(sName):
+    iHash = 2166136261
+    for c in sName.encode():
+        iHash = ((iHash ^ c) * 16777619) & 0xffffffff
+    return iHash
+
+
+def main():
+    sHeader = open(os.path.join(os.path.dirname(os.path.abspath(__file__)), "gbfp.h"),
+                   encoding="utf-8").read()
+    sEnum = re.search(r"GB_QUAL_UNKNOWN,.*?\n(.*?)\s*GB_QUALNUM", sHeader, re.S).group(1)
+    asKeys = re.findall(r"GB_QUAL_(\w+)", sEnum)
+    if asKeys != [sName.upper() for sName in NAMES]:
+        for i, (sKey, sName) in enumerate(zip(asKeys + [""] * len(NAMES), NAMES + [""] * len(asKeys))):
+            if sKey != sName.upper():
+                sys.exit("Key %d is GB_QUAL_%s in gbfp.h but %s here" % (i + 1, sKey, sName or "missing"))
+    if len(NAMES) >= min(HASHLEN, 256):
+        sys.exit("Too many qualifiers for HASHLEN")
+
+    # Hash and displace: the low bits of a name's hash pick its bucket, whose
+    # displacement is added to the rest to land each name on a free slot
+    dBuckets = {}
+    for i, sName in enumerate(NAMES):
+        dBuckets.setdefault(fnv(sName) % BUCKETNUM, []).append(i)
+    aiSlots = [0] * HASHLEN
+    aiDisplace = [0] * BUCKETNUM
+    for iBucket in sorted(dBuckets, key=lambda b: -len(dBuckets[b])):
+        for iDisplace in range(256):
+            aiTry = [((fnv(NAMES[i]) >> 8) + iDisplace) % HASHLEN for i in dBuckets[iBucket]]
+            if len(set(aiTry)) == len(aiTry) and all(aiSlots[s] == 0 for s in aiTry):
+                for i, s in zip(dBuckets[iBucket], aiTry):
+                    aiSlots[s] = i + 1
+                aiDisplace[iBucket] = iDisplace
+                break
+        else:
+            sys.exit("No displacement for bucket %d, make HASHLEN larger" % iBucket)
+
+    def rows(aiValues, iWidth=16):
+        return ",\n".join("    " + ", ".join("%3d" % v for v in aiValues[i:i + iWidth])
+                          for i in range(0, len(aiValues), iWidth))
+
+    out = sys.stdout
+    out.write("/* Generated by qualifiers.py from the GB_QUAL_* keys of gbfp.h, do not edit */\n\n")
+    out.write("#define QUALHASHLEN         %d     /* Slots of the qualifier name hash */\n" % HASHLEN)
+    out.write("#define QUALBUCKETNUM       %d      /* Displacements of the qualifier name hash */\n\n" % BUCKETNUM)
+    out.write("/* Names of the GB_QUAL_* keys, from 1 on */\n")
+    out.write("static const char *asQualifiers[GB_QUALNUM - 1] = {\n")
+    for i in range(0, len(NAMES), 6):
+        out.write(" ".join('"%s",' % sName for sName in NAMES[i:i + 6]) + "\n")
+    out.write("};\n\n")
+    out.write("/* A perfect hash of the names above: the FNV-1a hash of a name picks a\n"
+              "   displacement by its low bits, which moves the rest of the hash onto the\n"
+              "   slot holding its key. Names of other slots, or of empty ones, are unknown */\n")
+    out.write("static const unsigned char acQualDisplace[QUALBUCKETNUM] = {\n%s\n};\n\n" % rows(aiDisplace))
+    out.write("static const unsigned char acQualSlot[QUALHASHLEN] = {\n%s\n};\n" % rows(aiSlots))
+
+
+if __name__ == "__main__":
+    main()